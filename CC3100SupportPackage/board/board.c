@@ -45,6 +45,7 @@
 #define XT1HFOFFG   0
 
 P_EVENT_HANDLER                pIraEventHandler = 0;
+P_EVENT_HANDLER                pRxNotifyHandler = 0;
 
 unsigned char IntIsMasked;
 
@@ -70,6 +71,13 @@ int registerInterruptHandler(P_EVENT_HANDLER InterruptHdl , void* pValue)
     return 0;
 }
 
+int registerRxNotifyHandler(P_EVENT_HANDLER NotifyHdl)
+{
+    pRxNotifyHandler = NotifyHdl;
+
+    return 0;
+}
+
 
 void CC3100_disable()
 {
@@ -346,6 +354,10 @@ void PORT2_IRQHandler(void)
         {
             pIraEventHandler(0);
         }
+        if (pRxNotifyHandler)
+        {
+            pRxNotifyHandler(0);
+        }
 #else
         if(puartFlowctrl->bRtsSetByFlowControl == FALSE)
         {
@@ -96,6 +96,20 @@ typedef enum
 */
 int registerInterruptHandler(P_EVENT_HANDLER InterruptHdl , void* pValue);
 
+/*!
+    \brief register a handler notified after each host IRQ
+
+    \param[in]      NotifyHdl       -    called from the interrupt once the
+                    SimpleLink driver has handled the IRQ
+
+    \return         0
+
+    \sa             registerInterruptHandler
+    \note           Used to wake the application's receive thread
+    \warning        Runs in interrupt context
+*/
+int registerRxNotifyHandler(P_EVENT_HANDLER NotifyHdl);
+
 /*!
     \brief          Enables the CC3100
 
@@ -1,3 +1,5 @@
+#include "G8RTOS.h"
+#include "G8RTOS_CriticalSection.h"
 #include "cc3100_usage.h"
 
 
@@ -5,172 +7,366 @@
 _u8 g_Status = 0;
 _i32 retVal = 0;
 static volatile uint32_t localIP;
-uint32_t receivedAlready = 0;
-uint32_t transmitedAlready = 0;
 _i16          SockIDRx = 0;
-_i16          SockIDTx = 0;
 /****** GLOBAL VARIABLES ******/
 
 
+/****** TX SOCKETS ******/
+/* Client side sockets, each sl_Connected to one peer, IP 0 marks a slot not opened yet */
+typedef struct
+{
+    _u32 IP;
+    _i16 sock;
+    volatile _u8 failed;            // Set by the socket event handler, the device refuses further sends on it
+} TxSocket_t;
+
+static TxSocket_t txSockets[TX_SOCKETS];
+static _u8 txEvict = 0;             // Slot reconnected next when every socket is taken
+static _u32 txDropped = 0;
+static _i16 statsSock = -1;         // Broadcast socket of SendStats, opened on first use
+/****** TX SOCKETS ******/
+
+
+/****** RX RING ******/
+/* Lent by the application, written at the head by the RX thread, read at the tail by ReceivePacket */
+static RxPacket_t *rxRing = 0;
+static _u8 rxRingSize = 0;
+static volatile _u8 rxHead = 0;
+static volatile _u8 rxTail = 0;
+static _u32 rxDropped = 0;
+static RxFilterStats_t rxFilterStats;
+
+static semaphore_t rxIrq_s;        // Signalled by the CC3100 IRQ
+static semaphore_t rxReady_s;      // Datagrams waiting in the ring
+static semaphore_t tx_s;           // Serializes use of the TX socket table
+/****** RX RING ******/
+
+
+/****** STATUS ******/
+static _SlSyncObj_t status_s;       // Signalled when an event handler changes g_Status
+static SocketEventHandler_t socketEventHandler = 0;
+/****** STATUS ******/
+
+
+/****** FAST BOOT ******/
+/* Contents of FAST_BOOT_FILE */
+typedef struct
+{
+    _u32 version;
+    _u32 role;
+    _u32 checksum;                  // Of the AP and IP settings built in, see ExpectedMarker
+} FastBootMarker_t;
+
+static ConnectTiming_t connectTiming;
+static uint32_t bootStart;          // SystemTime when initCC3100 was called
+static volatile _u8 booting = 0;    // Event handlers record connect and IP times while set
+/****** FAST BOOT ******/
+
+
 /****************************************** STATIC FUNCTIONS *********************************************/
 /*!
-    \brief Opening a UDP server side socket and receiving data
+    \brief Opening the UDP server side socket
 
-    This function opens a UDP socket in Listen mode and waits for incoming
-    UDP packets from the connected client.
+    This function opens a non-blocking UDP socket bound to the given port.
+    Datagrams are read from it by the RX thread only.
 
     \param[in]      port number on which the server will be listening on
 
-    \return         0 on success, Negative value on Error.
+    \return         0 on success, negative on error.
 
     \note
 
     \warning
  */
-static inline _i32 BsdUdpServer(_u16 Port, _u8 *data, _u16 BUF_SIZE)
+static _i32 BsdUdpServerOpen(_u16 Port)
 {
-    SlFdSet_t readfds;
-
-    SlSockAddrIn_t  Addr;
     SlSockAddrIn_t  LocalAddr;
-    _u16          AddrSize = 0;
-    //    _i16          SockID = 0;
+    SlSockNonblocking_t enableOption;
     _i16          Status = 0;
-    _u16          LoopCount = 0;
-    _u16          recvSize = 0;
-    _u8           *temp = data;
 
     LocalAddr.sin_family = SL_AF_INET;
     LocalAddr.sin_port = sl_Htons((_u16)Port);
     LocalAddr.sin_addr.s_addr = 0;
 
-    AddrSize = sizeof(SlSockAddrIn_t);
+    SockIDRx = sl_Socket(SL_AF_INET,SL_SOCK_DGRAM, 0);
+    ASSERT_ON_ERROR(SockIDRx);
 
-    // Per documentation , minimum - 10ms
-    struct SlTimeval_t timeVal;
-    timeVal.tv_sec =  0;                  // Seconds
-    timeVal.tv_usec = 50000;             // Microseconds. 50000 microseconds resolution
+    enableOption.NonblockingEnabled = 1;
+    sl_SetSockOpt(SockIDRx,SL_SOL_SOCKET,SL_SO_NONBLOCKING, (_u8 *)&enableOption,sizeof(enableOption)); // Enable/disable nonblocking mode
 
-    /* Open initial socket */
-    if(receivedAlready == 0)
+    Status = sl_Bind(SockIDRx, (SlSockAddr_t *)&LocalAddr, sizeof(SlSockAddrIn_t));
+    if( Status < 0 )
     {
-        receivedAlready = 1;
+        sl_Close(SockIDRx);
+        ASSERT_ON_ERROR(Status);
+    }
+
+    return SUCCESS;
+}
 
-        SockIDRx = sl_Socket(SL_AF_INET,SL_SOCK_DGRAM, 0);
+/*!
+    \brief Receiving every pending datagram into the RX ring
 
-        sl_SetSockOpt(SockIDRx,SL_SOL_SOCKET,SL_SO_RCVTIMEO, (_u8 *)&timeVal, sizeof(timeVal));    // Enable receive timeout
+    This function reads datagrams from the non-blocking server socket until
+    the device has none left. Each one is stored in the free slot at the head
+    of the ring and published to ReceivePacket.
 
-        SlSockNonblocking_t enableOption;
-        enableOption.NonblockingEnabled = 0;
-        sl_SetSockOpt(SockIDRx,SL_SOL_SOCKET,SL_SO_NONBLOCKING, (_u8 *)&enableOption,sizeof(enableOption)); // Enable/disable nonblocking mode
+    \param[in]      none
 
-        if( SockIDRx < 0 )
+    \return         Number of datagrams added to the ring.
+
+    \note
+
+    \warning        Datagrams that arrive while the ring is full are dropped,
+                    datagrams larger than RX_PACKET_SIZE are truncated.
+ */
+static inline _i32 BsdUdpServer()
+{
+    SlSockAddrIn_t  Addr;
+    SlSocklen_t     AddrSize = sizeof(SlSockAddrIn_t);
+    _i16            Status = 0;
+    _i32            received = 0;
+    _u8             next;
+
+    while(1)
+    {
+        // The head slot is never visible to the consumer, so it is always free to receive into
+        Status = sl_RecvFrom(SockIDRx, rxRing[rxHead].data, RX_PACKET_SIZE, 0,(SlSockAddr_t *)&Addr, &AddrSize);
+        if(Status <= 0)
         {
-            ASSERT_ON_ERROR(SockIDRx);
+            // SL_EAGAIN, nothing left on the device
+            break;
         }
 
-        Status = sl_Bind(SockIDRx, (SlSockAddr_t *)&LocalAddr, AddrSize);
-        if( Status < 0 )
+        // Anything from outside the subnet got past the device's RX filters
+        if((sl_Ntohl(Addr.sin_addr.s_addr) & AP_MASK) == (localIP & AP_MASK))
+            rxFilterStats.passed++;
+        else
+            rxFilterStats.escaped++;
+
+        next = (rxHead + 1) % rxRingSize;
+        if(next == rxTail)
         {
-            Status = sl_Close(SockIDRx);
-            ASSERT_ON_ERROR(Status);
+            rxDropped++;
+            continue;
         }
-    }
 
-    SL_FD_ZERO(&readfds);
-    SL_FD_SET(SockIDRx, &readfds);
+        rxRing[rxHead].length = Status;
+        rxRing[rxHead].from = sl_Ntohl(Addr.sin_addr.s_addr);
+        rxHead = next;
+        G8RTOS_SignalSemaphore(&rxReady_s);
+        received++;
+    }
 
-    Status = sl_Select( SockIDRx + 1, &readfds, NULL, NULL, &timeVal ) ;
+    return received;
+}
 
-    if (Status == NULL)
-        return NOTHING_RECEIVED;
+/*!
+    \brief Passing a socket event to the registered handler, if any
+ */
+static void NotifySocketEvent(SocketEvent_e event, _u32 IP, _i16 value)
+{
+    SocketEventHandler_t handler = socketEventHandler;
 
-    if ( SL_FD_ISSET( SockIDRx, &readfds ) )
+    if(handler)
     {
-        while (LoopCount < NO_OF_PACKETS)
-        {
-            recvSize = BUF_SIZE;
-            temp = data;
-            do
-            {
+        handler(event, IP, value);
+    }
+}
 
-                // Returns number of bytes received
-                Status = sl_RecvFrom(SockIDRx, temp, recvSize, 0,(SlSockAddr_t *)&Addr, (SlSocklen_t*)&AddrSize );
+/*!
+    \brief Finding the TX socket slot of a socket descriptor
 
-                //                if(Status < 0)
-                //                {
-                //                    sl_Close(SockIDRx);
-                //                    ASSERT_ON_ERROR(Status);
-                //                }
+    \param[in]      sd - socket descriptor from a SimpleLink event
 
-                recvSize -= Status;
-                temp += 1;
-            }while(recvSize > 0);
+    \return         The slot, or 0 if sd is not a TX socket.
+ */
+static TxSocket_t *FindTxSocket(_i16 sd)
+{
+    _u8 i;
 
-            LoopCount++;
-        }
+    for(i = 0; i < TX_SOCKETS; i++)
+    {
+        if(txSockets[i].IP != 0 && txSockets[i].sock == sd)
+            return &txSockets[i];
     }
+    return 0;
+}
 
-    //    Status = sl_Close(SockID);
-    //    ASSERT_ON_ERROR(Status);
+/*!
+    \brief CC3100 host IRQ notification
 
-    return SUCCESS;
+    Called from the port 2 interrupt after the SimpleLink driver's own handler.
+    Wakes the RX thread, at most one wake-up is kept pending.
+
+    \param[in]      pValue - unused
+ */
+static void RxNotify(void* pValue)
+{
+    if(rxIrq_s <= 0)
+    {
+        G8RTOS_SignalSemaphore(&rxIrq_s);
+    }
+}
+
+/*!
+    \brief RX thread
+
+    Sleeps until the CC3100 raises its IRQ, then drains the server socket
+    into the RX ring. The driver serializes its own commands, so reads can
+    interleave with SendData. A registered socket event handler is told how
+    many datagrams each wake-up added.
+ */
+static void RxThread()
+{
+    _i32 received;
+
+    while(1)
+    {
+        G8RTOS_WaitSemaphore(&rxIrq_s);
+        received = BsdUdpServer();
+        if(received > 0)
+        {
+            NotifySocketEvent(SOCKET_RX_READY, 0, received);
+        }
+    }
 }
 
 /*!
-    \brief Opening a UDP client side socket and sending data
+    \brief Sending a datagram on a connected UDP client socket
+
+    This function keeps one client side UDP socket per peer, opened on first
+    use and sl_Connected to the peer's IP waiting on port Port. Later datagrams
+    to the same peer go out with sl_Send, so the address is only built and
+    sent to the device once per peer. With more than TX_SOCKETS peers the
+    sockets are reconnected in turn, a socket the device reported a TX
+    failure on is closed and opened again.
 
-    This function opens a UDP socket and tries to send data to a UDP server
-    IP_ADDR waiting on port PORT_NUM.
-    Then the function will send 1000 UDP packets to the server.
+    The sockets are non-blocking: when the device has no free TX buffers the
+    datagram is dropped and counted instead of waiting for flow control.
 
     \param[in]      port number on which the server will be listening on
 
-    \return         0 on success, -1 on Error.
+    \return         0 on success, negative on error.
 
-    \note
+    \note           Caller must hold tx_s.
 
     \warning
  */
 static inline _i32 BsdUdpClient(_u16 Port, _u8 *data, _u32 IP, _u16 BUF_SIZE)
 {
     SlSockAddrIn_t  Addr;
-    _u16            AddrSize = 0;
+    SlSockNonblocking_t enableOption;
+    TxSocket_t      *tx = 0;
     _i16            Status = 0;
-    _u32            LoopCount = 0;
-
-    Addr.sin_family = SL_AF_INET;
-    Addr.sin_port = sl_Htons((_u16)Port);
-    Addr.sin_addr.s_addr = sl_Htonl(IP);
+    _u8             i;
 
-    AddrSize = sizeof(SlSockAddrIn_t);
+    for(i = 0; i < TX_SOCKETS && !tx; i++)
+    {
+        if(txSockets[i].IP == IP)
+            tx = &txSockets[i];
+    }
 
-    /* Open initial socket */
-    if(transmitedAlready == 0)
+    /* Set the default destination once per peer */
+    if(!tx || tx->failed)
     {
-        transmitedAlready = 1;
-        SockIDTx = sl_Socket(SL_AF_INET,SL_SOCK_DGRAM, 0);
-        if( SockIDTx < 0 )
+        for(i = 0; i < TX_SOCKETS && !tx; i++)
+        {
+            if(txSockets[i].IP == 0)
+                tx = &txSockets[i];
+        }
+        if(!tx)
+        {
+            tx = &txSockets[txEvict];
+            txEvict = (txEvict + 1) % TX_SOCKETS;
+        }
+
+        if(tx->failed)
+        {
+            sl_Close(tx->sock);
+            tx->IP = 0;
+        }
+        if(tx->IP == 0)
+        {
+            tx->failed = 0;
+            tx->sock = sl_Socket(SL_AF_INET,SL_SOCK_DGRAM, 0);
+            ASSERT_ON_ERROR(tx->sock);
+
+            enableOption.NonblockingEnabled = 1;
+            sl_SetSockOpt(tx->sock,SL_SOL_SOCKET,SL_SO_NONBLOCKING, (_u8 *)&enableOption,sizeof(enableOption));
+        }
+
+        Addr.sin_family = SL_AF_INET;
+        Addr.sin_port = sl_Htons((_u16)Port);
+        Addr.sin_addr.s_addr = sl_Htonl(IP);
+
+        Status = sl_Connect(tx->sock, (SlSockAddr_t *)&Addr, sizeof(SlSockAddrIn_t));
+        if(Status < 0)
         {
-            ASSERT_ON_ERROR(SockIDTx);
+            tx->IP = 0;
+            sl_Close(tx->sock);
+            ASSERT_ON_ERROR(Status);
         }
+        tx->IP = IP;
     }
 
-    while (LoopCount < NO_OF_PACKETS)
+    Status = sl_Send(tx->sock, data, BUF_SIZE, 0);
+    if( Status == SL_EAGAIN )
+    {
+        // No TX buffers on the device, the game sends fresh state next tick anyway
+        txDropped++;
+        return Status;
+    }
+    if( Status <= 0 )
     {
-        Status = sl_SendTo(SockIDTx, data, BUF_SIZE, 0, (SlSockAddr_t *)&Addr, AddrSize);
+        ASSERT_ON_ERROR(BSD_UDP_CLIENT_FAILED);
+    }
 
-        //        if( Status <= 0 )
-        //        {
-        //            Status = sl_Close(SockIDTx);
-        //            ASSERT_ON_ERROR(BSD_UDP_CLIENT_FAILED);
-        //        }
+    return SUCCESS;
+}
 
-        LoopCount++;
+
+/*!
+    \brief Waiting for WLAN status bits
+
+    Blocks until every bit of mask is set in g_Status, or until every bit is
+    clear when set is 0. The event handlers run on the SimpleLink spawn thread
+    and signal status_s after each change.
+
+    \param[in]      mask - STATUS_BIT_* bits, shifted
+    \param[in]      set - wait for the bits to be set (1) or clear (0)
+    \param[in]      timeout - ms, or SL_OS_WAIT_FOREVER
+
+    \return         1 once the bits are as requested, 0 on timeout.
+ */
+static _u8 WaitForStatus(_u8 mask, _u8 set, _u32 timeout)
+{
+    uint32_t start = SystemTime;
+    uint32_t waited;
+
+    while((g_Status & mask) != (set ? mask : 0))
+    {
+        if(timeout == SL_OS_WAIT_FOREVER)
+        {
+            sl_SyncObjWait(&status_s, SL_OS_WAIT_FOREVER);
+            continue;
+        }
+
+        waited = SystemTime - start;
+        if(waited >= timeout)
+            return 0;
+        sl_SyncObjWait(&status_s, timeout - waited);
     }
-    return SUCCESS;
+    return 1;
 }
 
+/*!
+    \brief Signals status_s after an event handler changed g_Status
+ */
+static void StatusChanged()
+{
+    sl_SyncObjSignal(&status_s);
+}
 
 /*!
     \brief This function configure the SimpleLink device in its default state. It:
@@ -182,7 +378,6 @@ static inline _i32 BsdUdpClient(_u16 Port, _u8 *data, _u32 IP, _u16 BUF_SIZE)
            - Sets Tx power to maximum
            - Sets power policy to normal
            - Unregisters mDNS services
-           - Remove all filters
 
     \param[in]      none
 
@@ -191,7 +386,6 @@ static inline _i32 BsdUdpClient(_u16 Port, _u8 *data, _u32 IP, _u16 BUF_SIZE)
 static _i32 configureSimpleLinkToDefaultState()
 {
     SlVersionFull   ver = {0};
-    _WlanRxFilterOperationCommandBuff_t  RxFilterIdMask = {0};
 
     _u8           val = 1;
     _u8           configOpt = 0;
@@ -210,7 +404,7 @@ static _i32 configureSimpleLinkToDefaultState()
         if (ROLE_AP == mode)
         {
             /* If the device is in AP mode, we need to wait for this event before doing anything */
-            while(!IS_IP_ACQUIRED(g_Status)) { _SlNonOsMainLoopTask(); }
+            WaitForStatus(1 << STATUS_BIT_IP_ACQUIRED, 1, SL_OS_WAIT_FOREVER);
         }
 
         /* Switch to STA role and restart */
@@ -255,7 +449,7 @@ static _i32 configureSimpleLinkToDefaultState()
     if(0 == retVal)
     {
         /* Wait */
-        while(IS_CONNECTED(g_Status)) { _SlNonOsMainLoopTask(); }
+        WaitForStatus(1 << STATUS_BIT_CONNECTION, 0, SL_OS_WAIT_FOREVER);
     }
 
     /* Enable DHCP client*/
@@ -287,12 +481,7 @@ static _i32 configureSimpleLinkToDefaultState()
     retVal = sl_NetAppMDNSUnRegisterService(0, 0);
     ASSERT_ON_ERROR(retVal);
 
-    /* Remove  all 64 filters (8*8) */
-    pal_Memset(RxFilterIdMask.FilterIdMask, 0xFF, 8);
-    retVal = sl_WlanRxFilterSet(SL_REMOVE_RX_FILTER, (_u8 *)&RxFilterIdMask,
-                                sizeof(_WlanRxFilterOperationCommandBuff_t));
-    ASSERT_ON_ERROR(retVal);
-
+    /* RX filters are replaced by InstallRxFilters once connected */
 
     //    retVal = sl_Stop(SL_STOP_TIMEOUT);
     //    ASSERT_ON_ERROR(retVal);
@@ -330,28 +519,335 @@ static _i32 establishConnectionWithAP()
     ASSERT_ON_ERROR(retVal);
 
     /* Wait */
-    while((!IS_CONNECTED(g_Status)) || (!IS_IP_ACQUIRED(g_Status))) { _SlNonOsMainLoopTask(); }
+    WaitForStatus((1 << STATUS_BIT_CONNECTION) | (1 << STATUS_BIT_IP_ACQUIRED), 1, SL_OS_WAIT_FOREVER);
 
     return SUCCESS;
 }
 
-/****************************************** STATIC FUNCTIONS *********************************************/
+/*!
+    \brief Adding one header rule to the RX filter tree
+
+    The rule compares field against low (or low..high for the IN_BETWEEN
+    functions), given in host order and sent big endian as on the air. It
+    applies to station frames once the device has an IP, and only to frames
+    that matched parent.
+
+    \param[in]      parent - filter the rule hangs below, 0 for the root
+    \param[in]      field - header field, IP_PROTOCOL_FIELD...
+    \param[in]      compare - COMPARE_FUNC_*
+    \param[in]      low, high - arguments, high only used by the IN_BETWEEN functions
+    \param[in]      length - bytes of the field, 1, 2 or 4
+    \param[in]      action - RX_FILTER_ACTION_DROP on leaves, RX_FILTER_ACTION_NULL on inner nodes
+    \param[out]     pFilterId - id of the new filter
+
+    \return         0 on success, negative on error.
+ */
+static _i32 AddRxFilter(SlrxFilterID_t parent, SlrxFilterHdrField_t field, SlrxFilterCompareFunction_t compare,
+                        _u32 low, _u32 high, _u8 length, _u8 action, SlrxFilterID_t *pFilterId)
+{
+    SlrxFilterRule_t rule;
+    SlrxFilterTrigger_t trigger;
+    SlrxFilterAction_t filterAction;
+    SlrxFilterFlags_t flags;
+    _u32 args[SL_RX_FILTER_NUM_OF_FILTER_HEADER_ARGS];
+    _u8 arg, i;
+    _i32 retVal;
+
+    pal_Memset(&rule, 0, sizeof(rule));
+    pal_Memset(&trigger, 0, sizeof(trigger));
+    pal_Memset(&filterAction, 0, sizeof(filterAction));
+
+    args[0] = low;
+    args[1] = high;
+    for(arg = 0; arg < SL_RX_FILTER_NUM_OF_FILTER_HEADER_ARGS; arg++)
+    {
+        if(length == 1)
+        {
+            rule.HeaderType.RuleHeaderArgsAndMask.RuleHeaderArgs.RxFilterDB1BytesRuleArgs[arg][0] = (_u8)args[arg];
+            continue;
+        }
+        for(i = 0; i < length; i++)
+        {
+            rule.HeaderType.RuleHeaderArgsAndMask.RuleHeaderArgs.RxFilterDB4BytesRuleArgs[arg][i] =
+                    (_u8)(args[arg] >> (8 * (length - 1 - i)));
+        }
+    }
+    pal_Memset(rule.HeaderType.RuleHeaderArgsAndMask.RuleHeaderArgsMask, 0xFF, length);
+    rule.HeaderType.RuleHeaderfield = field;
+    rule.HeaderType.RuleCompareFunc = compare;
 
+    trigger.ParentFilterID = parent;
+    trigger.Trigger = NO_TRIGGER;
+    trigger.TriggerArgConnectionState.IntRepresentation = RX_FILTER_CONNECTION_STATE_STA_HAS_IP;
+    trigger.TriggerArgRoleStatus.IntRepresentation = RX_FILTER_ROLE_STA;
 
-/****************************************** PUBLIC FUNCTIONS *********************************************/
+    filterAction.ActionType.IntRepresentation = action;
+    flags.IntRepresentation = RX_FILTER_BINARY;
 
-/*
- * This function initializes the CC3100
- * Enters CC3100 into default state
- * Configured as a station with its own static IP defined in cc3100_usage.h
- * Connects to an access point - params defined in sl_common.h
- *
- * Takes in BUF SIZE for packet - size of player struct
+    retVal = sl_WlanRxFilterAdd(HEADER, flags, &rule, &trigger, &filterAction, pFilterId);
+    ASSERT_ON_ERROR(retVal);
+
+    rxFilterStats.installed++;
+    return SUCCESS;
+}
+
+/*!
+    \brief Dropping non game traffic inside the CC3100
+
+    Replaces any filters on the device with this tree, children only see
+    frames their parent matched and a frame no leaf drops reaches the host:
+
+        IPv4 -+- protocol != UDP                               drop
+              +- UDP -+- port != PORT_NUM -- port != DHCP_CLIENT_PORT  drop
+                      +- port == PORT_NUM -- source outside subnet     drop
+
+    Non IP frames (ARP) pass. The filters live in RAM and are installed at
+    every boot. Called once the IP is known, the subnet is taken from it.
+
+    \return         0 on success, negative on error.
  */
-void initCC3100(playerType playerRole)
+static _i32 InstallRxFilters()
+{
+    _WlanRxFilterOperationCommandBuff_t idMask = {0};
+    _WlanRxFilterRetrieveEnableStatusCommandResponseBuff_t enabled = {0};
+    SlrxFilterID_t ids[RX_FILTERS] = {0};
+    _u32 subnet = localIP & AP_MASK;
+    _i32 retVal;
+    _u8 i;
+
+    /* Remove  all 64 filters (8*8) */
+    pal_Memset(idMask.FilterIdMask, 0xFF, 8);
+    retVal = sl_WlanRxFilterSet(SL_REMOVE_RX_FILTER, (_u8 *)&idMask, sizeof(idMask));
+    ASSERT_ON_ERROR(retVal);
+    pal_Memset(&rxFilterStats, 0, sizeof(rxFilterStats));
+
+    retVal = AddRxFilter(0, IP_VERSION_FIELD, COMPARE_FUNC_EQUAL, 4, 0, 1, RX_FILTER_ACTION_NULL, &ids[0]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[0], IP_PROTOCOL_FIELD, COMPARE_FUNC_NOT_EQUAL_TO, SL_IPPROTO_UDP, 0, 1, RX_FILTER_ACTION_DROP, &ids[1]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[0], IP_PROTOCOL_FIELD, COMPARE_FUNC_EQUAL, SL_IPPROTO_UDP, 0, 1, RX_FILTER_ACTION_NULL, &ids[2]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[2], DST_PORT_FIELD, COMPARE_FUNC_NOT_EQUAL_TO, PORT_NUM, 0, 2, RX_FILTER_ACTION_NULL, &ids[3]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[3], DST_PORT_FIELD, COMPARE_FUNC_NOT_EQUAL_TO, DHCP_CLIENT_PORT, 0, 2, RX_FILTER_ACTION_DROP, &ids[4]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[2], DST_PORT_FIELD, COMPARE_FUNC_EQUAL, PORT_NUM, 0, 2, RX_FILTER_ACTION_NULL, &ids[5]);
+    ASSERT_ON_ERROR(retVal);
+    retVal = AddRxFilter(ids[5], IPV4_SRC_ADRRESS_FIELD, COMPARE_FUNC_NOT_IN_BETWEEN, subnet, subnet | ~AP_MASK, 4,
+                         RX_FILTER_ACTION_DROP, &ids[6]);
+    ASSERT_ON_ERROR(retVal);
+
+    /* Enable the tree and read back what the device took */
+    pal_Memset(&idMask, 0, sizeof(idMask));
+    for(i = 0; i < RX_FILTERS; i++)
+    {
+        SETBIT8(idMask.FilterIdMask, ids[i]);
+    }
+    retVal = sl_WlanRxFilterSet(SL_ENABLE_DISABLE_RX_FILTER, (_u8 *)&idMask, sizeof(idMask));
+    ASSERT_ON_ERROR(retVal);
+
+    retVal = sl_WlanRxFilterGet(SL_FILTER_RETRIEVE_ENABLE_STATE, (_u8 *)&enabled, sizeof(enabled));
+    ASSERT_ON_ERROR(retVal);
+    for(i = 0; i < RX_FILTERS; i++)
+    {
+        if(ISBITSET8(enabled.FilterIdMask, ids[i]))
+            rxFilterStats.enabled++;
+    }
+
+    return SUCCESS;
+}
+
+/*!
+    \brief ms since initCC3100 was called
+ */
+static _u32 Elapsed()
+{
+    return SystemTime - bootStart;
+}
+
+/*!
+    \brief FNV-1a over length bytes, continuing from hash
+ */
+static _u32 Fnv(_u32 hash, const void *data, _u32 length)
+{
+    const _u8 *bytes = (const _u8 *)data;
+
+    while(length--)
+    {
+        hash = (hash ^ *bytes++) * 16777619u;
+    }
+    return hash;
+}
+
+/*!
+    \brief Filling in the marker for the settings built into this image
+
+    The checksum covers the AP (SSID_NAME, PASSKEY, SEC_TYPE) and the static
+    IP settings, so changing any of them forces a full configuration.
+
+    \param[in]      playerRole - Host uses the static IP, Client DHCP
+    \param[out]     marker - expected contents of FAST_BOOT_FILE
+ */
+static void ExpectedMarker(playerType playerRole, FastBootMarker_t *marker)
+{
+    const _u32 settings[] = {SEC_TYPE, CONFIG_IP, AP_MASK, AP_GATEWAY, AP_DNS};
+    _u32 hash = 2166136261u;
+
+    hash = Fnv(hash, SSID_NAME, pal_Strlen(SSID_NAME) + 1);
+    hash = Fnv(hash, PASSKEY, pal_Strlen(PASSKEY) + 1);
+    hash = Fnv(hash, settings, sizeof(settings));
+
+    pal_Memset(marker, 0, sizeof(*marker));
+    marker->version = FAST_BOOT_VERSION;
+    marker->role = playerRole;
+    marker->checksum = hash;
+}
+
+/*!
+    \brief Reading FAST_BOOT_FILE from the device's serial flash
+
+    \param[out]     marker - file contents
+
+    \return         0 on success, negative if the file is missing or short.
+ */
+static _i32 ReadFastBootMarker(FastBootMarker_t *marker)
+{
+    _i32 handle = -1;
+    _u32 token = 0;
+    _i32 retVal;
+
+    retVal = sl_FsOpen((_u8 *)FAST_BOOT_FILE, FS_MODE_OPEN_READ, &token, &handle);
+    ASSERT_ON_ERROR(retVal);
+
+    retVal = sl_FsRead(handle, 0, (_u8 *)marker, sizeof(*marker));
+    sl_FsClose(handle, 0, 0, 0);
+
+    return (retVal == sizeof(*marker)) ? SUCCESS : FAST_BOOT_NOT_CONFIGURED;
+}
+
+/*!
+    \brief Replacing FAST_BOOT_FILE on the device's serial flash
+
+    The file is created fail safe (mirrored), a write cut short by a reset
+    leaves no marker rather than a damaged one.
+
+    \param[in]      marker - contents to write
+
+    \return         0 on success, negative on error.
+ */
+static _i32 WriteFastBootMarker(const FastBootMarker_t *marker)
+{
+    _i32 handle = -1;
+    _u32 token = 0;
+    _i32 retVal;
+
+    sl_FsDel((_u8 *)FAST_BOOT_FILE, 0);
+    retVal = sl_FsOpen((_u8 *)FAST_BOOT_FILE,
+                       FS_MODE_OPEN_CREATE(sizeof(*marker), _FS_FILE_OPEN_FLAG_COMMIT),
+                       &token, &handle);
+    ASSERT_ON_ERROR(retVal);
+
+    retVal = sl_FsWrite(handle, 0, (_u8 *)marker, sizeof(*marker));
+    sl_FsClose(handle, 0, 0, 0);
+
+    if(retVal != sizeof(*marker))
+    {
+        sl_FsDel((_u8 *)FAST_BOOT_FILE, 0);
+        return (retVal < 0) ? retVal : FAST_BOOT_NOT_CONFIGURED;
+    }
+    return SUCCESS;
+}
+
+/*!
+    \brief Storing the AP as a profile the device connects to by itself
+
+    With the auto policy the device connects to its stored profiles whenever
+    it starts, with fast connect it goes straight back to the last AP without
+    scanning first.
+
+    \return         0 on success, negative on error.
+ */
+static _i32 StoreProfile()
+{
+    SlSecParams_t secParams = {0};
+    _i32 retVal = 0;
+
+    secParams.Key = PASSKEY;
+    secParams.KeyLen = pal_Strlen(PASSKEY);
+    secParams.Type = SEC_TYPE;
+
+    retVal = sl_WlanProfileAdd(SSID_NAME, pal_Strlen(SSID_NAME), 0, &secParams, 0, 0, 0);
+    ASSERT_ON_ERROR(retVal);
+
+    retVal = sl_WlanPolicySet(SL_POLICY_CONNECTION, SL_CONNECTION_POLICY(1, 1, 0, 0, 0), NULL, 0);
+    ASSERT_ON_ERROR(retVal);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief Starting from the configuration kept on the device
+
+    Starts the device and compares FAST_BOOT_FILE with what this image would
+    configure. On a match the stored profile connects by itself and only the
+    IP has to be waited for. A profile that does not get an IP within
+    FAST_BOOT_TIMEOUT (AP gone or changed) removes the marker.
+
+    \param[in]      playerRole - Host or Client
+
+    \return         0 once the IP is acquired. Negative if the device has to be
+                    configured, it is stopped then.
+ */
+static _i32 FastBoot(playerType playerRole)
 {
+    FastBootMarker_t stored;
+    FastBootMarker_t expected;
     _i32 retVal = -1;
+
+    retVal = sl_Start(0, 0, 0);
+    if(retVal < 0)
+        return retVal;
+    connectTiming.started = Elapsed();
+
+    ExpectedMarker(playerRole, &expected);
+    if((ROLE_STA != retVal) ||
+            (ReadFastBootMarker(&stored) < 0) ||
+            (pal_Memcmp(&stored, &expected, sizeof(expected)) != 0))
+    {
+        retVal = FAST_BOOT_NOT_CONFIGURED;
+    }
+    else
+    {
+        connectTiming.configured = connectTiming.started;
+        if(WaitForStatus((1 << STATUS_BIT_CONNECTION) | (1 << STATUS_BIT_IP_ACQUIRED), 1, FAST_BOOT_TIMEOUT))
+        {
+            connectTiming.fastBoot = 1;
+            return SUCCESS;
+        }
+
+        sl_FsDel((_u8 *)FAST_BOOT_FILE, 0);
+        retVal = FAST_BOOT_TIMED_OUT;
+    }
+
+    sl_Stop(SL_STOP_TIMEOUT);
     g_Status = 0;
+    return retVal;
+}
+
+/*!
+    \brief Configuring the device from its default state and connecting
+
+    The full sequence: default state, IP mode for the role, connection to the
+    AP. Then stores the AP as a profile and writes FAST_BOOT_FILE, so the next
+    boot can take FastBoot.
+
+    \param[in]      playerRole - Host uses the static IP, Client DHCP
+ */
+static void FullBoot(playerType playerRole)
+{
+    FastBootMarker_t marker;
+    _i32 retVal = -1;
+
     retVal = configureSimpleLinkToDefaultState();
     if(retVal < 0)
     {
@@ -420,6 +916,7 @@ void initCC3100(playerType playerRole)
 
     /* Connecting to WLAN AP - Set with static parameters defined at the top
        After this call we will be connected and have IP address */
+    connectTiming.configured = Elapsed();
     retVal = establishConnectionWithAP();
     if(retVal < 0)
     {
@@ -427,7 +924,66 @@ void initCC3100(playerType playerRole)
         LOOP_FOREVER();
     }
 
+    /* Next boot can skip all of the above, a failure here only costs that */
+    if(StoreProfile() >= 0)
+    {
+        ExpectedMarker(playerRole, &marker);
+        WriteFastBootMarker(&marker);
+    }
+}
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
+
+/*
+ * This function initializes the CC3100
+ * Reuses the configuration kept on the CC3100 if FAST_BOOT_FILE matches, else enters it into default state
+ * Configured as a station with its own static IP defined in cc3100_usage.h
+ * Connects to an access point - params defined in sl_common.h
+ * Time spent in each phase is kept for getConnectTiming
+ *
+ * Takes in BUF SIZE for packet - size of player struct
+ */
+void initCC3100(playerType playerRole)
+{
+    _i32 retVal = -1;
+    g_Status = 0;
+
+    bootStart = SystemTime;
+    pal_Memset(&connectTiming, 0, sizeof(connectTiming));
+    booting = 1;
+
+    /* SimpleLink runs its async events on the spawn thread, waiting callers block on G8RTOS semaphores */
+    osi_Init();
+    sl_SyncObjCreate(&status_s, "status");
+
+    /* Use what the device kept if this image would configure the same, otherwise configure it */
+    if(FastBoot(playerRole) < 0)
+    {
+        FullBoot(playerRole);
+    }
+    booting = 0;
+
     /* Connection established w/ AP and IP is acquired */
+
+    /* Not fatal, without filters stray traffic only costs wake-ups */
+    InstallRxFilters();
+
+    /* Receive path: the CC3100 IRQ wakes the RX thread, which fills the RX ring */
+    G8RTOS_InitSemaphore(&tx_s, 1);
+    G8RTOS_InitSemaphore(&rxReady_s, 0);
+    G8RTOS_InitSemaphore(&rxIrq_s, 1);          // Drain anything that arrived before the thread started
+    if(!rxRing)
+        LOOP_FOREVER();                         // lendRxRing was not called
+
+    retVal = BsdUdpServerOpen(PORT_NUM);
+    if(retVal < 0)
+        LOOP_FOREVER();
+
+    registerRxNotifyHandler(RxNotify);
+    G8RTOS_AddThread(RxThread, RX_THREAD_PRIORITY, "cc3100 rx");
 }
 
 
@@ -437,7 +993,9 @@ void initCC3100(playerType playerRole)
 void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE)
 {
     /* Sending data to UDP server */
+    G8RTOS_WaitSemaphore(&tx_s);
     retVal = BsdUdpClient(PORT_NUM, data, IP, BUF_SIZE);
+    G8RTOS_SignalSemaphore(&tx_s);
 
     //    if(retVal < 0)
     //        /* Failed to send data to UDP server */
@@ -446,19 +1004,196 @@ void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE)
 }
 
 /*
- * Function reads an array of bytes, defined by the BUF_SIZE in cc3100_usage.h
+ * Lends the RX ring to the driver, count slots of which count - 1 can hold datagrams
+ * Must be called before initCC3100, the slots stay in use for as long as the CC3100 runs
+ */
+void lendRxRing(RxPacket_t *slots, _u8 count)
+{
+    rxRing = slots;
+    rxRingSize = count;
+    rxHead = 0;
+    rxTail = 0;
+}
+
+/*
+ * Blocks until a datagram is in the RX ring and returns its slot, without copying it
+ * The slot belongs to the caller until ReleasePacket, only one packet can be out at a time
+ */
+RxPacket_t *ReceivePacket()
+{
+    G8RTOS_WaitSemaphore(&rxReady_s);
+    return &rxRing[rxTail];
+}
+
+/*
+ * Same as ReceivePacket, returns 0 if the ring is empty
+ */
+RxPacket_t *ReceivePacketNonBlocking()
+{
+    int32_t primask;
+    _u8 available;
+
+    primask = StartCriticalSection();
+    available = rxReady_s > 0;
+    if(available)
+    {
+        rxReady_s--;
+    }
+    EndCriticalSection(primask);
+
+    return available ? &rxRing[rxTail] : 0;
+}
+
+/*
+ * Gives the slot returned by ReceivePacket back to the RX thread
+ */
+void ReleasePacket(RxPacket_t *packet)
+{
+    // The slot belongs to the RX thread again as soon as the tail moves past it
+    rxTail = (rxTail + 1) % rxRingSize;
+}
+
+/*
+ * Copies at most BUF_SIZE bytes of a borrowed datagram and releases its slot
+ */
+static _i32 CopyPacket(RxPacket_t *packet, _u8 *data, _u16 BUF_SIZE, _u32 *IP)
+{
+    _i16 length = packet->length;
+
+    if(IP)
+        *IP = packet->from;
+    memcpy(data, packet->data, length < BUF_SIZE ? length : BUF_SIZE);
+    ReleasePacket(packet);
+
+    return length;
+}
+
+/*
+ * Function blocks until a datagram is in the RX ring, then copies at most BUF_SIZE bytes of it
+ * Returns the size of the datagram
  */
 _i32 ReceiveData(_u8 *data, _u16 BUF_SIZE)
 {
-    /* Receiving data from UDP server */
-    retVal = BsdUdpServer(PORT_NUM, data, BUF_SIZE);
-    //    if(retVal < 0)
-    //        /* Failed to read data from the UDP client */
-    //    else
-    //        /* Successfully received data from UDP client */
-    return retVal;
+    return ReceiveDatagram(data, BUF_SIZE, 0);
+}
+
+/*
+ * Same as ReceiveData, also stores the sender's IP in *IP when IP is not NULL
+ */
+_i32 ReceiveDatagram(_u8 *data, _u16 BUF_SIZE, _u32 *IP)
+{
+    return CopyPacket(ReceivePacket(), data, BUF_SIZE, IP);
+}
+
+/*
+ * Function copies at most BUF_SIZE bytes of the next datagram in the RX ring
+ * Returns the size of the datagram, or NOTHING_RECEIVED if the ring is empty
+ */
+_i32 ReceiveDataNonBlocking(_u8 *data, _u16 BUF_SIZE)
+{
+    return ReceiveDatagramNonBlocking(data, BUF_SIZE, 0);
 }
 
+/*
+ * Same as ReceiveDataNonBlocking, also stores the sender's IP in *IP when IP is not NULL
+ */
+_i32 ReceiveDatagramNonBlocking(_u8 *data, _u16 BUF_SIZE, _u32 *IP)
+{
+    RxPacket_t *packet = ReceivePacketNonBlocking();
+
+    if(!packet)
+        return NOTHING_RECEIVED;
+
+    return CopyPacket(packet, data, BUF_SIZE, IP);
+}
+
+/*
+ * Returns the number of datagrams dropped because the RX ring was full
+ */
+_u32 getRxDropped()
+{
+    return rxDropped;
+}
+
+/*
+ * Returns the number of datagrams SendData dropped because the CC3100 had no free TX buffers
+ */
+_u32 getTxDropped()
+{
+    return txDropped;
+}
+
+/*
+ * Registers handler for socket readiness and error notifications, 0 removes it
+ * SOCKET_RX_READY comes from the RX thread, the others from the SimpleLink spawn thread,
+ * so the handler must not block or call into the driver; signalling a semaphore is fine
+ */
+void registerSocketEventHandler(SocketEventHandler_t handler)
+{
+    socketEventHandler = handler;
+}
+
+/*
+ * Copies the RX filter state and what got past the filters, see RxFilterStats_t
+ */
+void getRxFilterStats(RxFilterStats_t *stats)
+{
+    *stats = rxFilterStats;
+}
+
+/*
+ * Copies the time to IP of the last initCC3100, see ConnectTiming_t
+ */
+void getConnectTiming(ConnectTiming_t *timing)
+{
+    *timing = connectTiming;
+}
+
+
+/*
+ * Starts the CC3100's receive statistics: frame counts, average RSSI and rate histograms of what it hears
+ */
+_i32 startWlanRxStats()
+{
+    return sl_WlanRxStatStart();
+}
+
+/*
+ * Copies the receive statistics gathered since the last call, the device clears them on read
+ */
+_i32 getWlanRxStats(SlGetRxStatResponse_t *stats)
+{
+    return sl_WlanRxStatGet(stats, 0);
+}
+
+/*
+ * Broadcasts a datagram to STATS_PORT on the local subnet, for a PC listening there
+ * Goes out on its own non-blocking socket, dropped if the CC3100 has no free TX buffer
+ */
+void SendStats(_u8 *data, _u16 BUF_SIZE)
+{
+    SlSockAddrIn_t  Addr;
+    SlSockNonblocking_t enableOption;
+
+    G8RTOS_WaitSemaphore(&tx_s);
+    if(statsSock < 0)
+    {
+        statsSock = sl_Socket(SL_AF_INET,SL_SOCK_DGRAM, 0);
+        if(statsSock >= 0)
+        {
+            enableOption.NonblockingEnabled = 1;
+            sl_SetSockOpt(statsSock,SL_SOL_SOCKET,SL_SO_NONBLOCKING, (_u8 *)&enableOption,sizeof(enableOption));
+        }
+    }
+    if(statsSock >= 0)
+    {
+        Addr.sin_family = SL_AF_INET;
+        Addr.sin_port = sl_Htons((_u16)STATS_PORT);
+        Addr.sin_addr.s_addr = sl_Htonl(localIP | ~AP_MASK);
+        sl_SendTo(statsSock, data, BUF_SIZE, 0, (SlSockAddr_t *)&Addr, sizeof(SlSockAddrIn_t));
+    }
+    G8RTOS_SignalSemaphore(&tx_s);
+}
 
 _u32 getLocalIP()
 {
@@ -496,6 +1231,9 @@ void SimpleLinkWlanEventHandler(SlWlanEvent_t *pWlanEvent)
     case SL_WLAN_CONNECT_EVENT:
     {
         SET_STATUS_BIT(g_Status, STATUS_BIT_CONNECTION);
+        if(booting)
+            connectTiming.connected = Elapsed();
+        StatusChanged();
 
         /*
          * Information about the connected AP (like name, MAC etc) will be
@@ -515,6 +1253,7 @@ void SimpleLinkWlanEventHandler(SlWlanEvent_t *pWlanEvent)
 
         CLR_STATUS_BIT(g_Status, STATUS_BIT_CONNECTION);
         CLR_STATUS_BIT(g_Status, STATUS_BIT_IP_ACQUIRED);
+        StatusChanged();
 
         pEventData = &pWlanEvent->EventData.STAandP2PModeDisconnected;
 
@@ -569,6 +1308,9 @@ void SimpleLinkNetAppEventHandler(SlNetAppEvent_t *pNetAppEvent)
         SlIpV4AcquiredAsync_t *pEventData = NULL;
         pEventData = &pNetAppEvent->EventData.ipAcquiredV4;
         localIP =  pEventData->ip;
+        if(booting)
+            connectTiming.ipAcquired = Elapsed();
+        StatusChanged();
 
         /*
          * Information about the connection (like IP, gateway address etc)
@@ -641,34 +1383,36 @@ void SimpleLinkSockEventHandler(SlSockEvent_t *pSock)
         return;
     }
 
-    //    switch( pSock->Event )
-    //    {
-    //        case SL_SOCKET_TX_FAILED_EVENT:
-    //            /*
-    //             * TX Failed
-    //             *
-    //             * Information about the socket descriptor and status will be
-    //             * available in 'SlSockEventData_t' - Applications can use it if
-    //             * required
-    //             *
-    //             * SlSockEventData_u *pEventData = NULL;
-    //             * pEventData = & pSock->socketAsyncEvent;
-    //             */
-    //            switch( pSock->socketAsyncEvent.SockTxFailData.status )
-    //            {
-    //                case SL_ECLOSE:
-    //                    CLI_Write(" [SOCK EVENT] Close socket operation failed to transmit all queued packets\n\r");
-    //                    break;
-    //                default:
-    //                    CLI_Write(" [SOCK EVENT] Unexpected event \n\r");
-    //                    break;
-    //            }
-    //            break;
-    //
-    //        default:
-    //            CLI_Write(" [SOCK EVENT] Unexpected event \n\r");
-    //            break;
-    //    }
+    switch(pSock->Event)
+    {
+    case SL_SOCKET_TX_FAILED_EVENT:
+    {
+        /* The device drops every later send on this socket, BsdUdpClient opens it again */
+        TxSocket_t *tx = FindTxSocket(pSock->EventData.sd);
+
+        if(tx)
+        {
+            tx->failed = 1;
+        }
+        NotifySocketEvent(SOCKET_TX_FAILED, tx ? tx->IP : 0, pSock->EventData.status);
+    }
+    break;
+
+    case SL_SOCKET_ASYNC_EVENT:
+    {
+        /* RX_FRAGMENTATION_TOO_BIG: a datagram over 16K was released by the device */
+        TxSocket_t *tx = FindTxSocket(pSock->EventData.socketAsyncEvent.sd);
+
+        NotifySocketEvent(SOCKET_ERROR, tx ? tx->IP : 0, pSock->EventData.socketAsyncEvent.type);
+    }
+    break;
+
+    default:
+    {
+        /* [SOCK EVENT] Unexpected event */
+    }
+    break;
+    }
 }
 /************************************ ASYNCHRONOUS EVENT HANDLERS ****************************************/
 
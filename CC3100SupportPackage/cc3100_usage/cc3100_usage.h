@@ -36,6 +36,7 @@ typedef enum
  */
 #define HOST_IP_ADDR           0xC0A80109               // IP address of server to connect to
 #define PORT_NUM               5001                     // Port number to be used
+#define STATS_PORT             5002                     // Port SendStats broadcasts to on the local subnet
 #define NO_OF_PACKETS          1                        // Number of packets to send out
 
 /*
@@ -51,18 +52,110 @@ typedef enum
 typedef enum{
     DEVICE_NOT_IN_STATION_MODE = -0x7D0,        /* Choosing this number to avoid overlap w/ host-driver's error codes */
     BSD_UDP_CLIENT_FAILED = DEVICE_NOT_IN_STATION_MODE - 1,
+    FAST_BOOT_NOT_CONFIGURED = BSD_UDP_CLIENT_FAILED - 1,
+    FAST_BOOT_TIMED_OUT = FAST_BOOT_NOT_CONFIGURED - 1,
 
     STATUS_CODE_MAX = -0xBB8
 }e_AppStatusCodes;
 
 #define NOTHING_RECEIVED -1
+
+/*
+ * Fast boot: after a full configuration the CC3100 keeps the AP as a profile with the
+ * auto + fast connect policy, and a marker file on its serial flash records what was applied.
+ * While the marker matches the settings built in, initCC3100 only starts the device and
+ * waits for the stored profile to connect. Change FAST_BOOT_VERSION to force a full configuration.
+ */
+#define FAST_BOOT_FILE         "game_netcfg"            // Marker file on the CC3100's serial flash
+#define FAST_BOOT_VERSION      1
+#define FAST_BOOT_TIMEOUT      5000                     // ms to get an IP from the stored profile before reconfiguring
+
+/*
+ * Time to IP of initCC3100, each phase in ms since it was called
+ */
+typedef struct
+{
+    _u32 started;                   // First sl_Start returned
+    _u32 configured;                // Device configured, equal to started on a fast boot
+    _u32 connected;                 // Associated with the AP
+    _u32 ipAcquired;
+    _u8 fastBoot;                   // 1 if the stored configuration was used
+} ConnectTiming_t;
+
+/*
+ * Receive ring: lent by the application, datagrams are read into it by the RX thread when the CC3100 raises its IRQ
+ * One slot is always kept free, so RX_RING_SIZE - 1 datagrams can wait
+ */
+#define RX_RING_SIZE           5                        // Slots to lend to the RX ring
+#define RX_PACKET_SIZE         128                      // Largest datagram kept, longer ones are truncated
+#define RX_THREAD_PRIORITY     0                        // Priority of the RX thread
+
+/*
+ * Connected sending sockets, one per peer, together with the RX and stats sockets within SL_MAX_SOCKETS
+ */
+#define TX_SOCKETS             3
+
+/*
+ * One slot of the RX ring, sl_RecvFrom writes straight into it
+ */
+typedef struct
+{
+    _u8 data[RX_PACKET_SIZE];
+    _i16 length;
+    _u32 from;                      // Sender's IP
+} RxPacket_t;
+
+/*
+ * Socket readiness and error notifications, see registerSocketEventHandler
+ */
+typedef enum
+{
+    SOCKET_RX_READY = 0,            // value datagrams were added to the RX ring, IP is 0
+    SOCKET_TX_FAILED = 1,           // The device could not send to IP, value is the SimpleLink status
+    SOCKET_ERROR = 2                // Async socket error, value is its type (RX_FRAGMENTATION_TOO_BIG...)
+} SocketEvent_e;
+
+typedef void (*SocketEventHandler_t)(SocketEvent_e event, _u32 IP, _i16 value);
+
+/*
+ * RX filters installed on the CC3100 once it has an IP: IPv4 frames are dropped inside the device
+ * unless they are UDP to PORT_NUM from the local subnet (AP_MASK) or DHCP to the client port
+ */
+#define RX_FILTERS             7                        // Filters making up the tree, see InstallRxFilters
+#define DHCP_CLIENT_PORT       68
+
+/*
+ * The device keeps no per filter hit counts the host can read, so the RX socket checks what gets through
+ */
+typedef struct
+{
+    _u8 installed;                  // Filters added to the device
+    _u8 enabled;                    // Of those, reported enabled by the device
+    _u32 passed;                    // Datagrams on PORT_NUM from the local subnet
+    _u32 escaped;                   // Datagrams on PORT_NUM from elsewhere, 0 while the filters work
+} RxFilterStats_t;
 /**************************** Defines ******************************/
 
 
 /*********************** User Functions ************************/
 void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE);
 _i32 ReceiveData(_u8 *data, _u16 BUF_SIZE);
+_i32 ReceiveDataNonBlocking(_u8 *data, _u16 BUF_SIZE);
+_i32 ReceiveDatagram(_u8 *data, _u16 BUF_SIZE, _u32 *IP);
+_i32 ReceiveDatagramNonBlocking(_u8 *data, _u16 BUF_SIZE, _u32 *IP);
+void lendRxRing(RxPacket_t *slots, _u8 count);
+RxPacket_t *ReceivePacket();
+RxPacket_t *ReceivePacketNonBlocking();
+void ReleasePacket(RxPacket_t *packet);
+_u32 getRxDropped();
+_u32 getTxDropped();
+void registerSocketEventHandler(SocketEventHandler_t handler);
+void getRxFilterStats(RxFilterStats_t *stats);
 void initCC3100(playerType playerRole);
+void getConnectTiming(ConnectTiming_t *timing);
+_i32 startWlanRxStats();
+_i32 getWlanRxStats(SlGetRxStatResponse_t *stats);
+void SendStats(_u8 *data, _u16 BUF_SIZE);
 _u32 getLocalIP();
 /*********************** User Functions ************************/
 
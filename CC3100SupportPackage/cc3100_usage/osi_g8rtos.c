@@ -0,0 +1,216 @@
+#include "G8RTOS.h"
+#include "G8RTOS_CriticalSection.h"
+#include "osi_g8rtos.h"
+
+
+/****** SPAWN QUEUE ******/
+typedef struct
+{
+    void (*pEntry)(void *pValue);
+    void *pValue;
+} SpawnEntry_t;
+
+/* Written at the head by sl_Spawn (thread or IRQ), read at the tail by the spawn thread */
+static SpawnEntry_t spawnQueue[OSI_SPAWN_QUEUE_SIZE];
+static uint8_t spawnStarted = 0;
+static uint8_t spawnHead = 0;
+static uint8_t spawnTail = 0;
+static uint32_t spawnDropped = 0;
+
+static semaphore_t spawn_s;        // Entries waiting in the queue
+/****** SPAWN QUEUE ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+/*!
+    \brief Taking a semaphore only if it is available
+
+    \param[in]      s - semaphore to take
+
+    \return         OSI_OK if it was taken, OSI_TIMEOUT otherwise.
+ */
+static int16_t TryTake(semaphore_t *s)
+{
+    int32_t primask;
+    int16_t status = OSI_TIMEOUT;
+
+    primask = StartCriticalSection();
+    if(*s > 0)
+    {
+        (*s)--;
+        status = OSI_OK;
+    }
+    EndCriticalSection(primask);
+
+    return status;
+}
+
+/*!
+    \brief Taking a semaphore within Timeout ms
+
+    Blocks in G8RTOS_WaitSemaphore for OSI_WAIT_FOREVER. Other timeouts poll
+    once per ms, the driver itself only ever passes OSI_NO_WAIT.
+
+    \param[in]      s - semaphore to take
+    \param[in]      Timeout - ms, OSI_NO_WAIT or OSI_WAIT_FOREVER
+
+    \return         OSI_OK if it was taken, OSI_TIMEOUT otherwise.
+ */
+static int16_t Take(semaphore_t *s, OsiTime_t Timeout)
+{
+    uint32_t start;
+
+    if(Timeout == OSI_WAIT_FOREVER)
+    {
+        G8RTOS_WaitSemaphore(s);
+        return OSI_OK;
+    }
+
+    start = SystemTime;
+    while(TryTake(s) != OSI_OK)
+    {
+        if(SystemTime - start >= Timeout)
+            return OSI_TIMEOUT;
+        sleep(1);
+    }
+    return OSI_OK;
+}
+
+/*!
+    \brief Spawn thread
+
+    Runs the queued entries in order, sleeping while the queue is empty.
+ */
+static void SpawnThread()
+{
+    SpawnEntry_t entry;
+
+    while(1)
+    {
+        G8RTOS_WaitSemaphore(&spawn_s);
+
+        // The tail slot belongs to this thread until the tail moves past it
+        entry = spawnQueue[spawnTail];
+        spawnTail = (spawnTail + 1) % OSI_SPAWN_QUEUE_SIZE;
+
+        entry.pEntry(entry.pValue);
+    }
+}
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
+
+/*
+ * Starts the spawn thread, must run before sl_Start
+ * Later calls do nothing
+ */
+void osi_Init()
+{
+    if(spawnStarted)
+        return;
+    spawnStarted = 1;
+
+    G8RTOS_InitSemaphore(&spawn_s, 0);
+    G8RTOS_AddThread(SpawnThread, OSI_SPAWN_PRIORITY, "sl spawn");
+}
+
+/*
+ * Sync objects: binary semaphores, signals while already signalled are merged
+ */
+int16_t osi_SyncObjCreate(OsiSyncObj_t *pSyncObj)
+{
+    G8RTOS_InitSemaphore(pSyncObj, 0);
+    return OSI_OK;
+}
+
+int16_t osi_SyncObjDelete(OsiSyncObj_t *pSyncObj)
+{
+    G8RTOS_InitSemaphore(pSyncObj, 0);
+    return OSI_OK;
+}
+
+/*
+ * Safe to call from the CC3100 IRQ
+ */
+int16_t osi_SyncObjSignal(OsiSyncObj_t *pSyncObj)
+{
+    int32_t primask;
+
+    primask = StartCriticalSection();
+    if(*pSyncObj < 1)
+    {
+        G8RTOS_SignalSemaphore(pSyncObj);
+    }
+    EndCriticalSection(primask);
+
+    return OSI_OK;
+}
+
+int16_t osi_SyncObjWait(OsiSyncObj_t *pSyncObj, OsiTime_t Timeout)
+{
+    return Take(pSyncObj, Timeout);
+}
+
+/*
+ * Lock objects: semaphores starting at 1, not reentrant, the driver never takes one twice
+ */
+int16_t osi_LockObjCreate(OsiLockObj_t *pLockObj)
+{
+    G8RTOS_InitSemaphore(pLockObj, 1);
+    return OSI_OK;
+}
+
+int16_t osi_LockObjDelete(OsiLockObj_t *pLockObj)
+{
+    G8RTOS_InitSemaphore(pLockObj, 1);
+    return OSI_OK;
+}
+
+int16_t osi_LockObjLock(OsiLockObj_t *pLockObj, OsiTime_t Timeout)
+{
+    return Take(pLockObj, Timeout);
+}
+
+int16_t osi_LockObjUnlock(OsiLockObj_t *pLockObj)
+{
+    G8RTOS_SignalSemaphore(pLockObj);
+    return OSI_OK;
+}
+
+/*
+ * Queues pEntry(pValue) for the spawn thread, safe to call from the CC3100 IRQ
+ * Returns OSI_QUEUE_FULL if the queue has no room, the request is then dropped
+ */
+int16_t osi_Spawn(void (*pEntry)(void *pValue), void *pValue, uint32_t flags)
+{
+    int32_t primask;
+    uint8_t next;
+
+    primask = StartCriticalSection();
+    next = (spawnHead + 1) % OSI_SPAWN_QUEUE_SIZE;
+    if(next == spawnTail)
+    {
+        spawnDropped++;
+        EndCriticalSection(primask);
+        return OSI_QUEUE_FULL;
+    }
+    spawnQueue[spawnHead].pEntry = pEntry;
+    spawnQueue[spawnHead].pValue = pValue;
+    spawnHead = next;
+    G8RTOS_SignalSemaphore(&spawn_s);
+    EndCriticalSection(primask);
+
+    return OSI_OK;
+}
+
+/*
+ * Returns the number of spawn requests dropped because the queue was full
+ */
+uint32_t osi_GetSpawnDropped()
+{
+    return spawnDropped;
+}
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
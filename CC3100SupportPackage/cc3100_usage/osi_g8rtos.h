@@ -0,0 +1,52 @@
+/*
+ * osi_g8rtos.h
+ *
+ * SimpleLink OS adaptation on top of G8RTOS, bound to the driver in user.h.
+ *
+ * Sync objects are binary semaphores, lock objects are semaphores that start
+ * at 1. A caller waiting on either is blocked by the scheduler instead of
+ * spinning in _SlNonOsMainLoopTask. sl_Spawn queues the driver's deferred work
+ * (reading async events) for a dedicated spawn thread, it is safe to call from
+ * the CC3100 IRQ.
+ */
+
+#ifndef OSI_G8RTOS_H_
+#define OSI_G8RTOS_H_
+
+/********************** Includes *********************/
+#include <stdint.h>
+#include "G8RTOS.h"
+/********************** Includes *********************/
+
+/**************************** Defines ******************************/
+#define OSI_OK                  0
+#define OSI_TIMEOUT             -1
+#define OSI_QUEUE_FULL          -2
+
+#define OSI_WAIT_FOREVER        0xFFFFFFFF
+#define OSI_NO_WAIT             0
+
+#define OSI_SPAWN_QUEUE_SIZE    8                       // Spawn requests waiting at one time
+#define OSI_SPAWN_PRIORITY      0                       // Priority of the spawn thread
+
+typedef uint32_t OsiTime_t;                             // Timeout, ms
+typedef semaphore_t OsiSyncObj_t;
+typedef semaphore_t OsiLockObj_t;
+/**************************** Defines ******************************/
+
+
+/*********************** OSI Functions ************************/
+void osi_Init();
+int16_t osi_SyncObjCreate(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjDelete(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjSignal(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjWait(OsiSyncObj_t *pSyncObj, OsiTime_t Timeout);
+int16_t osi_LockObjCreate(OsiLockObj_t *pLockObj);
+int16_t osi_LockObjDelete(OsiLockObj_t *pLockObj);
+int16_t osi_LockObjLock(OsiLockObj_t *pLockObj, OsiTime_t Timeout);
+int16_t osi_LockObjUnlock(OsiLockObj_t *pLockObj);
+int16_t osi_Spawn(void (*pEntry)(void *pValue), void *pValue, uint32_t flags);
+uint32_t osi_GetSpawnDropped();
+/*********************** OSI Functions ************************/
+
+#endif /* OSI_G8RTOS_H_ */
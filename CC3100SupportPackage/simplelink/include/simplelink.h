@@ -216,7 +216,12 @@
 #ifndef __SIMPLELINK_H__
 #define    __SIMPLELINK_H__
 
+/* A port kept outside this tree (e.g. tools/nwpsim) names its own user.h */
+#ifdef SL_USER_HEADER
+#include SL_USER_HEADER
+#else
 #include "user.h"
+#endif
 
 #define __SL__
 
@@ -52,7 +52,9 @@ extern "C" {
 
 #define SL_SYNC_SCAN_THRESHOLD  (( _u32 )2000)
   
+#ifndef _SlDrvAssert
 #define _SlDrvAssert(line )  { while(1); }          
+#endif
 
 #define _SL_ASSERT(expr)            { if(!(expr)){_SlDrvAssert(__LINE__); } }
 #define _SL_ERROR(expr, error)      { if(!(expr)){return (error); } }
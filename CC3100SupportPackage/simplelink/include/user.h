@@ -114,8 +114,13 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
     \warning    In case of setting to one, recommend to use non-blocking recv\recvfrom to allow
 				multiple socket recv
+
+    \note       Sized for cc3100_usage: at most one recvfrom on the RX socket,
+                one sl_Connect of a TX socket (they are opened under tx_s) and
+                sl_Start/sl_Stop wait on a pool object at the same time, plus
+                one spare. Each pool object costs 12 bytes of the control block.
 */
-#define MAX_CONCURRENT_ACTIONS 10
+#define MAX_CONCURRENT_ACTIONS 4
 
 /*!
 	\def		CPU_FREQ_IN_MHZ
@@ -667,8 +672,34 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 #define SL_MEMORY_MGMT_DYNAMIC
 */
 
+/*!
+    \brief      Memory model tested by the driver
+
+                Static: the control block and the single async event buffer
+                live in g_StatMem (driver.c), nothing is allocated at run time.
+                Before this was spelled out both names were undefined, so the
+                driver's SL_MEMORY_MGMT == SL_MEMORY_MGMT_STATIC tests only
+                held because 0 == 0.
+
+                RAM with MAX_CONCURRENT_ACTIONS 4, 32-bit pointers:
+                    g_StatMem   304 bytes (132 control block, 168 async buffer, 4 align)
+                Dynamic model, same sizes from the heap:
+                    peak        300 bytes + 2 allocation headers, one async
+                                buffer malloc/free per event, and a heap region
+                                reserved at link time for it
+                With the previous MAX_CONCURRENT_ACTIONS 10 the control block
+                was 204 bytes (g_StatMem 376).
+
+    \note       belongs to \ref porting_sec
+*/
+#define SL_MEMORY_MGMT_STATIC       1
+
 #ifdef SL_MEMORY_MGMT_DYNAMIC
 
+#include <stdlib.h>
+
+#define SL_MEMORY_MGMT              0
+
 /*!
     \brief
 
@@ -678,7 +709,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
     \warning        
 */
-#define sl_Malloc(Size)
+#define sl_Malloc(Size)             malloc(Size)
 
 /*!
     \brief
@@ -689,7 +720,11 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
     \warning        
 */
-#define sl_Free(pMem)
+#define sl_Free(pMem)               free(pMem)
+
+#else
+
+#define SL_MEMORY_MGMT              SL_MEMORY_MGMT_STATIC
 
 #endif
 
@@ -728,18 +763,21 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
 
 // UNCOMMENTED BY ME
-//#define SL_PLATFORM_MULTI_THREADED
+#define SL_PLATFORM_MULTI_THREADED
 
 
 #ifdef SL_PLATFORM_MULTI_THREADED
 
+/* Bound to G8RTOS semaphores and a spawn thread, see osi_g8rtos.h */
+#include "osi_g8rtos.h"
+
 /*!
     \brief
     \sa
     \note           belongs to \ref porting_sec
     \warning
 */
-#define SL_OS_RET_CODE_OK
+#define SL_OS_RET_CODE_OK                           OSI_OK
 
 /*!
     \brief
@@ -747,7 +785,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note           belongs to \ref porting_sec
     \warning
 */
-#define SL_OS_WAIT_FOREVER
+#define SL_OS_WAIT_FOREVER                          OSI_WAIT_FOREVER
 
 /*!
     \brief
@@ -755,7 +793,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note           belongs to \ref porting_sec
     \warning
 */
-#define SL_OS_NO_WAIT
+#define SL_OS_NO_WAIT                               OSI_NO_WAIT
 
 /*!
 	\brief type definition for a time value
@@ -764,7 +802,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
     \note       belongs to \ref porting_sec
 */
-#define _SlTime_t				
+#define _SlTime_t                                   OsiTime_t
 
 /*!
 	\brief 	type definition for a sync object container
@@ -779,7 +817,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 
     \note       belongs to \ref porting_sec
 */
-#define _SlSyncObj_t			
+#define _SlSyncObj_t                                OsiSyncObj_t
 
     
 /*!
@@ -796,7 +834,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_SyncObjCreate(pSyncObj,pName)           
+#define sl_SyncObjCreate(pSyncObj,pName)        osi_SyncObjCreate(pSyncObj)
 
     
 /*!
@@ -809,7 +847,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_SyncObjDelete(pSyncObj)                  
+#define sl_SyncObjDelete(pSyncObj)              osi_SyncObjDelete(pSyncObj)
 
     
 /*!
@@ -824,7 +862,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 	\note		the function could be called from ISR context
 	\warning
 */
-#define sl_SyncObjSignal(pSyncObj)                
+#define sl_SyncObjSignal(pSyncObj)              osi_SyncObjSignal(pSyncObj)
 
 /*!
 	\brief 		This function generates a sync signal for the object from Interrupt
@@ -838,7 +876,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 	\note		the function could be called from ISR context
 	\warning
 */
-#define sl_SyncObjSignalFromIRQ(pSyncObj)           
+#define sl_SyncObjSignalFromIRQ(pSyncObj)       osi_SyncObjSignal(pSyncObj)
 /*!
 	\brief 	This function waits for a sync signal of the specific sync object
 
@@ -854,7 +892,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_SyncObjWait(pSyncObj,Timeout)             
+#define sl_SyncObjWait(pSyncObj,Timeout)        osi_SyncObjWait(pSyncObj,Timeout)
     
 /*!
 	\brief 	type definition for a locking object container
@@ -866,7 +904,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 	\note	On each porting or platform the type could be whatever is needed - integer, structure etc.
     \note       belongs to \ref porting_sec
 */
-#define _SlLockObj_t 			
+#define _SlLockObj_t                                OsiLockObj_t
 
 /*!
 	\brief 	This function creates a locking object.
@@ -881,7 +919,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_LockObjCreate(pLockObj,pName)            
+#define sl_LockObjCreate(pLockObj,pName)        osi_LockObjCreate(pLockObj)
     
 /*!
 	\brief 	This function deletes a locking object.
@@ -893,7 +931,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_LockObjDelete(pLockObj)                 
+#define sl_LockObjDelete(pLockObj)              osi_LockObjDelete(pLockObj)
     
 /*!
 	\brief 	This function locks a locking object.
@@ -914,7 +952,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_LockObjLock(pLockObj,Timeout)            
+#define sl_LockObjLock(pLockObj,Timeout)        osi_LockObjLock(pLockObj,Timeout)
     
 /*!
 	\brief 	This function unlock a locking object.
@@ -926,7 +964,7 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-#define sl_LockObjUnlock(pLockObj)                 
+#define sl_LockObjUnlock(pLockObj)              osi_LockObjUnlock(pLockObj)
 
 #endif
 /*!
@@ -946,12 +984,11 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
     \note       belongs to \ref porting_sec
 	\warning
 */
-/*
+/* The internal spawn in spawn.c takes a lock object from the IRQ, G8RTOS cannot block there */
 #define SL_PLATFORM_EXTERNAL_SPAWN
-*/
 
 #ifdef SL_PLATFORM_EXTERNAL_SPAWN
-#define sl_Spawn(pEntry,pValue,flags)               
+#define sl_Spawn(pEntry,pValue,flags)               osi_Spawn(pEntry,pValue,flags)
 #endif
 
 /*!
@@ -329,25 +329,18 @@ _SlReturnVal_t _SlDrvDataReadOp(
 
 
     /* Do Flow Control check/update for DataWrite operation */
-    OSI_RET_OK_CHECK( sl_LockObjLock(&g_pCB->FlowContCB.TxLockObj, SL_OS_WAIT_FOREVER) );
-
-    /* Clear SyncObj for the case it was signalled before TxPoolCnt */
-    /* dropped below '1' (last Data buffer was taken)  */
-    /* OSI_RET_OK_CHECK( sl_SyncObjClear(&g_pCB->FlowContCB.TxSyncObj) ); */
-    sl_SyncObjClear(&g_pCB->FlowContCB.TxSyncObj);
-
-    if(g_pCB->FlowContCB.TxPoolCnt <= FLOW_CONT_MIN)
+    /* Recvfrom may use the buffer that writes leave free, its response brings in the next credit update */
+    RetVal = _SlDrvFlowContWait(Sd, FLOW_CONT_MIN, FALSE);
+    if(SL_OS_RET_CODE_OK != RetVal)
     {
-
-        /* If TxPoolCnt was increased by other thread at this moment,
-        TxSyncObj won't wait here */
-        OSI_RET_OK_CHECK( sl_SyncObjWait(&g_pCB->FlowContCB.TxSyncObj, SL_OS_WAIT_FOREVER) );
+        _SlDrvReleasePoolObj(ObjIdx);
+        return RetVal;
     }
 
     OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->GlobalLockObj, SL_OS_WAIT_FOREVER));
 
     VERIFY_PROTOCOL(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN);
-    g_pCB->FlowContCB.TxPoolCnt--;
+    _SlDrvFlowContTake();
 
     OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
 
@@ -380,49 +373,20 @@ _SlReturnVal_t _SlDrvDataWriteOp(
     void                *pTxRxDescBuff ,
     _SlCmdExt_t         *pCmdExt)
 {
-    _SlReturnVal_t  RetVal = SL_EAGAIN; /*  initiated as SL_EAGAIN for the non blocking mode */
-    while( 1 )
-    {
-        /*  Do Flow Control check/update for DataWrite operation */
-        OSI_RET_OK_CHECK( sl_LockObjLock(&g_pCB->FlowContCB.TxLockObj, SL_OS_WAIT_FOREVER) );
-
-        /*  Clear SyncObj for the case it was signalled before TxPoolCnt */
-        /*  dropped below '1' (last Data buffer was taken) */
-        /* OSI_RET_OK_CHECK( sl_SyncObjClear(&g_pCB->FlowContCB.TxSyncObj) ); */
-        sl_SyncObjClear(&g_pCB->FlowContCB.TxSyncObj);
+    _SlReturnVal_t  RetVal;
 
-        /*  we have indication that the last send has failed - socket is no longer valid for operations  */
-        if(g_pCB->SocketTXFailure & (1<<(Sd & BSD_SOCKET_ID_MASK)))
-        {
-            OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
-            return SL_SOC_ERROR;
-        }
-        if(g_pCB->FlowContCB.TxPoolCnt <= FLOW_CONT_MIN + 1)
-        {
-            /*  we have indication that this socket is set as blocking and we try to  */
-            /*  unblock it - return an error */
-            if( g_pCB->SocketNonBlocking >> (Sd & BSD_SOCKET_ID_MASK) )
-            {
-                OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
-                return RetVal;
-            }
-            /*  If TxPoolCnt was increased by other thread at this moment, */
-            /*  TxSyncObj won't wait here */
-            OSI_RET_OK_CHECK( sl_SyncObjWait(&g_pCB->FlowContCB.TxSyncObj, SL_OS_WAIT_FOREVER) );
-        }
-        if(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN + 1 )
-        {
-            break;
-        }
-        else
-        {
-            OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
-        }
+    /*  Do Flow Control check/update for DataWrite operation */
+    /*  TxLockObj is not held while waiting, so receives keep flowing while senders wait */
+    RetVal = _SlDrvFlowContWait(Sd, FLOW_CONT_MIN + 1, TRUE);
+    if(SL_OS_RET_CODE_OK != RetVal)
+    {
+        return RetVal;
     }
+
     OSI_RET_OK_CHECK( sl_LockObjLock(&g_pCB->GlobalLockObj, SL_OS_WAIT_FOREVER) );
 
     VERIFY_PROTOCOL(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN + 1 );
-    g_pCB->FlowContCB.TxPoolCnt--;
+    _SlDrvFlowContTake();
 
     OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
 
@@ -534,10 +498,7 @@ _SlReturnVal_t _SlDrvMsgRead(void)
         g_pCB->SocketNonBlocking = ((_SlResponseHeader_t *)uBuf.TempBuf)->SocketNonBlocking;
         g_pCB->SocketTXFailure = ((_SlResponseHeader_t *)uBuf.TempBuf)->SocketTXFailure;
 
-        if(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN)
-        {
-            OSI_RET_OK_CHECK(sl_SyncObjSignal(&g_pCB->FlowContCB.TxSyncObj));
-        }
+        _SlDrvFlowContSignal();
     }
 
     _SlDrvClassifyRxMsg(OPCODE(uBuf.TempBuf));
@@ -120,7 +120,8 @@ typedef struct
 {
     _u8             TxPoolCnt;
     _SlLockObj_t    TxLockObj;
-    _SlSyncObj_t    TxSyncObj;
+    _SlSyncObj_t    TxSyncObj;      /* data writes wait here for TxPoolCnt > FLOW_CONT_MIN + 1 */
+    _SlSyncObj_t    ReadSyncObj;    /* data reads wait here for TxPoolCnt > FLOW_CONT_MIN */
 }_SlFlowContCB_t;
 
 typedef enum
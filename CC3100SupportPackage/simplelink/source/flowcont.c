@@ -55,6 +55,8 @@ void _SlDrvFlowContInit(void)
     OSI_RET_OK_CHECK(sl_LockObjCreate(&g_pCB->FlowContCB.TxLockObj, "TxLockObj"));
 
     OSI_RET_OK_CHECK(sl_SyncObjCreate(&g_pCB->FlowContCB.TxSyncObj, "TxSyncObj"));
+
+    OSI_RET_OK_CHECK(sl_SyncObjCreate(&g_pCB->FlowContCB.ReadSyncObj, "ReadSyncObj"));
 }
 
 /*****************************************************************************/
@@ -67,5 +69,88 @@ void _SlDrvFlowContDeinit(void)
     OSI_RET_OK_CHECK(sl_LockObjDelete(&g_pCB->FlowContCB.TxLockObj));
 
     OSI_RET_OK_CHECK(sl_SyncObjDelete(&g_pCB->FlowContCB.TxSyncObj));
+
+    OSI_RET_OK_CHECK(sl_SyncObjDelete(&g_pCB->FlowContCB.ReadSyncObj));
 }
 
+/*****************************************************************************/
+/* _SlDrvFlowContWait */
+/*****************************************************************************/
+/*  Waits until more than MinCnt TX buffers are free on the device and returns */
+/*  with TxLockObj held. The lock is released while waiting, so a thread that  */
+/*  needs fewer buffers (recvfrom may use the one reserved for it) is not held */
+/*  up by a sender, and the response it brings in refills TxPoolCnt.           */
+/*  IsWrite: fail on a socket the device reported a TX failure on, and return  */
+/*  SL_EAGAIN instead of waiting for a non-blocking socket.                    */
+/*  Writes need one buffer more than reads, so each waits on its own sync      */
+/*  object: a woken writer that still cannot go would otherwise swallow the    */
+/*  signal a waiting read could have used.                                     */
+_SlReturnVal_t _SlDrvFlowContWait(_u8 Sd, _u8 MinCnt, _u8 IsWrite)
+{
+    _SlSyncObj_t *pSyncObj = IsWrite ? &g_pCB->FlowContCB.TxSyncObj : &g_pCB->FlowContCB.ReadSyncObj;
+
+    while(1)
+    {
+        OSI_RET_OK_CHECK( sl_LockObjLock(&g_pCB->FlowContCB.TxLockObj, SL_OS_WAIT_FOREVER) );
+
+        /*  Clear SyncObj for the case it was signalled before TxPoolCnt */
+        /*  dropped below '1' (last Data buffer was taken) */
+        /* OSI_RET_OK_CHECK( sl_SyncObjClear(pSyncObj) ); */
+        sl_SyncObjClear(pSyncObj);
+
+        /*  we have indication that the last send has failed - socket is no longer valid for operations  */
+        if(IsWrite && (g_pCB->SocketTXFailure & (1<<(Sd & BSD_SOCKET_ID_MASK))))
+        {
+            OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
+            return SL_SOC_ERROR;
+        }
+
+        if(g_pCB->FlowContCB.TxPoolCnt > MinCnt)
+        {
+            return SL_OS_RET_CODE_OK;
+        }
+
+        OSI_RET_OK_CHECK( sl_LockObjUnlock(&g_pCB->FlowContCB.TxLockObj) );
+
+        /*  the socket is set as non-blocking - do not wait for buffers */
+        if(IsWrite && ((g_pCB->SocketNonBlocking >> (Sd & BSD_SOCKET_ID_MASK)) & 1))
+        {
+            return SL_EAGAIN;
+        }
+
+        /*  Signalled by _SlDrvFlowContSignal once TxPoolCnt is above MinCnt. */
+        /*  A signal given between the unlock above and this wait is not lost. */
+        OSI_RET_OK_CHECK( sl_SyncObjWait(pSyncObj, SL_OS_WAIT_FOREVER) );
+    }
+}
+
+/*****************************************************************************/
+/* _SlDrvFlowContTake */
+/*****************************************************************************/
+/*  Takes one TX buffer after _SlDrvFlowContWait, with TxLockObj and           */
+/*  GlobalLockObj held. If buffers are left, other waiting threads are woken   */
+/*  to check them, so several writes can go out on one credit update.          */
+void _SlDrvFlowContTake(void)
+{
+    g_pCB->FlowContCB.TxPoolCnt--;
+
+    _SlDrvFlowContSignal();
+}
+
+/*****************************************************************************/
+/* _SlDrvFlowContSignal */
+/*****************************************************************************/
+/*  Wakes a waiting read if TxPoolCnt allows one, and a waiting write if it    */
+/*  allows one too. Called when a message updates TxPoolCnt and after a take.  */
+void _SlDrvFlowContSignal(void)
+{
+    if(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN)
+    {
+        OSI_RET_OK_CHECK(sl_SyncObjSignal(&g_pCB->FlowContCB.ReadSyncObj));
+    }
+
+    if(g_pCB->FlowContCB.TxPoolCnt > FLOW_CONT_MIN + 1)
+    {
+        OSI_RET_OK_CHECK(sl_SyncObjSignal(&g_pCB->FlowContCB.TxSyncObj));
+    }
+}
@@ -52,6 +52,9 @@ extern "C" {
 /*****************************************************************************/
 extern void _SlDrvFlowContInit(void);
 extern void _SlDrvFlowContDeinit(void);
+extern _SlReturnVal_t _SlDrvFlowContWait(_u8 Sd, _u8 MinCnt, _u8 IsWrite);
+extern void _SlDrvFlowContTake(void);
+extern void _SlDrvFlowContSignal(void);
 
 #ifdef  __cplusplus
 }
@@ -36,10 +36,13 @@
 
 #ifndef SL_IF_TYPE_UART
 #include <msp432.h>
+#include <string.h>
 
 #include "simplelink.h"
 #include "spi_cc3100.h"
 #include "board.h"
+#include "driverlib.h"
+#include "G8RTOS.h"
 
 //MSP430F5529
 //#define ASSERT_CS()          (P2OUT &= ~BIT2)
@@ -48,12 +51,106 @@
 #define ASSERT_CS()          (P3OUT &= ~BIT0)
 #define DEASSERT_CS()        (P3OUT |= BIT0)
 
+/* uDMA channels wired to eUSCI_B0, the RX channel's completion ends a transfer */
+#define SPI_DMA_TX           DMA_CH0_EUSCIB0TX0
+#define SPI_DMA_RX           DMA_CH1_EUSCIB0RX0
+#define SPI_DMA_TX_CH        0
+#define SPI_DMA_RX_CH        1
+
+/* Control table for all channels, the uDMA needs it 1 KB aligned */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(dmaControlTable, 1024)
+static DMA_ControlTable dmaControlTable[32];
+#else
+static DMA_ControlTable dmaControlTable[32] __attribute__((aligned(1024)));
+#endif
+
+static semaphore_t dmaDone_s;                   /* Signalled when the RX channel finishes */
+static const unsigned char txDummy = 0xFF;      /* Clocked out while reading */
+static unsigned char rxDummy;                   /* Sink for bytes received while writing */
+static SpiStats_t stats;
+static int dmaReady = 0;
+
+/*
+ * uDMA completion of the RX channel, wakes the thread that started the transfer
+ */
+static void DmaDone_isr()
+{
+    MAP_DMA_clearInterruptFlag(SPI_DMA_RX_CH);
+    G8RTOS_SignalSemaphore(&dmaDone_s);
+}
+
+/*
+ * Sets up eUSCI_B0's uDMA channels and their completion interrupt
+ */
+static void DmaInit()
+{
+    MAP_DMA_enableModule();
+    MAP_DMA_setControlBase(dmaControlTable);
+
+    MAP_DMA_assignChannel(SPI_DMA_TX);
+    MAP_DMA_assignChannel(SPI_DMA_RX);
+    MAP_DMA_disableChannelAttribute(SPI_DMA_TX, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    MAP_DMA_disableChannelAttribute(SPI_DMA_RX, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+
+    G8RTOS_InitSemaphore(&dmaDone_s, 0);
+    MAP_DMA_assignInterrupt(DMA_INT1, SPI_DMA_RX_CH);
+    MAP_DMA_clearInterruptFlag(SPI_DMA_RX_CH);
+    G8RTOS_AddAPeriodicEvent(DmaDone_isr, SPI_DMA_IRQ_PRIORITY, DMA_INT1_IRQn);
+}
+
+/*
+ * Moves len bytes in both directions through the uDMA and sleeps until the last one is received
+ * Either side may be a fixed dummy byte instead of a buffer
+ */
+static void DmaTransfer(const unsigned char *tx, int txIncrement, unsigned char *rx, int rxIncrement, int len)
+{
+    int chunk;
+
+    while (len)
+    {
+        chunk = len < SPI_DMA_MAX_TRANSFER ? len : SPI_DMA_MAX_TRANSFER;
+
+        MAP_DMA_setChannelControl(UDMA_PRI_SELECT | SPI_DMA_RX,
+                UDMA_SIZE_8 | UDMA_SRC_INC_NONE | (rxIncrement ? UDMA_DST_INC_8 : UDMA_DST_INC_NONE) | UDMA_ARB_1);
+        MAP_DMA_setChannelTransfer(UDMA_PRI_SELECT | SPI_DMA_RX, UDMA_MODE_BASIC,
+                (void *)MAP_SPI_getReceiveBufferAddressForDMA(EUSCI_B0_BASE), rx, chunk);
+
+        MAP_DMA_setChannelControl(UDMA_PRI_SELECT | SPI_DMA_TX,
+                UDMA_SIZE_8 | (txIncrement ? UDMA_SRC_INC_8 : UDMA_SRC_INC_NONE) | UDMA_DST_INC_NONE | UDMA_ARB_1);
+        MAP_DMA_setChannelTransfer(UDMA_PRI_SELECT | SPI_DMA_TX, UDMA_MODE_BASIC,
+                (void *)tx, (void *)MAP_SPI_getTransmitBufferAddressForDMA(EUSCI_B0_BASE), chunk);
+
+        /* RX first, so the first byte back always has somewhere to go */
+        MAP_DMA_enableChannel(SPI_DMA_RX_CH);
+        MAP_DMA_enableChannel(SPI_DMA_TX_CH);
+        MAP_DMA_enableInterrupt(INT_DMA_INT1);
+
+        G8RTOS_WaitSemaphore(&dmaDone_s);
+        MAP_DMA_disableInterrupt(INT_DMA_INT1);
+
+        tx += txIncrement ? chunk : 0;
+        rx += rxIncrement ? chunk : 0;
+        len -= chunk;
+    }
+}
+
+/*
+ * Adds a finished transfer to the counters of its mode
+ */
+static void CountTransfer(SpiModeStats_t *mode, int len, unsigned long start)
+{
+    mode->transfers++;
+    mode->bytes += len;
+    mode->cycles += start - MAP_Timer32_getValue(TIMER32_1_BASE);
+}
+
 int spi_Close(Fd_t fd)
 {
     /* Disable WLAN Interrupt ... */
     CC3100_InterruptDisable();
 
-    return NONOS_RET_OK;
+    return 0;
 }
 
 Fd_t spi_Open(char *ifName, unsigned long flags)
@@ -95,21 +192,42 @@ Fd_t spi_Open(char *ifName, unsigned long flags)
     P3SEL1 &= ~BIT0;
     P3DIR |= BIT0;
 
+    /* Long transfers run on the uDMA, Timer32 module 1 times every transfer
+       The driver reopens the port on every sl_Start, set up only once */
+    if (!dmaReady)
+    {
+        DmaInit();
+        memset(&stats, 0, sizeof(stats));
+        stats.mclkHz = MAP_CS_getMCLK();
+        MAP_Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT, TIMER32_FREE_RUN_MODE);
+        MAP_Timer32_startTimer(TIMER32_1_BASE, false);
+        dmaReady = 1;
+    }
+
     /* 50 ms delay */
     Delay(50);
 
     /* Enable WLAN interrupt */
     CC3100_InterruptEnable();
 
-    return NONOS_RET_OK;
+    return 0;
 }
 
 
 int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
 {
-        int len_to_return = len;
+    int len_to_return = len;
+    unsigned long start = MAP_Timer32_getValue(TIMER32_1_BASE);
 
     ASSERT_CS();
+    if (len >= SPI_DMA_THRESHOLD)
+    {
+        DmaTransfer(pBuff, 1, &rxDummy, 0, len);
+        DEASSERT_CS();
+        CountTransfer(&stats.dma, len_to_return, start);
+        return len_to_return;
+    }
+
     while (len)
     {
         while (!(UCB0IFG&UCTXIFG));
@@ -121,6 +239,7 @@ int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
     }
 
     DEASSERT_CS();
+    CountTransfer(&stats.pio, len_to_return, start);
 
     return len_to_return;
 }
@@ -129,8 +248,16 @@ int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
 int spi_Read(Fd_t fd, unsigned char *pBuff, int len)
 {
     int i = 0;
+    unsigned long start = MAP_Timer32_getValue(TIMER32_1_BASE);
 
     ASSERT_CS();
+    if (len >= SPI_DMA_THRESHOLD)
+    {
+        DmaTransfer(&txDummy, 0, pBuff, 1, len);
+        DEASSERT_CS();
+        CountTransfer(&stats.dma, len, start);
+        return len;
+    }
 
     for (i = 0; i < len; i ++)
     {
@@ -141,7 +268,14 @@ int spi_Read(Fd_t fd, unsigned char *pBuff, int len)
     }
 
     DEASSERT_CS();
+    CountTransfer(&stats.pio, len, start);
 
     return len;
 }
+
+
+void spi_GetStats(SpiStats_t *pStats)
+{
+    *pStats = stats;
+}
 #endif /* SL_IF_TYPE_UART */
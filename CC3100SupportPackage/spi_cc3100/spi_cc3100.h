@@ -50,6 +50,52 @@ extern "C" {
 */
 typedef unsigned int Fd_t;
 
+/*!
+    \brief  Transfers shorter than this many bytes are polled byte by byte,
+            longer ones go through uDMA while the caller sleeps. Below it the
+            DMA setup and the two context switches cost more than the bytes.
+
+    \note   The driver's own transfers are 4 (sync words, headers), 8 and 12
+            bytes (descriptors), payloads move in multiples of 4, see the length
+            histogram of tools/nwpsim/nwpbench. Game datagrams take 20 bytes
+            (an ack or one input alone) to 128. 24 polls the framing and those
+            smallest datagrams and moves the rest on the uDMA, anything from
+            13 to 20 would move the 20 byte ones as well. The MCLK cycles each
+            mode costs on the board are in the telemetry packet (Telemetry.h).
+*/
+#define SPI_DMA_THRESHOLD       24
+
+/*!
+    \brief  Largest uDMA transfer, longer ones are split
+*/
+#define SPI_DMA_MAX_TRANSFER    1024
+
+/*!
+    \brief  NVIC priority of the uDMA completion interrupt
+*/
+#define SPI_DMA_IRQ_PRIORITY    5
+
+/*!
+    \brief  Traffic moved in one transfer mode
+*/
+typedef struct
+{
+    unsigned long transfers;
+    unsigned long bytes;
+    unsigned long cycles;       /* MCLK cycles with CS asserted */
+} SpiModeStats_t;
+
+/*!
+    \brief  Traffic on the CC3100 SPI link, bytes per second in a mode is
+            bytes * mclkHz / cycles
+*/
+typedef struct
+{
+    SpiModeStats_t pio;
+    SpiModeStats_t dma;
+    unsigned long mclkHz;
+} SpiStats_t;
+
 
 /*!
     \brief open spi communication port to be used for communicating with a
@@ -139,6 +185,17 @@ int spi_Read(Fd_t fd, unsigned char *pBuff, int len);
 */
 int spi_Write(Fd_t fd, unsigned char *pBuff, int len);
 
+/*!
+    \brief copies the transfer counters of both modes
+
+    \param[out]     stats     -    filled with the counters since the first spi_Open
+
+    \sa             spi_Read , spi_Write
+    \note
+    \warning
+*/
+void spi_GetStats(SpiStats_t *stats);
+
 #ifdef  __cplusplus
 }
 #endif // __cplusplus
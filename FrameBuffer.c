@@ -0,0 +1,363 @@
+/*
+ * FrameBuffer.c
+ */
+
+#include "FrameBuffer.h"
+#include "PixelKernels.h"
+#include "msp.h"
+#include "driverlib.h"
+#include <string.h>
+
+/************************************  Data Structures  *******************************************/
+
+/*
+ * A tile is either
+ *  - unbacked: GRAM holds the only copy of its pixels
+ *  - solid:    every pixel is the same palette index
+ *  - cached:   per-pixel data lives in one of the cache slots
+ */
+typedef enum
+{
+    TILE_UNBACKED = 0,
+    TILE_SOLID = 1,
+    TILE_CACHED = 2
+}tileState_t;
+
+typedef struct
+{
+    uint8_t state;
+    uint8_t solid;
+    uint8_t slot;
+}Tile_t;
+
+typedef struct
+{
+    uint8_t pixels[FB_TILE_PIXELS];
+    uint32_t lastUse;
+    uint8_t tile;
+    bool inUse;
+}TileSlot_t;
+
+static Tile_t tiles[FB_NUM_TILES];
+static TileSlot_t slots[FB_CACHED_TILES];
+static uint32_t dirty[(FB_NUM_TILES + 31) / 32];
+static uint16_t palette[FB_PALETTE_SIZE];
+static uint16_t paletteUsed;
+static uint32_t useCounter;
+static int16_t originX;
+static int16_t originY;
+
+/************************************  Data Structures  *******************************************/
+
+
+/************************************  Private Functions  *******************************************/
+
+static inline void MarkDirty(uint16_t t)
+{
+    dirty[t >> 5] |= (1UL << (t & 31));
+}
+
+/*
+ * Streams a run of palette indexed pixels into the current GRAM window,
+ * expanding them a tile row at a time
+ */
+static void WriteRun(uint8_t *pixels, uint16_t len)
+{
+    uint16_t line[FB_TILE_SIZE];
+    uint16_t n;
+
+    LCD_WriteGRAMStart();
+    while(len){
+        n = (len > FB_TILE_SIZE) ? FB_TILE_SIZE : len;
+        PK_ExpandPaletteSwapped(line, pixels, palette, n);
+        LCD_WriteGRAMBuffer(line, n);
+        pixels += n;
+        len -= n;
+    }
+    LCD_WriteGRAMEnd();
+}
+
+/*
+ * Writes a single tile to GRAM, skipping pixels the buffer does not own
+ */
+static void FlushTile(uint16_t t)
+{
+    int16_t x0 = originX + (t % FB_TILES_X) * FB_TILE_SIZE;
+    int16_t y0 = originY + (t / FB_TILES_X) * FB_TILE_SIZE;
+    uint8_t *pix;
+    int i, row, start;
+    bool opaque = true;
+
+    dirty[t >> 5] &= ~(1UL << (t & 31));
+
+    switch(tiles[t].state){
+    case TILE_SOLID:
+        LCD_SetWindow(x0, x0 + FB_TILE_SIZE, y0, y0 + FB_TILE_SIZE);
+        LCD_Clear(palette[tiles[t].solid], FB_TILE_SIZE, FB_TILE_SIZE);
+        break;
+    case TILE_CACHED:
+        pix = slots[tiles[t].slot].pixels;
+        for(i = 0; i < FB_TILE_PIXELS; i++){
+            if(pix[i] == FB_TRANSPARENT){
+                opaque = false;
+                break;
+            }
+        }
+
+        //One window for the whole tile if we own every pixel
+        if(opaque){
+            LCD_SetWindow(x0, x0 + FB_TILE_SIZE, y0, y0 + FB_TILE_SIZE);
+            WriteRun(pix, FB_TILE_PIXELS);
+            break;
+        }
+
+        //Otherwise only send the runs we own, one row at a time
+        for(row = 0; row < FB_TILE_SIZE; row++, pix += FB_TILE_SIZE){
+            i = 0;
+            while(i < FB_TILE_SIZE){
+                while(i < FB_TILE_SIZE && pix[i] == FB_TRANSPARENT){
+                    i++;
+                }
+                start = i;
+                while(i < FB_TILE_SIZE && pix[i] != FB_TRANSPARENT){
+                    i++;
+                }
+                if(i > start){
+                    LCD_SetWindow(x0 + start, x0 + i, y0 + row, y0 + row + 1);
+                    WriteRun(&pix[start], i - start);
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Frees a cache slot, writing it out first if needed.
+ * The tile collapses to solid if it is uniform, otherwise GRAM keeps it.
+ */
+static void EvictSlot(uint8_t s)
+{
+    uint16_t t = slots[s].tile;
+    uint8_t *pix = slots[s].pixels;
+    int i;
+
+    if(dirty[t >> 5] & (1UL << (t & 31))){
+        FlushTile(t);
+    }
+
+    tiles[t].state = TILE_SOLID;
+    tiles[t].solid = pix[0];
+    for(i = 0; i < FB_TILE_PIXELS; i++){
+        if(pix[i] != pix[0] || pix[i] == FB_TRANSPARENT){
+            tiles[t].state = TILE_UNBACKED;
+            break;
+        }
+    }
+
+    slots[s].inUse = false;
+}
+
+/*
+ * Returns a free cache slot, evicting the least recently used one if necessary
+ */
+static uint8_t AcquireSlot()
+{
+    uint8_t s;
+    uint8_t oldest = 0;
+
+    for(s = 0; s < FB_CACHED_TILES; s++){
+        if(!slots[s].inUse){
+            return s;
+        }
+        if(slots[s].lastUse < slots[oldest].lastUse){
+            oldest = s;
+        }
+    }
+
+    EvictSlot(oldest);
+    return oldest;
+}
+
+/*
+ * Makes sure a tile has per-pixel data and returns it
+ */
+static uint8_t *MaterializeTile(uint16_t t)
+{
+    uint8_t s;
+    int i;
+    uint8_t fill;
+
+    if(tiles[t].state != TILE_CACHED){
+        s = AcquireSlot();
+        fill = (tiles[t].state == TILE_SOLID) ? tiles[t].solid : FB_TRANSPARENT;
+        for(i = 0; i < FB_TILE_PIXELS; i++){
+            slots[s].pixels[i] = fill;
+        }
+        slots[s].tile = t;
+        slots[s].inUse = true;
+        tiles[t].slot = s;
+        tiles[t].state = TILE_CACHED;
+    }
+
+    slots[tiles[t].slot].lastUse = ++useCounter;
+    return slots[tiles[t].slot].pixels;
+}
+
+/************************************  Private Functions  *******************************************/
+
+
+/************************************  Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : FB_Init
+ * Description    : Resets the palette and ties the buffer to a screen location
+ * Input          : xOrigin, yOrigin: top left corner of the buffered region
+ * Output         : None
+ * Return         : None
+ * Attention      : GRAM is taken as the initial contents, nothing is redrawn
+ *******************************************************************************/
+void FB_Init(int16_t xOrigin, int16_t yOrigin)
+{
+    originX = xOrigin;
+    originY = yOrigin;
+    paletteUsed = 0;
+    useCounter = 0;
+    FB_Invalidate();
+}
+
+/*******************************************************************************
+ * Function Name  : FB_Invalidate
+ * Description    : Drops every cached and pending tile
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Call after drawing over the region directly with LCDLib
+ *******************************************************************************/
+void FB_Invalidate()
+{
+    int i;
+    for(i = 0; i < FB_NUM_TILES; i++){
+        tiles[i].state = TILE_UNBACKED;
+    }
+    for(i = 0; i < FB_CACHED_TILES; i++){
+        slots[i].inUse = false;
+    }
+    for(i = 0; i < sizeof(dirty) / sizeof(dirty[0]); i++){
+        dirty[i] = 0;
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : FB_ColorIndex
+ * Description    : Looks up (or adds) an RGB565 color in the palette
+ * Input          : Color: RGB565 color
+ * Output         : None
+ * Return         : Palette index of the color
+ * Attention      : Falls back to index 0 once the palette is full
+ *******************************************************************************/
+uint8_t FB_ColorIndex(uint16_t Color)
+{
+    uint16_t i;
+    for(i = 0; i < paletteUsed; i++){
+        if(palette[i] == Color){
+            return i;
+        }
+    }
+
+    if(paletteUsed == FB_PALETTE_SIZE){
+        return 0;
+    }
+
+    palette[paletteUsed] = Color;
+    return paletteUsed++;
+}
+
+/*******************************************************************************
+ * Function Name  : FB_DrawRectangle
+ * Description    : Draw a rectangle as the specified color into the back buffer
+ * Input          : xStart, xEnd, yStart, yEnd, Color (screen coordinates)
+ * Output         : None
+ * Return         : None
+ * Attention      : Same coordinates as LCD_DrawRectangle, clipped to the region
+ *******************************************************************************/
+void FB_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    uint8_t index = FB_ColorIndex(Color);
+    int16_t tx, ty, x0, x1, y0, y1, y;
+    uint16_t t;
+    uint8_t *pix;
+
+    //Move into buffer coordinates and clip
+    xStart -= originX;
+    xEnd -= originX;
+    yStart -= originY;
+    yEnd -= originY;
+    if(xStart < 0) xStart = 0;
+    if(yStart < 0) yStart = 0;
+    if(xEnd > FB_WIDTH) xEnd = FB_WIDTH;
+    if(yEnd > FB_HEIGHT) yEnd = FB_HEIGHT;
+    if(xStart >= xEnd || yStart >= yEnd){
+        return;
+    }
+
+    for(ty = yStart / FB_TILE_SIZE; ty <= (yEnd - 1) / FB_TILE_SIZE; ty++){
+        for(tx = xStart / FB_TILE_SIZE; tx <= (xEnd - 1) / FB_TILE_SIZE; tx++){
+            t = ty * FB_TILES_X + tx;
+
+            //Part of the rectangle inside this tile, in tile coordinates
+            x0 = xStart - tx * FB_TILE_SIZE;
+            x1 = xEnd - tx * FB_TILE_SIZE;
+            y0 = yStart - ty * FB_TILE_SIZE;
+            y1 = yEnd - ty * FB_TILE_SIZE;
+            if(x0 < 0) x0 = 0;
+            if(y0 < 0) y0 = 0;
+            if(x1 > FB_TILE_SIZE) x1 = FB_TILE_SIZE;
+            if(y1 > FB_TILE_SIZE) y1 = FB_TILE_SIZE;
+
+            MarkDirty(t);
+
+            //Covering the whole tile makes it solid, no need for a cache slot
+            if(x0 == 0 && y0 == 0 && x1 == FB_TILE_SIZE && y1 == FB_TILE_SIZE){
+                if(tiles[t].state == TILE_CACHED){
+                    slots[tiles[t].slot].inUse = false;
+                }
+                tiles[t].state = TILE_SOLID;
+                tiles[t].solid = index;
+                continue;
+            }
+
+            pix = MaterializeTile(t);
+            for(y = y0; y < y1; y++){
+                memset(&pix[y * FB_TILE_SIZE + x0], index, x1 - x0);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : FB_Flush
+ * Description    : Sends every dirty tile to GRAM
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Caller must own the screen
+ *******************************************************************************/
+void FB_Flush()
+{
+    uint16_t word, bit;
+    uint32_t pending;
+
+    for(word = 0; word < sizeof(dirty) / sizeof(dirty[0]); word++){
+        pending = dirty[word];
+        for(bit = 0; pending; bit++, pending >>= 1){
+            if(pending & 1){
+                FlushTile((word << 5) + bit);
+            }
+        }
+    }
+}
+
+/************************************  Public Functions  *******************************************/
@@ -0,0 +1,91 @@
+/*
+ * FrameBuffer.h
+ *
+ * Tiled, palette indexed back buffer for a fixed region of the LCD.
+ * Draws land in RAM and only tiles touched since the last flush are sent to GRAM.
+ */
+
+#ifndef FRAMEBUFFER_H_
+#define FRAMEBUFFER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "LCDLib.h"
+
+/************************************ Defines *******************************************/
+
+/* Size of the buffered region (the game arena) */
+#define FB_WIDTH            240
+#define FB_HEIGHT           240
+
+/* Tile geometry */
+#define FB_TILE_SIZE        16
+#define FB_TILE_PIXELS      (FB_TILE_SIZE * FB_TILE_SIZE)
+#define FB_TILES_X          (FB_WIDTH / FB_TILE_SIZE)
+#define FB_TILES_Y          (FB_HEIGHT / FB_TILE_SIZE)
+#define FB_NUM_TILES        (FB_TILES_X * FB_TILES_Y)
+
+/* Number of tiles that can hold per-pixel data at once (FB_TILE_PIXELS bytes each) */
+#define FB_CACHED_TILES     24
+
+/* Palette details, the last index marks pixels the buffer does not own */
+#define FB_PALETTE_SIZE     255
+#define FB_TRANSPARENT      0xFF
+
+/************************************ Defines *******************************************/
+
+/************************************ Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : FB_Init
+ * Description    : Resets the palette and ties the buffer to a screen location
+ * Input          : xOrigin, yOrigin: top left corner of the buffered region
+ * Output         : None
+ * Return         : None
+ * Attention      : GRAM is taken as the initial contents, nothing is redrawn
+ *******************************************************************************/
+void FB_Init(int16_t xOrigin, int16_t yOrigin);
+
+/*******************************************************************************
+ * Function Name  : FB_Invalidate
+ * Description    : Drops every cached and pending tile
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Call after drawing over the region directly with LCDLib
+ *******************************************************************************/
+void FB_Invalidate();
+
+/*******************************************************************************
+ * Function Name  : FB_ColorIndex
+ * Description    : Looks up (or adds) an RGB565 color in the palette
+ * Input          : Color: RGB565 color
+ * Output         : None
+ * Return         : Palette index of the color
+ * Attention      : Falls back to index 0 once the palette is full
+ *******************************************************************************/
+uint8_t FB_ColorIndex(uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : FB_DrawRectangle
+ * Description    : Draw a rectangle as the specified color into the back buffer
+ * Input          : xStart, xEnd, yStart, yEnd, Color (screen coordinates)
+ * Output         : None
+ * Return         : None
+ * Attention      : Same coordinates as LCD_DrawRectangle, clipped to the region
+ *******************************************************************************/
+void FB_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : FB_Flush
+ * Description    : Sends every dirty tile to GRAM
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Caller must own the screen
+ *******************************************************************************/
+void FB_Flush();
+
+/************************************ Public Functions  *******************************************/
+
+#endif /* FRAMEBUFFER_H_ */
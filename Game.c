@@ -8,9 +8,16 @@
 #include <time.h>
 #include <cc3100_usage.h>
 #include "Game.h"
+#include "NetGame.h"
+#include "Input.h"
+#include "Interpolation.h"
+#include "RLEImage.h"
+
+/* Win screens, see tools/win_screens.py */
+extern const RLEImage_t winScreenBlue;
+extern const RLEImage_t winScreenRed;
 
 semaphore_t *screen_s;
-semaphore_t *wifi_s;
 
 char button_flag;
 uint8_t host_score;
@@ -24,6 +31,35 @@ PrevBall_t previous_loc[MAX_NUM_OF_BALLS];
 uint8_t CurrentNumberOfBalls;
 uint32_t threadId_table[10];
 
+/* Set once a peer running another protocol version has been reported */
+static bool versionMismatch;
+
+/* Lent to the CC3100 driver, received datagrams are read in place */
+static RxPacket_t rxPackets[RX_RING_SIZE];
+
+/*
+ * Hands a received datagram to the network, a peer on another protocol version is reported on screen
+ */
+static void ReadPacket(RxPacket_t *rx){
+    if(NetGame_ReadPacket(rx->from, rx->data, rx->length, SystemTime) == NET_ERR_VERSION && !versionMismatch){
+        versionMismatch = true;
+        G8RTOS_WaitSemaphore(screen_s);
+        LCD_Text(MIN_SCREEN_X + 4, MIN_SCREEN_Y + 4, "PROTOCOL VERSION MISMATCH", LCD_RED);
+        G8RTOS_SignalSemaphore(screen_s);
+    }
+    ReleasePacket(rx);
+}
+
+/*
+ * Passes CC3100 send failures to the session of the peer, runs in the SimpleLink spawn thread
+ * Received datagrams already come through the RX ring, so SOCKET_RX_READY is not used
+ */
+static void SocketEvent(SocketEvent_e event, _u32 IP, _i16 value){
+    (void)value;
+    if(event == SOCKET_TX_FAILED && IP){
+        NetGame_SendFailed(IP);
+    }
+}
 
 
 void Button_isr(){
@@ -60,7 +96,6 @@ void Startup(){
     P2OUT &= ~(BLUE_LED | RED_LED);
 
     G8RTOS_InitSemaphore(screen_s, 1);
-    G8RTOS_InitSemaphore(wifi_s, 1);
 
     //Create the startup screen
     G8RTOS_WaitSemaphore(screen_s);
@@ -157,34 +192,26 @@ void CreateGame(){
     client_score = 0;
 
     LCD_Text(80, 150, "Connecting...", LCD_CYAN);
+    lendRxRing(rxPackets, RX_RING_SIZE);
     initCC3100(Host);
 
-    uint8_t ack = 0;
-    uint8_t initdata[4];
-    while(ack != 37){
-        ReceiveData(&ack, 1);
-    }
-
-    ReceiveData(&initdata, 4);
-
-    uint32_t client_ip = initdata[0] << 24 | initdata[1] << 16 | initdata[2] << 8 | initdata[3];
+    RxPacket_t *rx;
 
-    self.IP_address = client_ip;
+    NetGame_Init(Host, &game, &self);
+    registerSocketEventHandler(SocketEvent);
+    NetGame_HostOpen();
 
-    ack = 44;
-    SendData(&ack, client_ip, 1);
-
-    while(ack != 0xFF){
-        ReceiveData(&ack, 1);
+    //Take join requests and answer them until enough clients are ready
+    //The reliable channels resend every step, so a lost datagram only costs time
+    while(NetGame_HostJoinStep(SystemTime) < NUM_OF_PLAYERS_PLAYING - 1){
+        sleep(NETGAME_JOIN_STEP_MS);
+        while((rx = ReceivePacketNonBlocking())){
+            ReadPacket(rx);
+        }
     }
 
-    game.players[0].color = PLAYER_RED;
-    game.players[0].currentCenter = PADDLE_X_CENTER;
-    game.players[0].position = BOTTOM;
-
-    game.players[1].color = PLAYER_BLUE;
-    game.players[1].currentCenter = PADDLE_X_CENTER;
-    game.players[1].position = TOP;
+    //Clients that never got ready do not play
+    NetGame_HostStart();
 
     game.LEDScores[0] = 0;
     game.LEDScores[1] = 0;
@@ -202,6 +229,7 @@ void CreateGame(){
     G8RTOS_AddThread(GenerateBall, 1, "makes balls");
     G8RTOS_AddThread(MoveLEDs, 2, "Update leds");
     G8RTOS_AddThread(EndOfGameHost, 0, "end of game handler");
+    G8RTOS_AddThread(SampleTelemetry, TELEMETRY_THREAD_PRIORITY, "telemetry");
 
     //kill self
     G8RTOS_KillSelf();
@@ -209,42 +237,32 @@ void CreateGame(){
 
 
 /*
- * Thread that sends game state to client
+ * Thread that sends game state to the clients
+ * Runs at the fastest send rate, each client gets a snapshot when its rate controller allows
  */
 void SendDataToClient(){
     threadId_table[0] = G8RTOS_GetThreadId();
+
     while(1){
-        G8RTOS_WaitSemaphore(wifi_s);
-        SendData(&game, self.IP_address, sizeof(game));
-        G8RTOS_SignalSemaphore(wifi_s);
-        sleep(20);
+        NetGame_HostTick(SystemTime);
+        sleep(RATE_MIN_PERIOD_MS);
     }
 }
 
 
 /*
- * Thread that receives UDP packets from client
+ * Thread that receives UDP packets from the clients
  */
 void ReceiveDataFromClient(){
     threadId_table[1] = G8RTOS_GetThreadId();
+    RxPacket_t *rx;
 
     while(1){
 
-        G8RTOS_WaitSemaphore(wifi_s);
-        ReceiveData(&self,sizeof(self));
-        G8RTOS_SignalSemaphore(wifi_s);
-
-
-        if(game.players[1].currentCenter + self.displacement > ARENA_MIN_X + PADDLE_LEN_D2 &&
-                        game.players[1].currentCenter + self.displacement < ARENA_MAX_X - PADDLE_LEN_D2){
-                    game.players[1].currentCenter += self.displacement;
-                }
-
-
-        sleep(20);
+        //Blocks until the RX thread has a datagram for us, read in place in the RX ring
+        rx = ReceivePacket();
+        ReadPacket(rx);
     }
-
-
 }
 
 
@@ -314,7 +332,7 @@ void MoveBall(){
     game.balls[num].threadId = G8RTOS_GetThreadId();
     CurrentNumberOfBalls++;
 
-    int32_t w, h, dx, dy, wy, hx;
+    int32_t w, h, dx, dy;
     int8_t check_hit;
 
     while(1){
@@ -334,44 +352,30 @@ void MoveBall(){
         }
 
         //did we hit a paddle
-        for(int i = 0; i < 2; i++){
+        for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+            if(game.players[i].currentCenter == PLAYER_ABSENT){
+                continue;
+            }
             w = 0.5 * (BALL_SIZE+1 + PADDLE_LEN+1);
             h = 0.5 * (BALL_SIZE+1 + PADDLE_WID+1);
             dx = game.balls[num].currentCenterX - game.players[i].currentCenter;
-            if(i == 0){
-                dy = game.balls[num].currentCenterY - BOTTOM_PLAYER_CENTER_Y;
-            } else {
-                dy = game.balls[num].currentCenterY - TOP_PLAYER_CENTER_Y;
-            }
+            dy = game.balls[num].currentCenterY - PLAYER_CENTER_Y(i);
             if (abs(dx) <= w && abs(dy) <= h){/* collision! */
                 check_hit = 1;
-                wy = w * dy;
-                hx = h * dx;
-                if (wy > hx){
-                   /* collision at the top of A */
-                    game.balls[num].velocityY *= -1;
-                    game.balls[num].color = LCD_BLUE;
-                    //check which side of paddle was hit
-                    if(dx < -10){
-                        game.balls[num].velocityX = -2;
-                    } else if(dx > 10){
-                        game.balls[num].velocityX = 2;
-                    } else {
-                        game.balls[num].velocityX = 0;
-                    }
-
-                }else{
-                    /* the bottom of A was hit */
-                    game.balls[num].velocityY *= -1;
-                    game.balls[num].color = LCD_RED;
-                    //check which side of paddle was hit
-                    if(dx < -10){
-                        game.balls[num].velocityX = -2;
-                    } else if(dx > 10){
-                        game.balls[num].velocityX = 2;
-                    } else {
-                        game.balls[num].velocityX = 0;
-                    }
+                //Send the ball toward the other team's goal in the color of the team that hit it
+                if(PLAYER_TEAM(i) == BOTTOM){
+                    game.balls[num].velocityY = -abs(game.balls[num].velocityY);
+                } else {
+                    game.balls[num].velocityY = abs(game.balls[num].velocityY);
+                }
+                game.balls[num].color = game.players[i].color;
+                //check which side of paddle was hit
+                if(dx < -10){
+                    game.balls[num].velocityX = -2;
+                } else if(dx > 10){
+                    game.balls[num].velocityX = 2;
+                } else {
+                    game.balls[num].velocityX = 0;
                 }
                 break;
             }
@@ -383,6 +387,7 @@ void MoveBall(){
                 game.balls[num].velocityY *= -1;
                 if(game.balls[num].color != LCD_WHITE){
                     game.LEDScores[1]++;
+                    NetGame_BroadcastLatest(NET_EVT_SCORE, game.LEDScores, 2);
                 }
                 KillBall(&(game.balls[num]));
                 CurrentNumberOfBalls--;
@@ -391,6 +396,7 @@ void MoveBall(){
                 game.balls[num].velocityY *= -1;
                 if(game.balls[num].color != LCD_WHITE){
                     game.LEDScores[0]++;
+                    NetGame_BroadcastLatest(NET_EVT_SCORE, game.LEDScores, 2);
                 }
                 KillBall(&(game.balls[num]));
                 CurrentNumberOfBalls--;
@@ -412,19 +418,37 @@ void MoveBall(){
  * End of game for the host
  */
 void EndOfGameHost(){
+    uint8_t result[3];
+    bool queued;
     while(1){
         if(game.gameDone){
+            //Make sure the clients hear the result before the network threads go away
+            result[0] = game.winner;
+            result[1] = game.overallScores[0];
+            result[2] = game.overallScores[1];
+            //A window full of unacked scores makes the event wait for room, not get lost
+            queued = false;
+            for(int i = 0; i < GAME_OVER_FLUSH_MS / 20; i++){
+                if(!queued){
+                    queued = NetGame_Broadcast(NET_EVT_GAME_OVER, result, sizeof(result));
+                }
+                if(queued && NetGame_EventsDelivered()){
+                    break;
+                }
+                sleep(20);
+            }
+
             if(game.winner){
                 G8RTOS_WaitSemaphore(screen_s);
-                LCD_DrawRectangle(0, MAX_SCREEN_X, 0, MAX_SCREEN_Y, LCD_BLUE);
-                LCD_Text(130, 110, "BLUE WINS", LCD_BLACK);
+                FB_Invalidate();
+                RLE_DrawImage(0, 0, &winScreenBlue);
                 G8RTOS_SignalSemaphore(screen_s);
                 LP3943_LedModeSet(RED, 0);
                 G8RTOS_KillThread(threadId_table[0]);
                 G8RTOS_KillThread(threadId_table[1]);
                 G8RTOS_KillThread(threadId_table[2]);
                 G8RTOS_KillThread(threadId_table[3]);
-
+                G8RTOS_KillThread(threadId_table[4]);
                 G8RTOS_KillThread(threadId_table[5]);
                 G8RTOS_KillThread(threadId_table[6]);
 
@@ -441,15 +465,15 @@ void EndOfGameHost(){
             }
             else {
                 G8RTOS_WaitSemaphore(screen_s);
-                LCD_DrawRectangle(0, MAX_SCREEN_X, 0, MAX_SCREEN_Y, LCD_RED);
-                LCD_Text(130, 110, "RED WINS", LCD_BLACK);
+                FB_Invalidate();
+                RLE_DrawImage(0, 0, &winScreenRed);
                 G8RTOS_SignalSemaphore(screen_s);
                 LP3943_LedModeSet(BLUE, 0);
                 G8RTOS_KillThread(threadId_table[0]);
                 G8RTOS_KillThread(threadId_table[1]);
                 G8RTOS_KillThread(threadId_table[2]);
                 G8RTOS_KillThread(threadId_table[3]);
-
+                G8RTOS_KillThread(threadId_table[4]);
                 G8RTOS_KillThread(threadId_table[5]);
                 G8RTOS_KillThread(threadId_table[6]);
 
@@ -487,30 +511,23 @@ void EndOfGameHost(){
  */
 void JoinGame(){
     LCD_Text(80, 150, "Connecting...", LCD_CYAN);
+    lendRxRing(rxPackets, RX_RING_SIZE);
     initCC3100(Client);
 
-    self.IP_address = getLocalIP();
-    self.acknowledge = 0;
-    self.displacement = 0;
-    self.joined = 0;
-    self.playerNumber = TOP;
-    self.ready = 0;
+    RxPacket_t *rx;
 
-    uint8_t start_send[5] = {37, (self.IP_address>>24)&0xff, (self.IP_address>>16)&0xff, (self.IP_address>>8)&0xff, (self.IP_address)&0xff};
-    uint8_t ack = 0;
+    NetGame_Init(Client, &game, &self);
+    registerSocketEventHandler(SocketEvent);
+    NetGame_ClientOpen(HOST_IP_ADDR, getLocalIP(), SystemTime);
 
-
-    while(ack != 44){
-        ReceiveData(&ack, 1);
-        SendData(start_send, HOST_IP_ADDR, 5);
-        sleep(50);
+    //Keep asking until the host accepts and hands us a paddle, the ready event then goes out with the game traffic
+    while(!NetGame_ClientJoinStep(SystemTime)){
+        sleep(NETGAME_JOIN_STEP_MS);
+        while((rx = ReceivePacketNonBlocking())){
+            ReadPacket(rx);
+        }
     }
-
-    ack = 0xFF;
-
-    SendData(&ack, HOST_IP_ADDR, 1);
-
-    sleep(10);
+    NetGame_ClientReady(SystemTime);
 
     LCD_Text(190, 150, "Done!", LCD_CYAN);
     P2OUT |= BLUE_LED;
@@ -518,13 +535,14 @@ void JoinGame(){
     host_score = 0;
     client_score = 0;
 
-    game.players[0].color = PLAYER_RED;
-    game.players[0].currentCenter = PADDLE_X_CENTER;
-    game.players[0].position = BOTTOM;
-
-    game.players[1].color = PLAYER_BLUE;
-    game.players[1].currentCenter = PADDLE_X_CENTER;
-    game.players[1].position = TOP;
+    //Other clients' paddles show up with the first snapshot
+    for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        NetGame_InitPlayer(i);
+        if(i != 0 && i != self.playerNumber){
+            game.players[i].currentCenter = PLAYER_ABSENT;
+        }
+    }
+    this_player.color = game.players[self.playerNumber].color;
     //create the initial board
     InitBoardState();
 
@@ -534,29 +552,56 @@ void JoinGame(){
     G8RTOS_AddThread(ReceiveDataFromHost, 1, "receive data");
     G8RTOS_AddThread(MoveLEDs, 2, "Update leds");
     G8RTOS_AddThread(EndOfGameClient, 0, "end of game handler");
+    G8RTOS_AddThread(SampleTelemetry, TELEMETRY_THREAD_PRIORITY, "telemetry");
 
     //kill self
     G8RTOS_KillSelf();
 
 }
 
+/*
+ * Client: draws the balls from the jitter buffer instead of the newest snapshot
+ */
+static void DrawClientBalls(){
+    static bool shown[MAX_NUM_OF_BALLS];
+    Ball_t balls[MAX_NUM_OF_BALLS];
+
+    if(!Interp_Sample(SystemTime, balls)){
+        return;
+    }
+
+    for(int i = 0; i < MAX_NUM_OF_BALLS; i++){
+        if(balls[i].alive){
+            if(shown[i]){
+                UpdateBallOnScreen(&previous_loc[i], &balls[i], LCD_BLACK);
+            } else {
+                G8RTOS_WaitSemaphore(screen_s);
+                FB_DrawRectangle(balls[i].currentCenterX-BALL_SIZE_D2, balls[i].currentCenterX+BALL_SIZE_D2,
+                                  balls[i].currentCenterY-BALL_SIZE_D2, balls[i].currentCenterY+BALL_SIZE_D2, balls[i].color);
+                G8RTOS_SignalSemaphore(screen_s);
+            }
+            previous_loc[i].CenterX = balls[i].currentCenterX;
+            previous_loc[i].CenterY = balls[i].currentCenterY;
+        } else if(shown[i]){
+            G8RTOS_WaitSemaphore(screen_s);
+            FB_DrawRectangle(previous_loc[i].CenterX-BALL_SIZE_D2, previous_loc[i].CenterX+BALL_SIZE_D2,
+                              previous_loc[i].CenterY-BALL_SIZE_D2, previous_loc[i].CenterY+BALL_SIZE_D2, LCD_BLACK);
+            G8RTOS_SignalSemaphore(screen_s);
+        }
+        shown[i] = balls[i].alive;
+    }
+}
+
 /*
  * Thread that receives game state packets from host
  */
 void ReceiveDataFromHost(){
     threadId_table[0] = G8RTOS_GetThreadId();
+    RxPacket_t *rx;
 
     while(1){
-        for(int i = 0; i < MAX_NUM_OF_BALLS; i++){
-            previous_loc[i].CenterX = game.balls[i].currentCenterX;
-            previous_loc[i].CenterY = game.balls[i].currentCenterY;
-        }
-        G8RTOS_WaitSemaphore(wifi_s);
-        ReceiveData(&game, sizeof(game));
-        G8RTOS_SignalSemaphore(wifi_s);
-
-
-        sleep(20);
+        rx = ReceivePacket();
+        ReadPacket(rx);
     }
 
 }
@@ -568,10 +613,7 @@ void SendDataToHost(){
     threadId_table[1] = G8RTOS_GetThreadId();
 
     while(1){
-        G8RTOS_WaitSemaphore(wifi_s);
-        SendData(&self, HOST_IP_ADDR, sizeof(self));
-        G8RTOS_SignalSemaphore(wifi_s);
-        sleep(20);
+        sleep(NetGame_ClientTick(SystemTime));
     }
 
 }
@@ -592,11 +634,9 @@ void ReadJoystickClient(){
         } else {
             self.displacement = 0;
         }
-        if(game.players[1].currentCenter + self.displacement > ARENA_MIN_X + PADDLE_LEN_D2 &&
-                game.players[1].currentCenter + self.displacement < ARENA_MAX_X - PADDLE_LEN_D2){
-            game.players[1].currentCenter += self.displacement;
-        }
-        sleep(20);
+
+        NetGame_ClientMove(self.displacement);
+        sleep(INPUT_PERIOD_MS);
     }
 
 }
@@ -610,16 +650,19 @@ void EndOfGameClient(){
             //sleep(100);
             if(game.winner){
                 G8RTOS_WaitSemaphore(screen_s);
-                LCD_DrawRectangle(0, MAX_SCREEN_X, 0, MAX_SCREEN_Y, LCD_BLUE);
-                LCD_Text(130, 110, "BLUE WINS", LCD_BLACK);
+                FB_Invalidate();
+                RLE_DrawImage(0, 0, &winScreenBlue);
                 G8RTOS_SignalSemaphore(screen_s);
                 LP3943_LedModeSet(RED, 0);
 
-                G8RTOS_KillThread(threadId_table[0]);
-                G8RTOS_KillThread(threadId_table[1]);
                 G8RTOS_KillThread(threadId_table[2]);
+                G8RTOS_KillThread(threadId_table[4]);
                 G8RTOS_KillThread(threadId_table[5]);
                 G8RTOS_KillThread(threadId_table[6]);
+                //The ack may be lost, keep receiving and acking while the host flushes the game over
+                sleep(GAME_OVER_FLUSH_MS);
+                G8RTOS_KillThread(threadId_table[0]);
+                G8RTOS_KillThread(threadId_table[1]);
                 while(1){
                     LP3943_LedModeSet(BLUE, 0xffff);
                     sleep(250);
@@ -628,16 +671,19 @@ void EndOfGameClient(){
                 }
             } else {
                 G8RTOS_WaitSemaphore(screen_s);
-                LCD_DrawRectangle(0, MAX_SCREEN_X, 0, MAX_SCREEN_Y, LCD_RED);
-                LCD_Text(130, 110, "RED WINS", LCD_BLACK);
+                FB_Invalidate();
+                RLE_DrawImage(0, 0, &winScreenRed);
                 G8RTOS_SignalSemaphore(screen_s);
                 LP3943_LedModeSet(BLUE, 0);
 
-                G8RTOS_KillThread(threadId_table[0]);
-                G8RTOS_KillThread(threadId_table[1]);
                 G8RTOS_KillThread(threadId_table[2]);
+                G8RTOS_KillThread(threadId_table[4]);
                 G8RTOS_KillThread(threadId_table[5]);
                 G8RTOS_KillThread(threadId_table[6]);
+                //The ack may be lost, keep receiving and acking while the host flushes the game over
+                sleep(GAME_OVER_FLUSH_MS);
+                G8RTOS_KillThread(threadId_table[0]);
+                G8RTOS_KillThread(threadId_table[1]);
                 while(1){
                     LP3943_LedModeSet(RED, 0xffff);
                     sleep(250);
@@ -672,22 +718,32 @@ void IdleThread(){
  */
 void DrawObjects(){
     threadId_table[5] = G8RTOS_GetThreadId();
-    PrevPlayer_t prev_player_loc, prev_player_loc2;
-
-    prev_player_loc.Center = game.players[0].currentCenter;
-    prev_player_loc2.Center = game.players[1].currentCenter;
-
+    PrevPlayer_t prev_player_loc[MAX_NUM_OF_PLAYERS];
 
+    for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        prev_player_loc[i].Center = game.players[i].currentCenter;
+    }
 
     while(1){
-        UpdatePlayerOnScreen(&prev_player_loc, &(game.players[0]));
-        UpdatePlayerOnScreen(&prev_player_loc2, &(game.players[1]));
-        for(int i = 0; i < MAX_NUM_OF_BALLS; i++){
-            if(game.balls[i].alive){
-                UpdateBallOnScreen(&previous_loc[i], &(game.balls[i]), LCD_BLACK);
+        for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+            UpdatePlayerOnScreen(&prev_player_loc[i], &(game.players[i]));
+        }
+        if(player_type == Client){
+            DrawClientBalls();
+        } else {
+            for(int i = 0; i < MAX_NUM_OF_BALLS; i++){
+                if(game.balls[i].alive){
+                    UpdateBallOnScreen(&previous_loc[i], &(game.balls[i]), LCD_BLACK);
+                }
             }
         }
-        sleep(20);
+
+        //Send only the tiles that changed this frame, starting in the panel's blanking window
+        VSync_WaitForFrame();
+        G8RTOS_WaitSemaphore(screen_s);
+        FB_Flush();
+        G8RTOS_SignalSemaphore(screen_s);
+        VSync_EndFrame();
     }
 }
 
@@ -711,6 +767,23 @@ void MoveLEDs(){
 
 
 
+/*
+ * Thread that samples the link telemetry every TELEMETRY_PERIOD_MS
+ * Runs below the game threads, each sample costs one CC3100 command and one datagram
+ */
+void SampleTelemetry(){
+    threadId_table[4] = G8RTOS_GetThreadId();
+
+    Telemetry_Start();
+    while(1){
+        sleep(TELEMETRY_PERIOD_MS);
+        Telemetry_Sample();
+    }
+}
+
+
+
+
 /**********************************************************************/
 /*                       End of Common threads                        */
 /**********************************************************************/
@@ -726,14 +799,18 @@ void InitBoardState(){
     LCD_DrawRectangle(ARENA_MIN_X, ARENA_MAX_X, ARENA_MIN_Y, ARENA_MAX_Y, LCD_WHITE);
     LCD_DrawRectangle(ARENA_MIN_X+1, ARENA_MAX_X-1, ARENA_MIN_Y, ARENA_MAX_Y, BACK_COLOR);
 
-    DrawPlayer(&(game.players[0]));
-    DrawPlayer(&(game.players[1]));
+    for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        DrawPlayer(&(game.players[i]));
+    }
 
 
     snprintf(str, 10, "%d", host_score);
     LCD_Text(0, 0, str, LCD_BLUE);
     snprintf(str, 10, "%d", client_score);
     LCD_Text(0, 225, str, LCD_RED);
+
+    //Moving objects are drawn through the arena's back buffer from here on
+    FB_Init(ARENA_MIN_X, ARENA_MIN_Y);
     G8RTOS_SignalSemaphore(screen_s);
 
 }
@@ -741,13 +818,11 @@ void InitBoardState(){
 
 void DrawPlayer(GeneralPlayerInfo_t * player){
     //Draw the Paddles
+    int16_t y = PLAYER_CENTER_Y(player - game.players);
 
-    if(player == &(game.players[0])){
-    LCD_DrawRectangle((PADDLE_X_CENTER)-PADDLE_LEN_D2, (PADDLE_X_CENTER)+PADDLE_LEN_D2,
-                      TOP_PLAYER_CENTER_Y-PADDLE_WID_D2, TOP_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_BLUE);
-    } else {
-    LCD_DrawRectangle((PADDLE_X_CENTER)-PADDLE_LEN_D2, (PADDLE_X_CENTER)+PADDLE_LEN_D2,
-                      BOTTOM_PLAYER_CENTER_Y-PADDLE_WID_D2, BOTTOM_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_RED);
+    if(player->currentCenter != PLAYER_ABSENT){
+    LCD_DrawRectangle(player->currentCenter-PADDLE_LEN_D2, player->currentCenter+PADDLE_LEN_D2,
+                      y-PADDLE_WID_D2, y+PADDLE_WID_D2, player->color);
     }
 
 }
@@ -755,6 +830,7 @@ void DrawPlayer(GeneralPlayerInfo_t * player){
 
 void UpdatePlayerOnScreen(PrevPlayer_t * prevPlayerIn, GeneralPlayerInfo_t * outPlayer){
     int16_t distance =  outPlayer->currentCenter - prevPlayerIn->Center;
+    int16_t y = PLAYER_CENTER_Y(outPlayer - game.players);
 
     if(distance == 0){
         return;
@@ -762,30 +838,25 @@ void UpdatePlayerOnScreen(PrevPlayer_t * prevPlayerIn, GeneralPlayerInfo_t * out
 
     G8RTOS_WaitSemaphore(screen_s);
 
-    if(outPlayer == &(game.players[0])){
-        if(distance > 0){
-            LCD_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2, prevPlayerIn->Center + PADDLE_LEN_D2 + distance,
-                              BOTTOM_PLAYER_CENTER_Y-PADDLE_WID_D2, BOTTOM_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_RED);
-            LCD_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2, prevPlayerIn->Center - PADDLE_LEN_D2 + distance,
-                              BOTTOM_PLAYER_CENTER_Y-PADDLE_WID_D2, BOTTOM_PLAYER_CENTER_Y+PADDLE_WID_D2, BACK_COLOR);
+    //Players joining or leaving are drawn or erased whole
+    if(prevPlayerIn->Center == PLAYER_ABSENT || outPlayer->currentCenter == PLAYER_ABSENT){
+        if(prevPlayerIn->Center != PLAYER_ABSENT){
+            FB_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2, prevPlayerIn->Center + PADDLE_LEN_D2,
+                              y-PADDLE_WID_D2, y+PADDLE_WID_D2, BACK_COLOR);
         } else {
-            LCD_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2 + distance, prevPlayerIn->Center - PADDLE_LEN_D2,
-                              BOTTOM_PLAYER_CENTER_Y-PADDLE_WID_D2, BOTTOM_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_RED);
-            LCD_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2 + distance, prevPlayerIn->Center + PADDLE_LEN_D2,
-                              BOTTOM_PLAYER_CENTER_Y-PADDLE_WID_D2, BOTTOM_PLAYER_CENTER_Y+PADDLE_WID_D2, BACK_COLOR);
+            FB_DrawRectangle(outPlayer->currentCenter - PADDLE_LEN_D2, outPlayer->currentCenter + PADDLE_LEN_D2,
+                              y-PADDLE_WID_D2, y+PADDLE_WID_D2, outPlayer->color);
         }
+    } else if(distance > 0){
+        FB_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2, prevPlayerIn->Center + PADDLE_LEN_D2 + distance,
+                          y-PADDLE_WID_D2, y+PADDLE_WID_D2, outPlayer->color);
+        FB_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2, prevPlayerIn->Center - PADDLE_LEN_D2 + distance,
+                          y-PADDLE_WID_D2, y+PADDLE_WID_D2, BACK_COLOR);
     } else {
-        if(distance > 0){
-            LCD_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2, prevPlayerIn->Center + PADDLE_LEN_D2 + distance,
-                              TOP_PLAYER_CENTER_Y-PADDLE_WID_D2, TOP_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_BLUE);
-            LCD_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2, prevPlayerIn->Center - PADDLE_LEN_D2 + distance,
-                              TOP_PLAYER_CENTER_Y-PADDLE_WID_D2, TOP_PLAYER_CENTER_Y+PADDLE_WID_D2, BACK_COLOR);
-        } else {
-            LCD_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2 + distance, prevPlayerIn->Center - PADDLE_LEN_D2,
-                              TOP_PLAYER_CENTER_Y-PADDLE_WID_D2, TOP_PLAYER_CENTER_Y+PADDLE_WID_D2, PLAYER_BLUE);
-            LCD_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2 + distance, prevPlayerIn->Center + PADDLE_LEN_D2,
-                              TOP_PLAYER_CENTER_Y-PADDLE_WID_D2, TOP_PLAYER_CENTER_Y+PADDLE_WID_D2, BACK_COLOR);
-        }
+        FB_DrawRectangle(prevPlayerIn->Center - PADDLE_LEN_D2 + distance, prevPlayerIn->Center - PADDLE_LEN_D2,
+                          y-PADDLE_WID_D2, y+PADDLE_WID_D2, outPlayer->color);
+        FB_DrawRectangle(prevPlayerIn->Center + PADDLE_LEN_D2 + distance, prevPlayerIn->Center + PADDLE_LEN_D2,
+                          y-PADDLE_WID_D2, y+PADDLE_WID_D2, BACK_COLOR);
     }
 
     G8RTOS_SignalSemaphore(screen_s);
@@ -803,9 +874,9 @@ void UpdateBallOnScreen(PrevBall_t * previousBall, Ball_t * currentBall, uint16_
     }
 
     G8RTOS_WaitSemaphore(screen_s);
-    LCD_DrawRectangle(previousBall->CenterX-BALL_SIZE_D2, previousBall->CenterX+BALL_SIZE_D2,
+    FB_DrawRectangle(previousBall->CenterX-BALL_SIZE_D2, previousBall->CenterX+BALL_SIZE_D2,
                       previousBall->CenterY-BALL_SIZE_D2, previousBall->CenterY+BALL_SIZE_D2, LCD_BLACK);
-    LCD_DrawRectangle(currentBall->currentCenterX-BALL_SIZE_D2, currentBall->currentCenterX+BALL_SIZE_D2,
+    FB_DrawRectangle(currentBall->currentCenterX-BALL_SIZE_D2, currentBall->currentCenterX+BALL_SIZE_D2,
                       currentBall->currentCenterY-BALL_SIZE_D2, currentBall->currentCenterY+BALL_SIZE_D2, currentBall->color);
     G8RTOS_SignalSemaphore(screen_s);
 
@@ -815,7 +886,7 @@ void UpdateBallOnScreen(PrevBall_t * previousBall, Ball_t * currentBall, uint16_
 void KillBall(Ball_t * currentBall){
     currentBall->alive = 0;
     G8RTOS_WaitSemaphore(screen_s);
-    LCD_DrawRectangle(currentBall->currentCenterX-BALL_SIZE_D2, currentBall->currentCenterX+BALL_SIZE_D2,
+    FB_DrawRectangle(currentBall->currentCenterX-BALL_SIZE_D2, currentBall->currentCenterX+BALL_SIZE_D2,
                       currentBall->currentCenterY-BALL_SIZE_D2, currentBall->currentCenterY+BALL_SIZE_D2, LCD_BLACK);
     G8RTOS_SignalSemaphore(screen_s);
     G8RTOS_KillThread(currentBall->threadId);
@@ -14,6 +14,10 @@
 #include "G8RTOS.h"
 #include "cc3100_usage.h"
 #include "LCDLib.h"
+#include "GameTypes.h"
+#include "FrameBuffer.h"
+#include "VSync.h"
+#include "Telemetry.h"
 /*********************************************** Includes ********************************************************************/
 
 /*********************************************** Externs ********************************************************************/
@@ -23,64 +27,14 @@ extern semaphore_t *screen_s;
 
 /*********************************************** Externs ********************************************************************/
 
-/*********************************************** Global Defines ********************************************************************/
-#define MAX_NUM_OF_PLAYERS  2
-#define MAX_NUM_OF_BALLS    8
-
-// This game can actually be played with 4 players... a little bit more challenging, but doable! 
-#define NUM_OF_PLAYERS_PLAYING 2
-
-/* Size of game arena */
-#define ARENA_MIN_X                  40
-#define ARENA_MAX_X                  280
-#define ARENA_MIN_Y                  0
-#define ARENA_MAX_Y                  240
-
-/* Size of objects */
-#define PADDLE_LEN                   64
-#define PADDLE_LEN_D2                (PADDLE_LEN >> 1)
-#define PADDLE_WID                   4
-#define PADDLE_WID_D2                (PADDLE_WID >> 1)
-#define BALL_SIZE                    4
-#define BALL_SIZE_D2                 (BALL_SIZE >> 1)
-
-/* Centers for paddles at the center of the sides */
-#define PADDLE_X_CENTER              MAX_SCREEN_X >> 1
-
-/* Edge limitations for player's center coordinate */
-#define HORIZ_CENTER_MAX_PL          (ARENA_MAX_X - PADDLE_LEN_D2)
-#define HORIZ_CENTER_MIN_PL          (ARENA_MIN_X + PADDLE_LEN_D2)
-
-/* Constant enters of each player */
-#define TOP_PLAYER_CENTER_Y          (ARENA_MIN_Y + PADDLE_WID_D2)
-#define BOTTOM_PLAYER_CENTER_Y       (ARENA_MAX_Y - PADDLE_WID_D2)
-
-/* Edge coordinates for paddles */
-#define TOP_PADDLE_EDGE              (ARENA_MIN_Y + PADDLE_WID)
-#define BOTTOM_PADDLE_EDGE           (ARENA_MAX_Y - PADDLE_WID)
-
-/* Amount of allowable space for collisions with the sides of paddles */
-#define WIGGLE_ROOM                  2
-
-/* Value for velocities from contact with paddles */
-#define _1_3_PADDLE                  11
-
-/* Defines for Minkowski Alg. for collision */
-#define WIDTH_TOP_OR_BOTTOM          ((PADDLE_LEN + BALL_SIZE) >> 1) + WIGGLE_ROOM
-#define HEIGHT_TOP_OR_BOTTOM         ((PADDLE_WID + BALL_SIZE) >> 1) + WIGGLE_ROOM
-
-/* Edge limitations for ball's center coordinate */
-#define HORIZ_CENTER_MAX_BALL        (ARENA_MAX_X - BALL_SIZE_D2)
-#define HORIZ_CENTER_MIN_BALL        (ARENA_MIN_X + BALL_SIZE_D2)
-#define VERT_CENTER_MAX_BALL         (ARENA_MAX_Y - BALL_SIZE_D2)
-#define VERT_CENTER_MIN_BALL         (ARENA_MIN_Y + BALL_SIZE_D2)
-
-/* Maximum ball speed */
-#define MAX_BALL_SPEED               6
 
+/*********************************************** Global Defines ********************************************************************/
 /* Background color - Black */
 #define BACK_COLOR                   LCD_BLACK
 
+/* Longest the host waits for the client to acknowledge the game over event, ms */
+#define GAME_OVER_FLUSH_MS          2000
+
 /* Offset for printing player to avoid blips from left behind ball */
 #define PRINT_OFFSET                10
 
@@ -95,90 +49,8 @@ typedef enum
     PLAYER_BLUE = LCD_BLUE
 }playerColor;
 
-/* Enums for player numbers */
-typedef enum
-{
-    BOTTOM = 0,
-    TOP = 1
-}playerPosition;
-
 /*********************************************** Global Defines ********************************************************************/
 
-/*********************************************** Data Structures ********************************************************************/
-/*********************************************** Data Structures ********************************************************************/
-#pragma pack ( push, 1)
-/*
- * Struct to be sent from the client to the host
- */
-typedef struct
-{
-    uint32_t IP_address;
-    int16_t displacement;
-    uint8_t playerNumber;
-    bool ready;
-    bool joined;
-    bool acknowledge;
-} SpecificPlayerInfo_t;
-
-/*
- * General player info to be used by both host and client
- * Client responsible for translation
- */
-typedef struct
-{
-    int16_t currentCenter;
-    uint16_t color;
-    playerPosition position;
-} GeneralPlayerInfo_t;
-
-/*
- * Struct of all the balls, only changed by the host
- */
-typedef struct
-{
-    int16_t currentCenterX;
-    int16_t currentCenterY;
-    int16_t velocityX;
-    int16_t velocityY;
-    uint16_t color;
-    uint32_t threadId;
-    bool alive;
-} Ball_t;
-
-/*
- * Struct to be sent from the host to the client
- */
-typedef struct
-{
-    SpecificPlayerInfo_t player;
-    GeneralPlayerInfo_t players[MAX_NUM_OF_PLAYERS];
-    Ball_t balls[MAX_NUM_OF_BALLS];
-    uint16_t numberOfBalls;
-    bool winner;
-    bool gameDone;
-    uint8_t LEDScores[2];
-    uint8_t overallScores[2];
-} GameState_t;
-#pragma pack ( pop )
-
-/*
- * Struct of all the previous ball locations, only changed by self for drawing!
- */
-typedef struct
-{
-    int16_t CenterX;
-    int16_t CenterY;
-}PrevBall_t;
-
-/*
- * Struct of all the previous players locations, only changed by self for drawing
- */
-typedef struct
-{
-    int16_t Center;
-}PrevPlayer_t;
-/*********************************************** Data Structures ********************************************************************/
-
 
 /*********************************************** Client Threads *********************************************************************/
 /*
@@ -264,6 +136,11 @@ void DrawObjects();
  */
 void MoveLEDs();
 
+/*
+ * Thread that samples the link telemetry every TELEMETRY_PERIOD_MS
+ */
+void SampleTelemetry();
+
 //ISR for button to start the game
 void Button_isr();
 
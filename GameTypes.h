@@ -0,0 +1,171 @@
+/*
+ * GameTypes.h
+ *
+ * Game constants and the state shared by host and client.
+ * Only depends on the C library, so the protocol modules built on it
+ * (NetProtocol, Snapshot, Input, Interpolation, Reliable, Session) also build off target.
+ */
+
+#ifndef GAMETYPES_H_
+#define GAMETYPES_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+#define MAX_NUM_OF_PLAYERS  4
+#define MAX_NUM_OF_BALLS    8
+
+// This game can actually be played with 4 players... a little bit more challenging, but doable! 
+// The host starts once NUM_OF_PLAYERS_PLAYING - 1 clients have joined
+#define NUM_OF_PLAYERS_PLAYING 2
+
+/* Size of game arena */
+#define ARENA_MIN_X                  40
+#define ARENA_MAX_X                  280
+#define ARENA_MIN_Y                  0
+#define ARENA_MAX_Y                  240
+
+/* Size of objects */
+#define PADDLE_LEN                   64
+#define PADDLE_LEN_D2                (PADDLE_LEN >> 1)
+#define PADDLE_WID                   4
+#define PADDLE_WID_D2                (PADDLE_WID >> 1)
+#define BALL_SIZE                    4
+#define BALL_SIZE_D2                 (BALL_SIZE >> 1)
+
+/* Centers for paddles at the center of the sides */
+#define PADDLE_X_CENTER              MAX_SCREEN_X >> 1
+
+/* Edge limitations for player's center coordinate */
+#define HORIZ_CENTER_MAX_PL          (ARENA_MAX_X - PADDLE_LEN_D2)
+#define HORIZ_CENTER_MIN_PL          (ARENA_MIN_X + PADDLE_LEN_D2)
+
+/* Constant enters of each player */
+#define TOP_PLAYER_CENTER_Y          (ARENA_MIN_Y + PADDLE_WID_D2)
+#define BOTTOM_PLAYER_CENTER_Y       (ARENA_MAX_Y - PADDLE_WID_D2)
+
+/* Players 2 and 3 play a row in front of their team's goal keeper */
+#define FORWARD_OFFSET               60
+
+/* Team of player i, even players defend the bottom */
+#define PLAYER_TEAM(i)               ((playerPosition)((i) & 1))
+
+/* Row of player i */
+#define PLAYER_CENTER_Y(i)           (PLAYER_TEAM(i) == BOTTOM ? BOTTOM_PLAYER_CENTER_Y - ((i) >> 1) * FORWARD_OFFSET \
+                                                               : TOP_PLAYER_CENTER_Y + ((i) >> 1) * FORWARD_OFFSET)
+
+/* Paddle center of a player nobody controls */
+#define PLAYER_ABSENT                0
+
+/* Edge coordinates for paddles */
+#define TOP_PADDLE_EDGE              (ARENA_MIN_Y + PADDLE_WID)
+#define BOTTOM_PADDLE_EDGE           (ARENA_MAX_Y - PADDLE_WID)
+
+/* Amount of allowable space for collisions with the sides of paddles */
+#define WIGGLE_ROOM                  2
+
+/* Value for velocities from contact with paddles */
+#define _1_3_PADDLE                  11
+
+/* Defines for Minkowski Alg. for collision */
+#define WIDTH_TOP_OR_BOTTOM          ((PADDLE_LEN + BALL_SIZE) >> 1) + WIGGLE_ROOM
+#define HEIGHT_TOP_OR_BOTTOM         ((PADDLE_WID + BALL_SIZE) >> 1) + WIGGLE_ROOM
+
+/* Edge limitations for ball's center coordinate */
+#define HORIZ_CENTER_MAX_BALL        (ARENA_MAX_X - BALL_SIZE_D2)
+#define HORIZ_CENTER_MIN_BALL        (ARENA_MIN_X + BALL_SIZE_D2)
+#define VERT_CENTER_MAX_BALL         (ARENA_MAX_Y - BALL_SIZE_D2)
+#define VERT_CENTER_MIN_BALL         (ARENA_MIN_Y + BALL_SIZE_D2)
+
+/* Maximum ball speed */
+#define MAX_BALL_SPEED               6
+
+/* Enums for player numbers */
+typedef enum
+{
+    BOTTOM = 0,
+    TOP = 1
+}playerPosition;
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+/*********************************************** Data Structures ********************************************************************/
+#pragma pack ( push, 1)
+/*
+ * Struct to be sent from the client to the host
+ */
+typedef struct
+{
+    uint32_t IP_address;
+    int16_t displacement;
+    uint8_t playerNumber;
+    bool ready;
+    bool joined;
+    bool acknowledge;
+    uint16_t ackSequence;       // Newest snapshot received, SNAPSHOT_NO_BASE before the first one
+} SpecificPlayerInfo_t;
+
+/*
+ * General player info to be used by both host and client
+ * Client responsible for translation
+ */
+typedef struct
+{
+    int16_t currentCenter;
+    uint16_t color;
+    playerPosition position;
+} GeneralPlayerInfo_t;
+
+/*
+ * Struct of all the balls, only changed by the host
+ */
+typedef struct
+{
+    int16_t currentCenterX;
+    int16_t currentCenterY;
+    int16_t velocityX;
+    int16_t velocityY;
+    uint16_t color;
+    uint32_t threadId;
+    bool alive;
+} Ball_t;
+
+/*
+ * Struct to be sent from the host to the client
+ */
+typedef struct
+{
+    SpecificPlayerInfo_t player;
+    GeneralPlayerInfo_t players[MAX_NUM_OF_PLAYERS];
+    Ball_t balls[MAX_NUM_OF_BALLS];
+    uint16_t numberOfBalls;
+    bool winner;
+    bool gameDone;
+    uint8_t LEDScores[2];
+    uint8_t overallScores[2];
+} GameState_t;
+#pragma pack ( pop )
+
+/*
+ * Struct of all the previous ball locations, only changed by self for drawing!
+ */
+typedef struct
+{
+    int16_t CenterX;
+    int16_t CenterY;
+}PrevBall_t;
+
+/*
+ * Struct of all the previous players locations, only changed by self for drawing
+ */
+typedef struct
+{
+    int16_t Center;
+}PrevPlayer_t;
+/*********************************************** Data Structures ********************************************************************/
+
+#endif /* GAMETYPES_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Input.c
+ */
+
+#include "Input.h"
+#include "NetProtocol.h"
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the buffer, the next input gets sequence 0
+ */
+void Input_Clear(InputBuffer_t *buf)
+{
+    buf->oldest = 0;
+    buf->next = 0;
+    buf->overwritten = 0;
+}
+
+/*
+ * Records a new input, dropping and counting the oldest one if the buffer is full
+ * Returns: sequence of the new input
+ */
+uint16_t Input_Push(InputBuffer_t *buf, int8_t displacement)
+{
+    uint16_t seq = buf->next++;
+
+    if((uint16_t)(buf->next - buf->oldest) > INPUT_BUFFER_SIZE){
+        buf->oldest++;
+        buf->overwritten++;
+    }
+    buf->displacements[seq & (INPUT_BUFFER_SIZE - 1)] = displacement;
+    return seq;
+}
+
+/*
+ * Drops every input older than nextExpected, the first input the host has not processed
+ */
+void Input_Acknowledge(InputBuffer_t *buf, uint16_t nextExpected)
+{
+    //Stale acks and acks for inputs we never sent are ignored
+    if((int16_t)(nextExpected - buf->oldest) > 0 && (int16_t)(buf->next - nextExpected) >= 0){
+        buf->oldest = nextExpected;
+    }
+}
+
+/*
+ * Replays every unacknowledged input on top of an authoritative paddle center
+ * Returns: predicted paddle center
+ */
+int16_t Input_Replay(const InputBuffer_t *buf, int16_t center)
+{
+    uint16_t seq;
+
+    for(seq = buf->oldest; seq != buf->next; seq++){
+        center = Input_MovePaddle(center, buf->displacements[seq & (INPUT_BUFFER_SIZE - 1)]);
+    }
+    return center;
+}
+
+/*
+ * Encodes the snapshot ack and all unacknowledged inputs
+ * Returns: number of bytes written, at most INPUT_PACKET_MAX_SIZE
+ */
+uint16_t Input_Encode(const InputBuffer_t *buf, uint16_t snapshotAck, uint8_t *out)
+{
+    uint8_t *p = out;
+    uint16_t seq;
+
+    p = Net_PutU16(p, snapshotAck);
+    p = Net_PutU16(p, buf->oldest);
+    p = Net_PutU8(p, buf->next - buf->oldest);
+    for(seq = buf->oldest; seq != buf->next; seq++){
+        *p++ = (uint8_t)buf->displacements[seq & (INPUT_BUFFER_SIZE - 1)];
+    }
+    return p - out;
+}
+
+/*
+ * Decodes a client input packet
+ * Returns: false if the packet is malformed
+ */
+bool Input_Decode(const uint8_t *buf, uint16_t len, InputPacket_t *packet)
+{
+    int i;
+
+    if(len < 5){
+        return false;
+    }
+
+    packet->snapshotAck = Net_GetU16(buf);
+    packet->first = Net_GetU16(buf + 2);
+    packet->count = Net_GetU8(buf + 4);
+    if(packet->count > INPUT_BUFFER_SIZE || len != 5 + packet->count){
+        return false;
+    }
+
+    for(i = 0; i < packet->count; i++){
+        packet->displacements[i] = (int8_t)buf[5 + i];
+    }
+    return true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
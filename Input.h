@@ -0,0 +1,121 @@
+/*
+ * Input.h
+ *
+ * Client paddle inputs for prediction and reconciliation.
+ * Every joystick tick becomes a sequenced input that the client applies immediately
+ * and keeps until a snapshot shows the host has processed it. Unacknowledged inputs
+ * are resent in every packet, and replayed on top of each authoritative paddle position.
+ *
+ * Client to host packet, little endian:
+ *  - newest snapshot received (u16)
+ *  - sequence of the first input (u16)
+ *  - input count (u8), then one signed displacement byte per input
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "GameTypes.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Client input tick, ms, see ReadJoystickClient */
+#define INPUT_PERIOD_MS             20
+
+/* Round trip, ms, up to which no unacknowledged input is overwritten, see INPUT_BUFFER_SIZE */
+#define INPUT_MAX_RTT_MS            500
+
+/*
+ * Unacknowledged inputs kept by the client, power of two
+ * An input waits for the client's next send, the host's next snapshot and a round trip, both
+ * sends slowed to RATE_MAX_PERIOD_MS in the worst case: 700 ms or 35 inputs, checked in NetGame.c
+ */
+#define INPUT_BUFFER_SIZE           64
+
+/* Largest client input packet */
+#define INPUT_PACKET_MAX_SIZE       (2 + 2 + 1 + INPUT_BUFFER_SIZE)
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Ring of inputs the host has not confirmed yet
+ */
+typedef struct
+{
+    int8_t displacements[INPUT_BUFFER_SIZE];
+    uint16_t oldest;            // Sequence of the oldest unacknowledged input
+    uint16_t next;              // Sequence the next input will get
+    uint32_t overwritten;       // Inputs dropped unacknowledged because the buffer was full
+} InputBuffer_t;
+
+/*
+ * Decoded client input packet
+ */
+typedef struct
+{
+    uint16_t snapshotAck;
+    uint16_t first;
+    uint8_t count;
+    int8_t displacements[INPUT_BUFFER_SIZE];
+} InputPacket_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Moves a paddle center by one input, if it stays inside the arena
+ * Host and client both use this so that replayed inputs land where the host put them
+ */
+static inline int16_t Input_MovePaddle(int16_t center, int8_t displacement)
+{
+    if(center + displacement > ARENA_MIN_X + PADDLE_LEN_D2 &&
+            center + displacement < ARENA_MAX_X - PADDLE_LEN_D2){
+        return center + displacement;
+    }
+    return center;
+}
+
+/*
+ * Empties the buffer, the next input gets sequence 0
+ */
+void Input_Clear(InputBuffer_t *buf);
+
+/*
+ * Records a new input, dropping and counting the oldest one if the buffer is full
+ * Returns: sequence of the new input
+ */
+uint16_t Input_Push(InputBuffer_t *buf, int8_t displacement);
+
+/*
+ * Drops every input older than nextExpected, the first input the host has not processed
+ */
+void Input_Acknowledge(InputBuffer_t *buf, uint16_t nextExpected);
+
+/*
+ * Replays every unacknowledged input on top of an authoritative paddle center
+ * Returns: predicted paddle center
+ */
+int16_t Input_Replay(const InputBuffer_t *buf, int16_t center);
+
+/*
+ * Encodes the snapshot ack and all unacknowledged inputs
+ * Returns: number of bytes written, at most INPUT_PACKET_MAX_SIZE
+ */
+uint16_t Input_Encode(const InputBuffer_t *buf, uint16_t snapshotAck, uint8_t *out);
+
+/*
+ * Decodes a client input packet
+ * Returns: false if the packet is malformed
+ */
+bool Input_Decode(const uint8_t *buf, uint16_t len, InputPacket_t *packet);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* INPUT_H_ */
@@ -0,0 +1,263 @@
+/*
+ * Interpolation.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include "Interpolation.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+typedef struct
+{
+    Snapshot_t snap;
+    uint32_t time;              // host time, unwrapped to 32 bits
+} InterpEntry_t;
+
+/* Ring of snapshots in sequence order, head is the oldest */
+static InterpEntry_t entries[INTERP_BUFFER_SIZE];
+static uint8_t head;
+static uint8_t count;
+
+/* Local time minus host time, tracks the fastest recent arrival */
+static int32_t offset;
+static uint8_t creep;
+
+/* Arrival of the newest snapshot, for the jitter estimate */
+static uint32_t lastArrival;
+
+/* Interarrival jitter in 1/16 ms */
+static uint32_t jitter16;
+
+/* Host time between snapshots in 1/16 ms, follows the host's send rate */
+static uint32_t interval16;
+
+/* Host time of the last frame drawn */
+static uint32_t lastRender;
+static bool rendered;
+
+static InterpStats_t stats;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+static inline const InterpEntry_t *Entry(uint8_t i)
+{
+    return &entries[(head + i) % INTERP_BUFFER_SIZE];
+}
+
+static inline int16_t Clamp(int16_t v, int16_t min, int16_t max)
+{
+    return v < min ? min : (v > max ? max : v);
+}
+
+/*
+ * Render delay, two snapshot intervals plus twice the jitter but never below INTERP_DELAY_MS
+ */
+static inline uint32_t RenderDelay()
+{
+    uint32_t delay = (2 * interval16 + 2 * jitter16) >> 4;
+    return delay < INTERP_DELAY_MS ? INTERP_DELAY_MS : delay;
+}
+
+/*
+ * Writes the balls of current, moving each one along p0 -> p1 by num/den
+ * Balls that are not alive in both, or jump further than INTERP_SNAP_DISTANCE, stay where current has them
+ */
+static void Blend(const Snapshot_t *p0, const Snapshot_t *p1, int32_t num, int32_t den,
+                  const Snapshot_t *current, Ball_t *balls)
+{
+    int32_t x, y, dx, dy;
+    int i;
+
+    for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+        balls[i].alive = (current->alive >> i) & 1;
+        if(!balls[i].alive){
+            continue;
+        }
+
+        x = current->balls[i].x;
+        y = current->balls[i].y;
+        if((p0->alive & p1->alive & (1 << i)) && den > 0){
+            dx = p1->balls[i].x - p0->balls[i].x;
+            dy = p1->balls[i].y - p0->balls[i].y;
+            if(dx <= INTERP_SNAP_DISTANCE && dx >= -INTERP_SNAP_DISTANCE &&
+                    dy <= INTERP_SNAP_DISTANCE && dy >= -INTERP_SNAP_DISTANCE){
+                x = p0->balls[i].x + dx * num / den;
+                y = p0->balls[i].y + dy * num / den;
+            }
+        }
+
+        balls[i].currentCenterX = Clamp(x + ARENA_MIN_X, HORIZ_CENTER_MIN_BALL, HORIZ_CENTER_MAX_BALL);
+        balls[i].currentCenterY = Clamp(y + ARENA_MIN_Y, VERT_CENTER_MIN_BALL, VERT_CENTER_MAX_BALL);
+        balls[i].color = Snapshot_Color(current->balls[i].color);
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the buffer, called when joining a game
+ */
+void Interp_Clear()
+{
+    int32_t primask = StartCriticalSection();
+    head = 0;
+    count = 0;
+    jitter16 = 0;
+    interval16 = (INTERP_DELAY_MS / 3) << 4;
+    rendered = false;
+    EndCriticalSection(primask);
+}
+
+/*
+ * Adds a snapshot that arrived at local time arrival (ms)
+ * Snapshots must be added in sequence order
+ */
+void Interp_Push(const Snapshot_t *snap, uint32_t arrival)
+{
+    const InterpEntry_t *newest;
+    InterpEntry_t *entry;
+    uint32_t time;
+    int32_t sampleOffset, d;
+    int32_t primask = StartCriticalSection();
+
+    if(count){
+        newest = Entry(count - 1);
+        time = newest->time + (int16_t)(snap->hostTime - (uint16_t)newest->time);
+
+        //Difference in transit time from the previous snapshot
+        d = (int32_t)(arrival - lastArrival) - (int32_t)(time - newest->time);
+        if(d < 0){
+            d = -d;
+        }
+        jitter16 += d - ((jitter16 + 8) >> 4);
+        interval16 += (time - newest->time) - ((interval16 + 8) >> 4);
+
+        //Faster arrivals pull the offset down at once, slower ones only creep it up
+        sampleOffset = arrival - time;
+        if(sampleOffset - offset < 0){
+            offset = sampleOffset;
+            creep = 0;
+        } else if(++creep >= INTERP_OFFSET_CREEP){
+            offset++;
+            creep = 0;
+        }
+    } else {
+        time = snap->hostTime;
+        offset = arrival - time;
+        creep = 0;
+    }
+
+    if(rendered && (int32_t)(time - lastRender) <= 0){
+        stats.late++;
+    }
+
+    if(count == INTERP_BUFFER_SIZE){
+        head = (head + 1) % INTERP_BUFFER_SIZE;
+        count--;
+    }
+    entry = &entries[(head + count) % INTERP_BUFFER_SIZE];
+    entry->snap = *snap;
+    entry->time = time;
+    count++;
+
+    lastArrival = arrival;
+    stats.received++;
+    stats.jitter = jitter16 >> 4;
+
+    EndCriticalSection(primask);
+}
+
+/*
+ * Fills balls with their positions one render delay behind local time now (ms)
+ * Only the position, color and alive fields are written
+ * Returns: false if no snapshot has arrived yet
+ */
+bool Interp_Sample(uint32_t now, Ball_t *balls)
+{
+    const InterpEntry_t *a, *b, *prev;
+    uint32_t render, ahead, span;
+    int i;
+    int32_t primask = StartCriticalSection();
+
+    if(!count){
+        EndCriticalSection(primask);
+        return false;
+    }
+
+    //Newest snapshot at or before the render time
+    stats.delay = RenderDelay();
+    render = now - offset - stats.delay;
+    for(i = count - 1; i > 0 && (int32_t)(Entry(i)->time - render) > 0; i--);
+    a = Entry(i);
+
+    if((int32_t)(a->time - render) > 0){
+        //Render time is before everything buffered, hold the oldest
+        Blend(&a->snap, &a->snap, 0, 1, &a->snap, balls);
+        stats.depth = count;
+    } else if(i < count - 1){
+        b = Entry(i + 1);
+        Blend(&a->snap, &b->snap, render - a->time, b->time - a->time, &a->snap, balls);
+        stats.interpolated++;
+        stats.depth = count - 1 - i;
+    } else if(i > 0){
+        //Past the newest snapshot, continue along the last two
+        prev = Entry(i - 1);
+        span = a->time - prev->time;
+        ahead = render - a->time;
+        if(ahead > INTERP_MAX_EXTRAPOLATION_MS){
+            ahead = INTERP_MAX_EXTRAPOLATION_MS;
+            stats.held++;
+        } else {
+            stats.extrapolated++;
+        }
+        Blend(&prev->snap, &a->snap, span + ahead, span, &a->snap, balls);
+        stats.depth = 0;
+    } else {
+        Blend(&a->snap, &a->snap, 0, 1, &a->snap, balls);
+        stats.held++;
+        stats.depth = 0;
+    }
+
+    lastRender = render;
+    rendered = true;
+
+    EndCriticalSection(primask);
+    return true;
+}
+
+/*
+ * Copies the jitter buffer statistics
+ */
+void Interp_GetStats(InterpStats_t *out)
+{
+    int32_t primask = StartCriticalSection();
+    *out = stats;
+    EndCriticalSection(primask);
+}
+
+/*
+ * Clears the jitter buffer statistics
+ */
+void Interp_ResetStats()
+{
+    int32_t primask = StartCriticalSection();
+    stats.received = 0;
+    stats.late = 0;
+    stats.interpolated = 0;
+    stats.extrapolated = 0;
+    stats.held = 0;
+    EndCriticalSection(primask);
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,93 @@
+/*
+ * Interpolation.h
+ *
+ * Client side jitter buffer for the balls.
+ * Snapshots are kept with the host time they were taken at and the balls are drawn
+ * at least INTERP_DELAY_MS behind the newest one, interpolating between the two snapshots
+ * around the render time. The delay grows with the snapshot spacing and jitter, so a host
+ * that lowers its send rate still leaves two snapshots to draw between.
+ * When no newer snapshot has arrived, balls are dead reckoned from
+ * the velocity between the last two snapshots for up to INTERP_MAX_EXTRAPOLATION_MS.
+ */
+
+#ifndef INTERPOLATION_H_
+#define INTERPOLATION_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "GameTypes.h"
+#include "Snapshot.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Snapshots kept, must cover INTERP_DELAY_MS plus a few late packets */
+#define INTERP_BUFFER_SIZE              8
+
+/* Least delay behind the host the balls are drawn at, three send periods at the full rate */
+#define INTERP_DELAY_MS                 60
+
+/* Longest time a ball is dead reckoned before it is held in place */
+#define INTERP_MAX_EXTRAPOLATION_MS     100
+
+/* Moves longer than this between two snapshots are respawns, not motion */
+#define INTERP_SNAP_DISTANCE            32
+
+/* Snapshots between 1 ms upward steps of the clock offset, follows drift between the boards */
+#define INTERP_OFFSET_CREEP             16
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Jitter buffer statistics, times in milliseconds
+ */
+typedef struct
+{
+    uint32_t received;          // snapshots added to the buffer
+    uint32_t late;              // snapshots that arrived after the render time had passed them
+    uint32_t interpolated;      // frames drawn between two snapshots
+    uint32_t extrapolated;      // frames dead reckoned past the newest snapshot
+    uint32_t held;              // frames held in place after INTERP_MAX_EXTRAPOLATION_MS
+    uint32_t jitter;            // smoothed interarrival jitter
+    uint32_t depth;             // snapshots newer than the render time at the last frame
+    uint32_t delay;             // current render delay behind the host
+} InterpStats_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the buffer, called when joining a game
+ */
+void Interp_Clear();
+
+/*
+ * Adds a snapshot that arrived at local time arrival (ms)
+ * Snapshots must be added in sequence order
+ */
+void Interp_Push(const Snapshot_t *snap, uint32_t arrival);
+
+/*
+ * Fills balls with their positions one render delay behind local time now (ms)
+ * Only the position, color and alive fields are written
+ * Returns: false if no snapshot has arrived yet
+ */
+bool Interp_Sample(uint32_t now, Ball_t *balls);
+
+/*
+ * Copies the jitter buffer statistics
+ */
+void Interp_GetStats(InterpStats_t *stats);
+
+/*
+ * Clears the jitter buffer statistics
+ */
+void Interp_ResetStats();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* INTERPOLATION_H_ */
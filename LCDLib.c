@@ -10,6 +10,16 @@
 #include "driverlib.h"
 #include "AsciiLib.h"
 
+/************************************  Private Variables  *******************************************/
+
+/* Current SPI bit rate */
+static uint32_t spiClockHz;
+
+/* Full screen clears averaged by LCD_Benchmark */
+#define BENCHMARK_CLEARS    4
+
+/************************************  Private Variables  *******************************************/
+
 /************************************  Private Functions  *******************************************/
 
 /*
@@ -47,8 +57,9 @@ static void LCD_initSPI()
     //SPI Config, master mode, 3-pin spi, smclk, inactive-high, msb first
     UCB3CTLW0 |= EUSCI_B_CTLW0_CKPL | EUSCI_B_CTLW0_MSB | EUSCI_B_CTLW0_MST | EUSCI_B_CTLW0_MODE_0 | EUSCI_B_CTLW0_UCSSEL_2;
 
-    //End SPI config
+    //End SPI config, run the init sequence at a rate every panel handles
     UCB3CTLW0 &= ~UCSWRST;
+    LCD_SetSPIClock(LCD_SPI_SAFE_HZ);
 
     /* P10.1 - CLK
      * P10.2 - MOSI
@@ -59,6 +70,24 @@ static void LCD_initSPI()
 
 }
 
+/*******************************************************************************
+ * Function Name  : LCD_setSPIDivider
+ * Description    : Sets the UCB3 clock divider
+ * Input          : div: SMCLK divider
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+static void LCD_setSPIDivider(uint16_t div)
+{
+    //Divider can only be changed while in reset
+    UCB3CTLW0 |= UCSWRST;
+    UCB3BRW = div;
+    UCB3CTLW0 &= ~UCSWRST;
+
+    spiClockHz = CS_getSMCLK() / div;
+}
+
 /*******************************************************************************
  * Function Name  : LCD_reset
  * Description    : Resets LCD
@@ -93,13 +122,86 @@ static void LCD_reset()
 void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
 {
     //Set the cursor and screen size, then just clear the screen
+    LCD_SetWindow(xStart, xEnd, yStart, yEnd);
+    LCD_Clear(Color, (xEnd-xStart), (yEnd-yStart));
+
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SetWindow
+ * Description    : Sets the GRAM window and moves the cursor to its top left
+ * Input          : xStart, xEnd, yStart, yEnd (end coordinates are exclusive)
+ * Output         : None
+ * Return         : None
+ * Attention      : GRAM writes then fill left to right, top to bottom
+ *******************************************************************************/
+void LCD_SetWindow(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
     LCD_SetCursor(xStart, yStart);
     LCD_WriteReg(HOR_ADDR_START_POS, yStart);     /* Horizontal GRAM Start Address */
     LCD_WriteReg(HOR_ADDR_END_POS, yEnd-1);  /* Horizontal GRAM End Address */
     LCD_WriteReg(VERT_ADDR_START_POS, xStart);    /* Vertical GRAM Start Address */
     LCD_WriteReg(VERT_ADDR_END_POS, xEnd-1); /* Vertical GRAM Start Address */
-    LCD_Clear(Color, (xEnd-xStart), (yEnd-yStart));
+}
 
+/*******************************************************************************
+ * Function Name  : LCD_WriteGRAMStart
+ * Description    : Selects GRAM and opens a pixel stream to the LCD controller
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Leaves chip select low until LCD_WriteGRAMEnd is called
+ *******************************************************************************/
+inline void LCD_WriteGRAMStart(void)
+{
+    LCD_WriteIndex(GRAM);
+    SPI_CS_LOW;
+    LCD_Write_Data_Start();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WriteGRAMPixel
+ * Description    : Pushes a single pixel into an open GRAM stream
+ * Input          : - color: RGB565 color of the pixel
+ * Output         : None
+ * Return         : None
+ * Attention      : Must be called between LCD_WriteGRAMStart and LCD_WriteGRAMEnd
+ *******************************************************************************/
+inline void LCD_WriteGRAMPixel(uint16_t color)
+{
+    SPI_transmitData(EUSCI_B3_BASE, color >> 8);
+    SPI_transmitData(EUSCI_B3_BASE, color & 0xff);
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WriteGRAMBuffer
+ * Description    : Pushes a buffer of pixels into an open GRAM stream
+ * Input          : - pixels: pixels already in LCD byte order (see PK_ExpandPaletteSwapped)
+ *                  - count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : Must be called between LCD_WriteGRAMStart and LCD_WriteGRAMEnd
+ *******************************************************************************/
+inline void LCD_WriteGRAMBuffer(const uint16_t *pixels, uint16_t count)
+{
+    const uint8_t *bytes = (const uint8_t *)pixels;
+    uint32_t len = (uint32_t)count << 1;
+    while(len--){
+        SPI_transmitData(EUSCI_B3_BASE, *bytes++);
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WriteGRAMEnd
+ * Description    : Closes a pixel stream opened by LCD_WriteGRAMStart
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+inline void LCD_WriteGRAMEnd(void)
+{
+    SPI_CS_HIGH;
 }
 
 /******************************************************************************
@@ -459,6 +561,13 @@ void LCD_Init(bool usingTP)
     LCD_WriteReg(DISPLAY_CONTROL_1, 0x0133); /* 262K color and display ON */
     Delay(50); /* delay 50 ms */
 
+    //Speed the bus up now that the panel is configured
+    if(LCD_SPI_CLOCK_HZ == LCD_SPI_CLOCK_AUTO){
+        LCD_NegotiateSPIClock(LCD_SPI_MAX_HZ);
+    } else {
+        LCD_SetSPIClock(LCD_SPI_CLOCK_HZ);
+    }
+
 
     //If using the touch screen
     if (usingTP)
@@ -476,6 +585,126 @@ void LCD_Init(bool usingTP)
 
 }
 
+/*******************************************************************************
+ * Function Name  : LCD_EnableFrameMarker
+ * Description    : Turns on the FMARK output of the panel and its GPIO input
+ * Input          : - markerLine: scan line at which FMARK is pulsed
+ * Output         : None
+ * Return         : None
+ * Attention      : Interrupt on LCD_FMARK_PIN is armed but not routed to the NVIC
+ *******************************************************************************/
+void LCD_EnableFrameMarker(uint16_t markerLine)
+{
+    //FMARK is an active high pulse, trigger on the rising edge
+    P3DIR &= ~LCD_FMARK_PIN;
+    P3SEL0 &= ~LCD_FMARK_PIN;
+    P3SEL1 &= ~LCD_FMARK_PIN;
+    P3IES &= ~LCD_FMARK_PIN;
+    P3IFG &= ~LCD_FMARK_PIN;
+    P3IE |= LCD_FMARK_PIN;
+
+    LCD_WriteReg(FRAME_MARKER_POSITION, markerLine & 0x1ff); /* Frame marker Position */
+    LCD_WriteReg(DISPLAY_CONTROL_4, FMARK_OUTPUT_ENABLE); /* FMARK function */
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SetSPIClock
+ * Description    : Sets the LCD SPI bit rate
+ * Input          : - targetHz: highest acceptable bit rate
+ * Output         : None
+ * Return         : Bit rate actually set (SMCLK divided down)
+ * Attention      : None
+ *******************************************************************************/
+uint32_t LCD_SetSPIClock(uint32_t targetHz)
+{
+    uint32_t smclk = CS_getSMCLK();
+    uint32_t div = (smclk + targetHz - 1) / targetHz;
+
+    if(div == 0){
+        div = 1;
+    }
+    LCD_setSPIDivider(div);
+    return spiClockHz;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_NegotiateSPIClock
+ * Description    : Finds the fastest bit rate at which READ_ID_CODE reads back correctly
+ * Input          : - maxHz: fastest bit rate to try
+ * Output         : None
+ * Return         : Bit rate chosen, LCD_SPI_SAFE_HZ is used if no rate passes
+ * Attention      : None
+ *******************************************************************************/
+uint32_t LCD_NegotiateSPIClock(uint32_t maxHz)
+{
+    uint32_t smclk = CS_getSMCLK();
+    uint32_t div = (smclk + maxHz - 1) / maxHz;
+    int i;
+
+    if(div == 0){
+        div = 1;
+    }
+
+    //Walk down from the fastest rate until the ID code reads back cleanly every time
+    for(; div <= LCD_SPI_MAX_DIVIDER; div++){
+        LCD_setSPIDivider(div);
+        for(i = 0; i < LCD_ID_READBACKS; i++){
+            if(LCD_ReadReg(READ_ID_CODE) != LCD_ID_CODE){
+                break;
+            }
+        }
+        if(i == LCD_ID_READBACKS){
+            return spiClockHz;
+        }
+    }
+
+    return LCD_SetSPIClock(LCD_SPI_SAFE_HZ);
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_GetSPIClock
+ * Description    : Returns the LCD SPI bit rate in use
+ * Input          : None
+ * Output         : None
+ * Return         : Bit rate in Hz
+ * Attention      : None
+ *******************************************************************************/
+uint32_t LCD_GetSPIClock()
+{
+    return spiClockHz;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_Benchmark
+ * Description    : Measures full screen clear time and sustained fill rate
+ * Input          : - result: filled with the measurements
+ * Output         : None
+ * Return         : None
+ * Attention      : Overwrites the whole screen, uses Timer32 module 0
+ *******************************************************************************/
+void LCD_Benchmark(LCDBenchmark *result)
+{
+    uint32_t ticksPerUs = CS_getMCLK() / 1000000;
+    uint32_t start, elapsed;
+    int i;
+
+    //Free running down counter at MCLK
+    Timer32_initModule(TIMER32_0_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT, TIMER32_FREE_RUN_MODE);
+    Timer32_startTimer(TIMER32_0_BASE, false);
+
+    start = Timer32_getValue(TIMER32_0_BASE);
+    for(i = 0; i < BENCHMARK_CLEARS; i++){
+        LCD_DrawRectangle(MIN_SCREEN_X, MAX_SCREEN_X, MIN_SCREEN_Y, MAX_SCREEN_Y, (i & 1) ? LCD_WHITE : LCD_BLACK);
+    }
+    elapsed = start - Timer32_getValue(TIMER32_0_BASE);
+
+    Timer32_haltTimer(TIMER32_0_BASE);
+
+    result->spiClockHz = spiClockHz;
+    result->clearTimeUs = elapsed / ticksPerUs / BENCHMARK_CLEARS;
+    result->fillBytesPerSec = result->clearTimeUs ? (uint32_t)((uint64_t)SCREEN_SIZE * 2 * 1000000 / result->clearTimeUs) : 0;
+}
+
 /*******************************************************************************
  * Function Name  : TP_ReadXY
  * Description    : Obtain X and Y touch coordinates
@@ -30,6 +30,22 @@
 #define SPI_CS_LOW P10OUT &= ~BIT4
 #define SPI_CS_HIGH P10OUT |= BIT4
 
+/* FMARK (frame marker) input from the panel, see VSync.c */
+#define LCD_FMARK_PIN       BIT6
+#define LCD_FMARK_IRQn      PORT3_IRQn
+
+/* DISPLAY_CONTROL_4 bits */
+#define FMARK_OUTPUT_ENABLE 0x0008     /* FMARKOE, FMI[2:0] = 0 gives one pulse per frame */
+
+/* SPI bit rate, LCD_SPI_CLOCK_AUTO picks the fastest rate that still reads back the ID code */
+#define LCD_SPI_CLOCK_AUTO  0
+#define LCD_SPI_CLOCK_HZ    LCD_SPI_CLOCK_AUTO
+#define LCD_SPI_MAX_HZ      24000000   /* Upper bound tried by auto negotiation */
+#define LCD_SPI_SAFE_HZ     4000000    /* Used for the init sequence and if negotiation fails */
+#define LCD_SPI_MAX_DIVIDER 64
+#define LCD_ID_READBACKS    4          /* Consecutive good ID reads needed to accept a rate */
+#define LCD_ID_CODE         0x9325
+
 /* CS Touchpanel */
 #define SPI_CS_TP_LOW P10OUT &= ~BIT5
 #define SPI_CS_TP_HIGH P10OUT |= BIT5
@@ -115,6 +131,12 @@ typedef struct Point {
     int16_t x;
     int16_t y;
 }Point;
+
+typedef struct LCDBenchmark {
+    uint32_t spiClockHz;        /* SPI bit rate in use */
+    uint32_t clearTimeUs;       /* Average time to clear the full screen */
+    uint32_t fillBytesPerSec;   /* Sustained GRAM fill rate */
+}LCDBenchmark;
 /********************************** Structures ******************************************/
 
 /************************************ Public Functions  *******************************************/
@@ -129,6 +151,57 @@ typedef struct Point {
  *******************************************************************************/
 void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
 
+/*******************************************************************************
+ * Function Name  : LCD_SetWindow
+ * Description    : Sets the GRAM window and moves the cursor to its top left
+ * Input          : xStart, xEnd, yStart, yEnd (end coordinates are exclusive)
+ * Output         : None
+ * Return         : None
+ * Attention      : GRAM writes then fill left to right, top to bottom
+ *******************************************************************************/
+void LCD_SetWindow(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd);
+
+/*******************************************************************************
+* Function Name  : LCD_WriteGRAMStart
+* Description    : Selects GRAM and opens a pixel stream to the LCD controller
+* Input          : None
+* Output         : None
+* Return         : None
+* Attention      : Leaves chip select low until LCD_WriteGRAMEnd is called
+*******************************************************************************/
+inline void LCD_WriteGRAMStart(void);
+
+/*******************************************************************************
+* Function Name  : LCD_WriteGRAMPixel
+* Description    : Pushes a single pixel into an open GRAM stream
+* Input          : - color: RGB565 color of the pixel
+* Output         : None
+* Return         : None
+* Attention      : Must be called between LCD_WriteGRAMStart and LCD_WriteGRAMEnd
+*******************************************************************************/
+inline void LCD_WriteGRAMPixel(uint16_t color);
+
+/*******************************************************************************
+* Function Name  : LCD_WriteGRAMBuffer
+* Description    : Pushes a buffer of pixels into an open GRAM stream
+* Input          : - pixels: pixels already in LCD byte order (see PK_ExpandPaletteSwapped)
+*                  - count: number of pixels
+* Output         : None
+* Return         : None
+* Attention      : Must be called between LCD_WriteGRAMStart and LCD_WriteGRAMEnd
+*******************************************************************************/
+inline void LCD_WriteGRAMBuffer(const uint16_t *pixels, uint16_t count);
+
+/*******************************************************************************
+* Function Name  : LCD_WriteGRAMEnd
+* Description    : Closes a pixel stream opened by LCD_WriteGRAMStart
+* Input          : None
+* Output         : None
+* Return         : None
+* Attention      : None
+*******************************************************************************/
+inline void LCD_WriteGRAMEnd(void);
+
 /******************************************************************************
 * Function Name  : PutChar
 * Description    : Lcd screen displays a character
@@ -288,6 +361,56 @@ inline void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos );
 *******************************************************************************/
 void LCD_Init(bool usingTP);
 
+/*******************************************************************************
+* Function Name  : LCD_EnableFrameMarker
+* Description    : Turns on the FMARK output of the panel and its GPIO input
+* Input          : - markerLine: scan line at which FMARK is pulsed
+* Output         : None
+* Return         : None
+* Attention      : Interrupt on LCD_FMARK_PIN is armed but not routed to the NVIC
+*******************************************************************************/
+void LCD_EnableFrameMarker(uint16_t markerLine);
+
+/*******************************************************************************
+* Function Name  : LCD_SetSPIClock
+* Description    : Sets the LCD SPI bit rate
+* Input          : - targetHz: highest acceptable bit rate
+* Output         : None
+* Return         : Bit rate actually set (SMCLK divided down)
+* Attention      : None
+*******************************************************************************/
+uint32_t LCD_SetSPIClock(uint32_t targetHz);
+
+/*******************************************************************************
+* Function Name  : LCD_NegotiateSPIClock
+* Description    : Finds the fastest bit rate at which READ_ID_CODE reads back correctly
+* Input          : - maxHz: fastest bit rate to try
+* Output         : None
+* Return         : Bit rate chosen, LCD_SPI_SAFE_HZ is used if no rate passes
+* Attention      : None
+*******************************************************************************/
+uint32_t LCD_NegotiateSPIClock(uint32_t maxHz);
+
+/*******************************************************************************
+* Function Name  : LCD_GetSPIClock
+* Description    : Returns the LCD SPI bit rate in use
+* Input          : None
+* Output         : None
+* Return         : Bit rate in Hz
+* Attention      : None
+*******************************************************************************/
+uint32_t LCD_GetSPIClock();
+
+/*******************************************************************************
+* Function Name  : LCD_Benchmark
+* Description    : Measures full screen clear time and sustained fill rate
+* Input          : - result: filled with the measurements
+* Output         : None
+* Return         : None
+* Attention      : Overwrites the whole screen, uses Timer32 module 0
+*******************************************************************************/
+void LCD_Benchmark(LCDBenchmark *result);
+
 /*******************************************************************************
  * Function Name  : TP_ReadXY
  * Description    : Obtain X and Y touch coordinates
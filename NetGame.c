@@ -0,0 +1,737 @@
+/*
+ * NetGame.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include <stddef.h>
+#include "NetGame.h"
+#include "LCDLib.h"
+#include "Snapshot.h"
+#include "Input.h"
+#include "Interpolation.h"
+#include "Reliable.h"
+#include "Session.h"
+#include "G8RTOS_CriticalSection.h"
+
+#if NET_MAX_DATAGRAM > RX_PACKET_SIZE
+#error "Bundles must fit in the CC3100 receive ring"
+#endif
+
+#if INPUT_BUFFER_SIZE * INPUT_PERIOD_MS < 2 * RATE_MAX_PERIOD_MS + INPUT_MAX_RTT_MS
+#error "Inputs must outlive the slowest acknowledgement, see INPUT_BUFFER_SIZE"
+#endif
+
+#if INPUT_PACKET_MAX_SIZE > NET_SUBMSG_MAX_SIZE
+#error "Input packets must fit in a bundle"
+#endif
+
+#if SNAP_COLOR_WHITE != LCD_WHITE || SNAP_COLOR_BLUE != LCD_BLUE || SNAP_COLOR_RED != LCD_RED
+#error "Snapshot ball colors must match the LCD's"
+#endif
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Role of this board and the state the network reads and updates */
+static playerType role;
+static GameState_t *game;
+static SpecificPlayerInfo_t *self;
+
+/* Snapshots sent (host) or received (client), used as delta bases */
+static SnapshotHistory_t snapshots;
+
+/* Host: sequence of the next snapshot */
+static uint16_t snapshotSequence;
+
+/* Host: new clients are only taken while the game has not started */
+static bool acceptingJoins;
+
+/* Client: inputs predicted locally that the host has not processed yet */
+static InputBuffer_t inputs;
+
+/* Client: session with the host */
+static Session_t server;
+
+/* Datagrams handed to the CC3100 for any peer */
+static uint32_t packetsSent;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Sends this tick's bundle to a peer as a single datagram
+ */
+static void SendBundle(Session_t *peer, NetBundle_t *bundle)
+{
+    uint16_t len = Net_BundleFinish(bundle, peer->txSequence);
+
+    if(len){
+        peer->txSequence++;
+        packetsSent++;
+        SendData(bundle->data, peer->IP, len);
+    }
+}
+
+/*
+ * Queues an event on a peer's reliable channel
+ */
+static bool QueueEvent(Session_t *peer, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    int32_t primask = StartCriticalSection();
+    bool queued = Rel_Send(&peer->channel, type, payload, len);
+    EndCriticalSection(primask);
+    return queued;
+}
+
+/*
+ * Adds a peer's reliable channel ack and due events to this tick's bundle
+ */
+static void WriteEvents(Session_t *peer, NetBundle_t *bundle, uint32_t now)
+{
+    int32_t primask = StartCriticalSection();
+    Rel_Write(&peer->channel, bundle, now);
+    EndCriticalSection(primask);
+}
+
+/*
+ * Sends a datagram carrying only a peer's reliable channel, used while no game is running
+ */
+static void SendEvents(Session_t *peer, uint32_t now)
+{
+    NetBundle_t bundle;
+
+    Net_BundleBegin(&bundle);
+    WriteEvents(peer, &bundle, now);
+    SendBundle(peer, &bundle);
+}
+
+/*
+ * Host: drops a client and frees its paddle
+ */
+static void DropSession(Session_t *s)
+{
+    int32_t primask = StartCriticalSection();
+    game->players[s->player].currentCenter = PLAYER_ABSENT;
+    Session_Remove(s);
+    EndCriticalSection(primask);
+}
+
+/*
+ * Returns the session behind a link, see NetGame_GetRateStats
+ */
+static Session_t *Link(uint8_t link)
+{
+    return role == Host ? Session_Get(link) : (link == 0 ? &server : NULL);
+}
+
+/*
+ * Acts on an event delivered by a peer's reliable channel
+ */
+static void HandleEvent(Session_t *peer, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    switch(type){
+    case NET_EVT_JOIN:
+        //Host: the session already exists, tell the client which paddle it plays
+        if(!peer->ready){
+            QueueEvent(peer, NET_EVT_JOIN_ACK, &peer->player, 1);
+        }
+        break;
+    case NET_EVT_JOIN_ACK:
+        if(len == 1 && payload[0] > 0 && payload[0] < MAX_NUM_OF_PLAYERS){
+            self->playerNumber = payload[0];
+            self->acknowledge = 1;
+        }
+        break;
+    case NET_EVT_READY:
+        //Host: the paddle shows up in the next snapshot
+        if(!peer->ready){
+            peer->ready = 1;
+            NetGame_InitPlayer(peer->player);
+        }
+        break;
+    case NET_EVT_SCORE:
+        if(len == 2){
+            game->LEDScores[0] = payload[0];
+            game->LEDScores[1] = payload[1];
+        }
+        break;
+    case NET_EVT_GAME_OVER:
+        if(len == 3){
+            game->overallScores[0] = payload[1];
+            game->overallScores[1] = payload[2];
+            game->winner = payload[0];
+            game->gameDone = 1;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Host: queues the inputs of a client message, the send tick applies them once the game has started
+ */
+static void HandleInput(Session_t *peer, const uint8_t *payload, uint16_t len, uint32_t now)
+{
+    InputPacket_t in;
+    uint16_t seq;
+    int32_t primask;
+    int i;
+
+    if(!Input_Decode(payload, len, &in)){
+        return;
+    }
+
+    primask = StartCriticalSection();
+
+    //Deltas are based on the newest snapshot the client has confirmed
+    if(in.snapshotAck != SNAPSHOT_NO_BASE &&
+            (peer->snapshotAck == SNAPSHOT_NO_BASE || Snapshot_SeqNewer(in.snapshotAck, peer->snapshotAck))){
+        peer->snapshotAck = in.snapshotAck;
+        Rate_OnAck(&peer->rate, in.snapshotAck, now);
+    }
+
+    //Inputs are resent until acknowledged, queue each one exactly once and in order
+    //Nothing applies them until the game starts, so earlier ones are only acknowledged
+    for(i = 0; i < in.count; i++){
+        seq = in.first + i;
+        if((int16_t)(seq - peer->inputSequence) >= 0){
+            if(!acceptingJoins){
+                Input_Push(&peer->inputs, in.displacements[i]);
+            }
+            peer->inputSequence = seq + 1;
+        }
+    }
+
+    EndCriticalSection(primask);
+}
+
+/*
+ * Client: applies a snapshot message
+ */
+static void HandleSnapshot(const uint8_t *payload, uint16_t len, uint32_t now)
+{
+    Snapshot_t snap;
+    int32_t primask;
+
+    //Only newer snapshots whose base we still have update the game, the rest are dropped
+    if(!Snapshot_Decode(payload, len, &snapshots, &snap) ||
+            (self->ackSequence != SNAPSHOT_NO_BASE && !Snapshot_SeqNewer(snap.sequence, self->ackSequence))){
+        return;
+    }
+
+    Snapshot_Store(&snapshots, &snap);
+    Interp_Push(&snap, now);
+
+    //Take the host's paddle positions, then replay the inputs it has not seen yet
+    primask = StartCriticalSection();
+    Snapshot_Apply(&snap, game);
+    Input_Acknowledge(&inputs, snap.inputSequence);
+    Rate_OnAck(&server.rate, snap.inputSequence - 1, now);
+    if(game->players[self->playerNumber].currentCenter != PLAYER_ABSENT){
+        game->players[self->playerNumber].currentCenter = Input_Replay(&inputs, game->players[self->playerNumber].currentCenter);
+    }
+    EndCriticalSection(primask);
+
+    self->ackSequence = snap.sequence;
+}
+
+/*
+ * Dispatches every message of an intact datagram from a peer, then every event that is now in order
+ */
+static void ReadBundle(Session_t *peer, const uint8_t *packet, const NetHeader_t *hdr, uint32_t now)
+{
+    NetBundleReader_t reader;
+    const uint8_t *payload;
+    uint8_t event[REL_MAX_PAYLOAD];
+    uint16_t msgLen;
+    uint8_t type, eventLen;
+    int32_t primask;
+    bool delivered;
+
+    primask = StartCriticalSection();
+    peer->lastSeen = now;
+    Rate_OnReceive(&peer->rate, hdr->sequence);
+    EndCriticalSection(primask);
+
+    Net_BundleOpen(&reader, packet, hdr);
+    while(Net_BundleNext(&reader, &type, &payload, &msgLen)){
+        switch(type){
+        case NET_MSG_SNAPSHOT:
+            if(role == Client){
+                HandleSnapshot(payload, msgLen, now);
+            }
+            break;
+        case NET_MSG_INPUT:
+            if(role == Host){
+                HandleInput(peer, payload, msgLen, now);
+            }
+            break;
+        case NET_MSG_ACK:
+        case NET_MSG_RELIABLE:
+            primask = StartCriticalSection();
+            Rel_Read(&peer->channel, type, payload, msgLen, now);
+            EndCriticalSection(primask);
+            break;
+        default:
+            break;
+        }
+    }
+
+    do{
+        primask = StartCriticalSection();
+        delivered = Rel_Deliver(&peer->channel, &type, event, &eventLen);
+        EndCriticalSection(primask);
+        if(delivered){
+            HandleEvent(peer, type, event, eventLen);
+        }
+    } while(delivered);
+}
+
+/*
+ * Host: sends this tick's snapshot to one client, as a delta against the newest one it confirmed
+ */
+static void SendSnapshot(Session_t *s, const Snapshot_t *tick, uint16_t inputSequence, uint32_t now)
+{
+    Snapshot_t snap = *tick;
+    Snapshot_t base;
+    const Snapshot_t *found;
+    NetBundle_t bundle;
+    uint8_t msg[SNAPSHOT_MAX_SIZE];
+    uint16_t len;
+    int32_t primask;
+
+    //The history is shared, but each client saw its own input sequence in the base
+    snap.inputSequence = inputSequence;
+    s->sentInputSequence[snap.sequence % SNAPSHOT_HISTORY] = inputSequence;
+    found = Snapshot_Find(&snapshots, s->snapshotAck);
+    if(found){
+        base = *found;
+        base.inputSequence = s->sentInputSequence[base.sequence % SNAPSHOT_HISTORY];
+    }
+
+    Net_BundleBegin(&bundle);
+    len = Snapshot_Encode(&snap, found ? &base : NULL, msg);
+    Net_BundleAdd(&bundle, NET_MSG_SNAPSHOT, msg, len);
+
+    primask = StartCriticalSection();
+    Rate_OnSend(&s->rate, snap.sequence, now);
+    s->nextSend += Rate_Update(&s->rate, now);
+    EndCriticalSection(primask);
+
+    WriteEvents(s, &bundle, now);
+    SendBundle(s, &bundle);
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets the role of this board and the state the network reads and updates
+ * self is only used by a client
+ */
+void NetGame_Init(playerType playerRole, GameState_t *state, SpecificPlayerInfo_t *player)
+{
+    role = playerRole;
+    game = state;
+    self = player;
+    packetsSent = 0;
+    Snapshot_ClearHistory(&snapshots);
+}
+
+/*
+ * Sets up paddle i for its team, centered
+ */
+void NetGame_InitPlayer(uint8_t i)
+{
+    game->players[i].color = PLAYER_TEAM(i) == BOTTOM ? LCD_RED : LCD_BLUE;
+    game->players[i].position = PLAYER_TEAM(i);
+    game->players[i].currentCenter = PADDLE_X_CENTER;
+}
+
+/*
+ * Hands a received datagram to the session of its sender
+ * The host opens sessions for new clients until the game starts, everything else from strangers is dropped
+ * Returns: how the packet parsed, NET_ERR_VERSION for a peer running another protocol version
+ */
+net_ErrCode_t NetGame_ReadPacket(uint32_t IP, const uint8_t *packet, int32_t len, uint32_t now)
+{
+    NetHeader_t hdr;
+    Session_t *peer;
+    net_ErrCode_t err;
+
+    if(len <= 0){
+        return NET_ERR_SHORT;
+    }
+
+    err = Net_ParsePacket(packet, len, &hdr);
+    if(err != NET_OK || hdr.type != NET_MSG_BUNDLE){
+        return err;
+    }
+
+    if(role == Client){
+        peer = IP == server.IP ? &server : NULL;
+    } else {
+        peer = Session_Find(IP);
+        if(!peer && acceptingJoins){
+            peer = Session_Add(IP, now);
+        }
+    }
+
+    if(peer){
+        ReadBundle(peer, packet, &hdr, now);
+    }
+    return err;
+}
+
+/*
+ * Tells the session with IP that the CC3100 could not send to it
+ */
+void NetGame_SendFailed(uint32_t IP)
+{
+    Session_t *peer;
+    int32_t primask = StartCriticalSection();
+
+    if(role == Client){
+        peer = IP == server.IP ? &server : NULL;
+    } else {
+        peer = Session_Find(IP);
+    }
+    if(peer){
+        Rel_OnSendFailed(&peer->channel);
+        Rate_OnSendFailed(&peer->rate);
+    }
+    EndCriticalSection(primask);
+}
+
+/*
+ * Host: frees every paddle but its own and starts taking join requests
+ */
+void NetGame_HostOpen()
+{
+    for(int i = 1; i < MAX_NUM_OF_PLAYERS; i++){
+        game->players[i].currentCenter = PLAYER_ABSENT;
+    }
+    NetGame_InitPlayer(0);
+
+    Session_ClearTable();
+    Snapshot_ClearHistory(&snapshots);
+    snapshotSequence = 0;
+    acceptingJoins = true;
+}
+
+/*
+ * Host: drops silent clients and resends the join answers, call every NETGAME_JOIN_STEP_MS
+ * Returns: clients that are ready to play
+ */
+uint8_t NetGame_HostJoinStep(uint32_t now)
+{
+    Session_t *s;
+
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i))){
+            if((int32_t)(now - s->lastSeen) > SESSION_TIMEOUT_MS){
+                DropSession(s);
+            } else {
+                SendEvents(s, now);
+            }
+        }
+    }
+    return Session_Count(true);
+}
+
+/*
+ * Host: stops taking join requests and drops the clients that never got ready
+ */
+void NetGame_HostStart()
+{
+    Session_t *s;
+
+    acceptingJoins = false;
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i)) && !s->ready){
+            DropSession(s);
+        }
+    }
+}
+
+/*
+ * Host: applies the clients' inputs, captures a snapshot and sends it to every client
+ * its rate controller allows, call every RATE_MIN_PERIOD_MS
+ */
+void NetGame_HostTick(uint32_t now)
+{
+    Snapshot_t snap;
+    uint16_t inputSequence[MAX_SESSIONS];
+    Session_t *s;
+    int32_t primask;
+    int i;
+
+    //Apply the inputs each client sent since the last tick, then capture the state they produced
+    primask = StartCriticalSection();
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i))){
+            game->players[s->player].currentCenter = Input_Replay(&s->inputs, game->players[s->player].currentCenter);
+            Input_Acknowledge(&s->inputs, s->inputs.next);
+            inputSequence[i] = s->inputSequence;
+        }
+    }
+    Snapshot_Capture(&snap, game);
+    EndCriticalSection(primask);
+
+    snap.sequence = snapshotSequence;
+    snap.hostTime = now;
+    Snapshot_Store(&snapshots, &snap);
+
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if(!(s = Session_Get(i))){
+            continue;
+        }
+        //The receive thread may have seen the client after now was taken, so compare signed
+        if((int32_t)(now - s->lastSeen) > SESSION_TIMEOUT_MS){
+            DropSession(s);
+        } else if((int32_t)(now - s->nextSend) >= 0){
+            //A client that fell far behind restarts its schedule instead of bursting
+            if(now - s->nextSend > RATE_MAX_PERIOD_MS){
+                s->nextSend = now;
+            }
+            SendSnapshot(s, &snap, inputSequence[i], now);
+        }
+    }
+
+    //Never use the no-base marker as a sequence number
+    if(++snapshotSequence == SNAPSHOT_NO_BASE){
+        snapshotSequence = 0;
+    }
+}
+
+/*
+ * Host: queues an event for every client, or for none of them
+ * Returns: false if some client's reliable window was full, try again once acks have freed it
+ */
+bool NetGame_Broadcast(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    Session_t *s;
+    int32_t primask;
+    bool room = true;
+    int i;
+
+    //All or nothing, so a retry never gives a client the same event twice
+    primask = StartCriticalSection();
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i)) && !Rel_Space(&s->channel)){
+            s->channel.stats.full++;
+            room = false;
+        }
+    }
+    for(i = 0; room && i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i))){
+            Rel_Send(&s->channel, type, payload, len);
+        }
+    }
+    EndCriticalSection(primask);
+    return room;
+}
+
+/*
+ * Host: queues an event of which only the newest value matters (NET_EVT_SCORE) for every client
+ * Never fails, a newer value replaces one still waiting for the window, see Rel_SendLatest
+ */
+void NetGame_BroadcastLatest(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    Session_t *s;
+    int32_t primask = StartCriticalSection();
+
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i))){
+            Rel_SendLatest(&s->channel, type, payload, len);
+        }
+    }
+    EndCriticalSection(primask);
+}
+
+/*
+ * Host: true once every client has acknowledged every event, held ones included
+ */
+bool NetGame_EventsDelivered()
+{
+    Session_t *s;
+
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if((s = Session_Get(i)) && !Rel_Idle(&s->channel)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Client: opens the session with the host and asks to join
+ */
+void NetGame_ClientOpen(uint32_t hostIP, uint32_t localIP, uint32_t now)
+{
+    uint8_t ip[4];
+
+    self->IP_address = localIP;
+    self->acknowledge = 0;
+    self->displacement = 0;
+    self->joined = 0;
+    self->playerNumber = 0;
+    self->ready = 0;
+    self->ackSequence = SNAPSHOT_NO_BASE;
+    Input_Clear(&inputs);
+    Interp_Clear();
+    Snapshot_ClearHistory(&snapshots);
+
+    Session_Init(&server, hostIP, 0, now);
+    Net_PutU32(ip, localIP);
+    QueueEvent(&server, NET_EVT_JOIN, ip, sizeof(ip));
+}
+
+/*
+ * Client: resends the join request, call every NETGAME_JOIN_STEP_MS
+ * Returns: true once the host has handed us a paddle, self->playerNumber
+ */
+bool NetGame_ClientJoinStep(uint32_t now)
+{
+    if(self->acknowledge){
+        return true;
+    }
+    SendEvents(&server, now);
+    return false;
+}
+
+/*
+ * Client: tells the host we are ready, our paddle shows up in its next snapshot
+ */
+void NetGame_ClientReady(uint32_t now)
+{
+    QueueEvent(&server, NET_EVT_READY, NULL, 0);
+    SendEvents(&server, now);
+}
+
+/*
+ * Client: sends the unacknowledged inputs and due events to the host
+ * Returns: time until the next call, ms, from the rate controller
+ */
+uint32_t NetGame_ClientTick(uint32_t now)
+{
+    NetBundle_t bundle;
+    uint8_t msg[INPUT_PACKET_MAX_SIZE];
+    uint16_t len;
+    uint32_t period;
+    int32_t primask;
+
+    Net_BundleBegin(&bundle);
+
+    //Every unacknowledged input goes out again, so a lost packet costs no input
+    primask = StartCriticalSection();
+    len = Input_Encode(&inputs, self->ackSequence, msg);
+    if(inputs.next != inputs.oldest){
+        Rate_OnSend(&server.rate, inputs.next - 1, now);
+    }
+    period = Rate_Update(&server.rate, now);
+    EndCriticalSection(primask);
+    Net_BundleAdd(&bundle, NET_MSG_INPUT, msg, len);
+
+    WriteEvents(&server, &bundle, now);
+    SendBundle(&server, &bundle);
+    return period;
+}
+
+/*
+ * Client: moves our paddle now and queues the input for the host
+ * Inputs before the host's first snapshot are dropped, the game has not started
+ */
+void NetGame_ClientMove(int16_t displacement)
+{
+    int32_t primask;
+
+    //The host only sends snapshots once every client has joined, until then nothing would apply the input
+    if(self->ackSequence == SNAPSHOT_NO_BASE){
+        return;
+    }
+
+    //Predict the move now, the host applies the same input when it arrives
+    primask = StartCriticalSection();
+    Input_Push(&inputs, displacement);
+    if(game->players[self->playerNumber].currentCenter != PLAYER_ABSENT){
+        game->players[self->playerNumber].currentCenter = Input_MovePaddle(game->players[self->playerNumber].currentCenter, displacement);
+    }
+    EndCriticalSection(primask);
+}
+
+/*
+ * Copies the send rate controller's view of a link
+ * The host has one link per client session (0 to MAX_SESSIONS - 1), a client only link 0 to the host
+ * Returns: false if there is no such link
+ */
+bool NetGame_GetRateStats(uint8_t link, RateStats_t *stats)
+{
+    Session_t *s = Link(link);
+    int32_t primask;
+
+    if(!s){
+        return false;
+    }
+
+    primask = StartCriticalSection();
+    Rate_GetStats(&s->rate, stats);
+    EndCriticalSection(primask);
+    return true;
+}
+
+/*
+ * Adds up the packet counters of every link, the round trip and loss are the worst link's
+ */
+void NetGame_GetTrafficStats(TrafficStats_t *stats)
+{
+    TrafficStats_t sum = {0};
+    Session_t *s;
+    RateStats_t rate;
+    RelStats_t channel;
+    InterpStats_t interp;
+    int32_t primask;
+
+    for(uint8_t i = 0; i < MAX_SESSIONS; i++){
+        if(!(s = Link(i))){
+            continue;
+        }
+
+        primask = StartCriticalSection();
+        Rate_GetStats(&s->rate, &rate);
+        Rel_GetStats(&s->channel, &channel);
+        EndCriticalSection(primask);
+
+        sum.received += rate.received;
+        sum.late += rate.late;
+        sum.lost += rate.lost;
+        sum.duplicates += channel.duplicates;
+        if(role == Host){
+            sum.inputsOverwritten += s->inputs.overwritten;
+        }
+        if(rate.srtt > sum.srtt){
+            sum.srtt = rate.srtt;
+        }
+        if(rate.loss > sum.loss){
+            sum.loss = rate.loss;
+        }
+    }
+
+    Interp_GetStats(&interp);
+    sum.lateSnapshots = interp.late;
+    if(role == Client){
+        sum.inputsOverwritten = inputs.overwritten;
+    }
+    sum.sent = packetsSent;
+    *stats = sum;
+}
+
+/*********************************************** Public Functions *********************************************************************/
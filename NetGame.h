@@ -0,0 +1,157 @@
+/*
+ * NetGame.h
+ *
+ * The game's side of the network: joining, the snapshot stream from the host, the
+ * input stream from the clients and the reliable events, over the sessions in Session.h.
+ * The game threads call these with the current time, so the same code also runs
+ * off target against tools/netsim, see tools/netsim/gamesim.c.
+ */
+
+#ifndef NETGAME_H_
+#define NETGAME_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cc3100_usage.h"
+#include "GameTypes.h"
+#include "NetProtocol.h"
+#include "RateControl.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Time between join steps, ms, the reliable channels resend every step */
+#define NETGAME_JOIN_STEP_MS        20
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Game packets over the links open now, counts since each link was opened
+ */
+typedef struct
+{
+    uint32_t sent;                          // datagrams handed to the CC3100
+    uint32_t received;                      // intact datagrams from peers
+    uint32_t late;                          // datagrams that arrived after they were counted lost
+    uint32_t lost;                          // sequence numbers that never arrived in time
+    uint32_t duplicates;                    // reliable events received more than once
+    uint32_t lateSnapshots;                 // client: snapshots the jitter buffer had already drawn past
+    uint32_t inputsOverwritten;             // inputs dropped before they were acknowledged (client) or applied (host)
+    uint32_t srtt;                          // worst smoothed round trip of any link, ms
+    uint32_t loss;                          // worst smoothed loss of any link, per mille
+} TrafficStats_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets the role of this board and the state the network reads and updates
+ * self is only used by a client
+ */
+void NetGame_Init(playerType role, GameState_t *state, SpecificPlayerInfo_t *self);
+
+/*
+ * Sets up paddle i for its team, centered
+ */
+void NetGame_InitPlayer(uint8_t i);
+
+/*
+ * Hands a received datagram to the session of its sender
+ * The host opens sessions for new clients until the game starts, everything else from strangers is dropped
+ * Returns: how the packet parsed, NET_ERR_VERSION for a peer running another protocol version
+ */
+net_ErrCode_t NetGame_ReadPacket(uint32_t IP, const uint8_t *packet, int32_t len, uint32_t now);
+
+/*
+ * Host: frees every paddle but its own and starts taking join requests
+ */
+void NetGame_HostOpen();
+
+/*
+ * Host: drops silent clients and resends the join answers, call every NETGAME_JOIN_STEP_MS
+ * Returns: clients that are ready to play
+ */
+uint8_t NetGame_HostJoinStep(uint32_t now);
+
+/*
+ * Host: stops taking join requests and drops the clients that never got ready
+ */
+void NetGame_HostStart();
+
+/*
+ * Host: applies the clients' inputs, captures a snapshot and sends it to every client
+ * its rate controller allows, call every RATE_MIN_PERIOD_MS
+ */
+void NetGame_HostTick(uint32_t now);
+
+/*
+ * Host: queues an event for every client, or for none of them
+ * Returns: false if some client's reliable window was full, try again once acks have freed it
+ */
+bool NetGame_Broadcast(uint8_t type, const uint8_t *payload, uint8_t len);
+
+/*
+ * Host: queues an event of which only the newest value matters (NET_EVT_SCORE) for every client
+ * Never fails, a newer value replaces one still waiting for the window, see Rel_SendLatest
+ */
+void NetGame_BroadcastLatest(uint8_t type, const uint8_t *payload, uint8_t len);
+
+/*
+ * Host: true once every client has acknowledged every event, held ones included
+ */
+bool NetGame_EventsDelivered();
+
+/*
+ * Client: opens the session with the host and asks to join
+ */
+void NetGame_ClientOpen(uint32_t hostIP, uint32_t localIP, uint32_t now);
+
+/*
+ * Client: resends the join request, call every NETGAME_JOIN_STEP_MS
+ * Returns: true once the host has handed us a paddle, self->playerNumber
+ */
+bool NetGame_ClientJoinStep(uint32_t now);
+
+/*
+ * Client: tells the host we are ready, our paddle shows up in its next snapshot
+ */
+void NetGame_ClientReady(uint32_t now);
+
+/*
+ * Client: sends the unacknowledged inputs and due events to the host
+ * Returns: time until the next call, ms, from the rate controller
+ */
+uint32_t NetGame_ClientTick(uint32_t now);
+
+/*
+ * Client: moves our paddle now and queues the input for the host
+ * Inputs before the host's first snapshot are dropped, the game has not started
+ */
+void NetGame_ClientMove(int16_t displacement);
+
+/*
+ * Tells the session with IP that the CC3100 could not send to it: its due events go out again
+ * with the next bundle and its rate controller backs off, see Rel_OnSendFailed and Rate_OnSendFailed
+ * Called from the SimpleLink spawn thread, only takes a critical section
+ */
+void NetGame_SendFailed(uint32_t IP);
+
+/*
+ * Copies the send rate controller's view of a link
+ * The host has one link per client session (0 to MAX_SESSIONS - 1), a client only link 0 to the host
+ * Returns: false if there is no such link
+ */
+bool NetGame_GetRateStats(uint8_t link, RateStats_t *stats);
+
+/*
+ * Adds up the packet counters of every link, the round trip and loss are the worst link's
+ */
+void NetGame_GetTrafficStats(TrafficStats_t *stats);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* NETGAME_H_ */
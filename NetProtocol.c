@@ -0,0 +1,146 @@
+/*
+ * NetProtocol.c
+ */
+
+#include <string.h>
+#include "NetProtocol.h"
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * CRC-16/CCITT (poly 0x1021, init 0xFFFF)
+ */
+uint16_t Net_Crc16(const uint8_t *data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+    int i;
+
+    while(len--){
+        crc ^= (uint16_t)*data++ << 8;
+        for(i = 0; i < 8; i++){
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/*
+ * Writes the header and CRC around a payload already placed at buf + NET_HEADER_SIZE
+ * Returns: total packet length
+ */
+uint16_t Net_FinishPacket(uint8_t *buf, uint8_t type, uint16_t sequence, uint16_t payloadLen)
+{
+    uint8_t *p = buf;
+    uint16_t len = NET_HEADER_SIZE + payloadLen;
+
+    p = Net_PutU16(p, NET_MAGIC);
+    p = Net_PutU8(p, NET_PROTOCOL_VERSION);
+    p = Net_PutU8(p, type);
+    p = Net_PutU16(p, sequence);
+    Net_PutU16(p, payloadLen);
+
+    Net_PutU16(buf + len, Net_Crc16(buf, len));
+    return len + NET_CRC_SIZE;
+}
+
+/*
+ * Validates a received packet and reads its header
+ * The CRC is checked before the version so a damaged version byte is reported
+ * as corruption, not as a peer running a different build
+ */
+net_ErrCode_t Net_ParsePacket(const uint8_t *buf, uint16_t len, NetHeader_t *hdr)
+{
+    if(len < NET_OVERHEAD){
+        return NET_ERR_SHORT;
+    }
+    if(Net_GetU16(buf) != NET_MAGIC){
+        return NET_ERR_MAGIC;
+    }
+
+    hdr->version = Net_GetU8(buf + 2);
+    hdr->type = Net_GetU8(buf + 3);
+    hdr->sequence = Net_GetU16(buf + 4);
+    hdr->length = Net_GetU16(buf + 6);
+
+    if(hdr->length != len - NET_OVERHEAD){
+        return NET_ERR_LENGTH;
+    }
+    if(Net_GetU16(buf + NET_HEADER_SIZE + hdr->length) != Net_Crc16(buf, NET_HEADER_SIZE + hdr->length)){
+        return NET_ERR_CRC;
+    }
+    if(hdr->version != NET_PROTOCOL_VERSION){
+        return NET_ERR_VERSION;
+    }
+    return NET_OK;
+}
+
+/*
+ * Starts an empty bundle
+ */
+void Net_BundleBegin(NetBundle_t *bundle)
+{
+    bundle->length = 0;
+}
+
+/*
+ * Appends a message to a bundle
+ * Returns: false if it does not fit, the bundle is left unchanged
+ */
+bool Net_BundleAdd(NetBundle_t *bundle, uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    uint8_t *p = bundle->data + NET_HEADER_SIZE + bundle->length;
+
+    if(NET_OVERHEAD + bundle->length + NET_SUBMSG_HEADER_SIZE + len > NET_MAX_DATAGRAM){
+        return false;
+    }
+
+    p = Net_PutU8(p, type);
+    p = Net_PutU8(p, len);
+    memcpy(p, payload, len);
+    bundle->length += NET_SUBMSG_HEADER_SIZE + len;
+    return true;
+}
+
+/*
+ * Writes the header and CRC of a bundle, the datagram is then in bundle->data
+ * Returns: datagram length, 0 if the bundle is empty
+ */
+uint16_t Net_BundleFinish(NetBundle_t *bundle, uint16_t sequence)
+{
+    if(!bundle->length){
+        return 0;
+    }
+    return Net_FinishPacket(bundle->data, NET_MSG_BUNDLE, sequence, bundle->length);
+}
+
+/*
+ * Starts reading the messages of a bundle that passed Net_ParsePacket
+ */
+void Net_BundleOpen(NetBundleReader_t *reader, const uint8_t *packet, const NetHeader_t *hdr)
+{
+    reader->next = packet + NET_HEADER_SIZE;
+    reader->end = reader->next + hdr->length;
+}
+
+/*
+ * Reads the next message of a bundle
+ * Returns: false at the end of the bundle or if the next message is truncated
+ */
+bool Net_BundleNext(NetBundleReader_t *reader, uint8_t *type, const uint8_t **payload, uint16_t *len)
+{
+    if(reader->end - reader->next < NET_SUBMSG_HEADER_SIZE){
+        return false;
+    }
+
+    *type = Net_GetU8(reader->next);
+    *len = Net_GetU8(reader->next + 1);
+    if(reader->end - reader->next - NET_SUBMSG_HEADER_SIZE < *len){
+        return false;
+    }
+
+    *payload = reader->next + NET_SUBMSG_HEADER_SIZE;
+    reader->next = *payload + *len;
+    return true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,185 @@
+/*
+ * NetProtocol.h
+ *
+ * Wire format for every packet exchanged between host and client.
+ *
+ * Packet layout, all fields little endian:
+ *  - magic    (u16)  NET_MAGIC
+ *  - version  (u8)   NET_PROTOCOL_VERSION, packets from other versions are rejected
+ *  - type     (u8)   netMsgType
+ *  - sequence (u16)  per sender packet counter
+ *  - length   (u16)  payload length
+ *  - payload
+ *  - crc      (u16)  CRC-16/CCITT over header and payload
+ *
+ * Each tick's messages travel together in one NET_MSG_BUNDLE datagram whose payload is
+ * a list of sub-messages, each a type byte and a length byte followed by its payload.
+ *
+ * Structs are serialized field by field with the Net_Put/Net_Get helpers, so their
+ * in-memory layout (padding, enum and bool width) never reaches the wire.
+ */
+
+#ifndef NETPROTOCOL_H_
+#define NETPROTOCOL_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+#define NET_MAGIC                   0x3847      // "G8"
+#define NET_PROTOCOL_VERSION        6
+
+#define NET_HEADER_SIZE             8
+#define NET_CRC_SIZE                2
+#define NET_OVERHEAD                (NET_HEADER_SIZE + NET_CRC_SIZE)
+
+/* Largest datagram, must fit in the receive ring's RX_PACKET_SIZE */
+#define NET_MAX_DATAGRAM            128
+
+/* Type and length in front of each bundled message */
+#define NET_SUBMSG_HEADER_SIZE      2
+#define NET_SUBMSG_MAX_SIZE         (NET_MAX_DATAGRAM - NET_OVERHEAD - NET_SUBMSG_HEADER_SIZE)
+
+/* Wire sizes of the field types */
+#define NET_SIZE_U8                 1
+#define NET_SIZE_BOOL               1
+#define NET_SIZE_U16                2
+#define NET_SIZE_I16                2
+#define NET_SIZE_U32                4
+
+/* Wire size of a field list: 0 LIST(NET_FIELD_SIZE), see Telemetry.h */
+#define NET_FIELD_SIZE(type, name)  + NET_SIZE_##type
+
+/* Message types */
+typedef enum
+{
+    NET_MSG_SNAPSHOT = 1,           // Snapshot.h delta, host to client
+    NET_MSG_INPUT = 4,              // Input.h pending inputs, client to host
+    NET_MSG_BUNDLE = 5,             // Several of the above in one datagram
+    NET_MSG_ACK = 6,                // Reliable.h ack fields
+    NET_MSG_RELIABLE = 7,           // Reliable.h event
+    NET_MSG_TELEMETRY = 8           // Telemetry.h sample, broadcast to STATS_PORT, never sent to a peer
+} netMsgType;
+
+/* Events sent over the reliable channel */
+typedef enum
+{
+    NET_EVT_JOIN = 1,               // Client to host, client IP (u32)
+    NET_EVT_JOIN_ACK = 2,           // Host to client, paddle the client plays (u8)
+    NET_EVT_READY = 3,              // Client to host, no payload
+    NET_EVT_SCORE = 4,              // Host to client, LEDScores[2]
+    NET_EVT_GAME_OVER = 5           // Host to client, winner, overallScores[2]
+} netEventType;
+
+/* Packet validation results */
+typedef enum
+{
+    NET_OK              =  0,
+    NET_ERR_SHORT       = -1,
+    NET_ERR_MAGIC       = -2,
+    NET_ERR_VERSION     = -3,
+    NET_ERR_LENGTH      = -4,
+    NET_ERR_CRC         = -5
+} net_ErrCode_t;
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+typedef struct
+{
+    uint8_t version;
+    uint8_t type;
+    uint16_t sequence;
+    uint16_t length;
+} NetHeader_t;
+
+/*
+ * Datagram being built, messages are appended after room for the header
+ */
+typedef struct
+{
+    uint8_t data[NET_MAX_DATAGRAM];
+    uint16_t length;            // Payload bytes so far
+} NetBundle_t;
+
+/*
+ * Position in a received bundle
+ */
+typedef struct
+{
+    const uint8_t *next;
+    const uint8_t *end;
+} NetBundleReader_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Little endian field helpers, each returns the position after the field
+ */
+static inline uint8_t *Net_PutU8(uint8_t *p, uint8_t v)     { p[0] = v; return p + 1; }
+static inline uint8_t *Net_PutBOOL(uint8_t *p, bool v)      { p[0] = v ? 1 : 0; return p + 1; }
+static inline uint8_t *Net_PutU16(uint8_t *p, uint16_t v)   { p[0] = v; p[1] = v >> 8; return p + 2; }
+static inline uint8_t *Net_PutI16(uint8_t *p, int16_t v)    { return Net_PutU16(p, (uint16_t)v); }
+static inline uint8_t *Net_PutU32(uint8_t *p, uint32_t v)   { p = Net_PutU16(p, v); return Net_PutU16(p, v >> 16); }
+
+static inline uint8_t  Net_GetU8(const uint8_t *p)          { return p[0]; }
+static inline uint16_t Net_GetU16(const uint8_t *p)         { return p[0] | ((uint16_t)p[1] << 8); }
+static inline int16_t  Net_GetI16(const uint8_t *p)         { return (int16_t)Net_GetU16(p); }
+static inline uint32_t Net_GetU32(const uint8_t *p)         { return Net_GetU16(p) | ((uint32_t)Net_GetU16(p + 2) << 16); }
+
+/*
+ * CRC-16/CCITT (poly 0x1021, init 0xFFFF)
+ */
+uint16_t Net_Crc16(const uint8_t *data, uint16_t len);
+
+/*
+ * Writes the header and CRC around a payload already placed at buf + NET_HEADER_SIZE
+ * Returns: total packet length
+ */
+uint16_t Net_FinishPacket(uint8_t *buf, uint8_t type, uint16_t sequence, uint16_t payloadLen);
+
+/*
+ * Validates a received packet and reads its header
+ * A damaged packet is reported as NET_ERR_CRC whatever byte was hit, NET_ERR_VERSION
+ * only comes from an intact packet of another protocol version
+ * The payload starts at buf + NET_HEADER_SIZE and is hdr->length bytes long
+ */
+net_ErrCode_t Net_ParsePacket(const uint8_t *buf, uint16_t len, NetHeader_t *hdr);
+
+/*
+ * Starts an empty bundle
+ */
+void Net_BundleBegin(NetBundle_t *bundle);
+
+/*
+ * Appends a message to a bundle
+ * Returns: false if it does not fit, the bundle is left unchanged
+ */
+bool Net_BundleAdd(NetBundle_t *bundle, uint8_t type, const uint8_t *payload, uint16_t len);
+
+/*
+ * Writes the header and CRC of a bundle, the datagram is then in bundle->data
+ * Returns: datagram length, 0 if the bundle is empty
+ */
+uint16_t Net_BundleFinish(NetBundle_t *bundle, uint16_t sequence);
+
+/*
+ * Starts reading the messages of a bundle that passed Net_ParsePacket
+ */
+void Net_BundleOpen(NetBundleReader_t *reader, const uint8_t *packet, const NetHeader_t *hdr);
+
+/*
+ * Reads the next message of a bundle
+ * Returns: false at the end of the bundle or if the next message is truncated
+ */
+bool Net_BundleNext(NetBundleReader_t *reader, uint8_t *type, const uint8_t **payload, uint16_t *len);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* NETPROTOCOL_H_ */
@@ -0,0 +1,219 @@
+/*
+ * PixelKernels.c
+ */
+
+#include "PixelKernels.h"
+#if PK_USE_DSP
+#include "msp.h"
+#endif
+
+/************************************  Private Functions  *******************************************/
+
+/*
+ * True when a pointer can be accessed as 32-bit words
+ */
+static inline int WordAligned(const void *p)
+{
+    return (((uintptr_t)p) & 3) == 0;
+}
+
+/************************************  Private Functions  *******************************************/
+
+
+/************************************  Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : PK_Fill
+ * Description    : Fills a pixel buffer with a single color
+ * Input          : dst: destination, color: RGB565 color, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_Fill(uint16_t *dst, uint16_t color, uint32_t count)
+{
+#if PK_USE_DSP
+    uint32_t color2 = color | ((uint32_t)color << 16);
+    uint32_t *dst32;
+
+    //Get the destination onto a word boundary
+    if(count && !WordAligned(dst)){
+        *dst++ = color;
+        count--;
+    }
+
+    //Two pixels per store, unrolled by four stores
+    dst32 = (uint32_t *)dst;
+    while(count >= 8){
+        dst32[0] = color2;
+        dst32[1] = color2;
+        dst32[2] = color2;
+        dst32[3] = color2;
+        dst32 += 4;
+        count -= 8;
+    }
+    while(count >= 2){
+        *dst32++ = color2;
+        count -= 2;
+    }
+    dst = (uint16_t *)dst32;
+#endif
+    while(count--){
+        *dst++ = color;
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : PK_BlitTransparent
+ * Description    : Copies pixels, leaving the destination alone where src is the key color
+ * Input          : dst, src, count: number of pixels, key: transparent RGB565 color
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_BlitTransparent(uint16_t *dst, const uint16_t *src, uint32_t count, uint16_t key)
+{
+#if PK_USE_DSP
+    uint32_t key2 = key | ((uint32_t)key << 16);
+    uint32_t *dst32;
+    const uint32_t *src32;
+    uint32_t s;
+
+    //Word access needs both buffers on the same alignment
+    if(WordAligned(dst) == WordAligned(src)){
+        if(count && !WordAligned(dst)){
+            if(*src != key){
+                *dst = *src;
+            }
+            dst++;
+            src++;
+            count--;
+        }
+
+        dst32 = (uint32_t *)dst;
+        src32 = (const uint32_t *)src;
+        while(count >= 2){
+            //GE bits are set for halfwords equal to the key, SEL keeps dst there
+            s = *src32++;
+            (void)__USUB16(0, s ^ key2);
+            *dst32 = __SEL(*dst32, s);
+            dst32++;
+            count -= 2;
+        }
+        dst = (uint16_t *)dst32;
+        src = (const uint16_t *)src32;
+    }
+#endif
+    while(count--){
+        if(*src != key){
+            *dst = *src;
+        }
+        dst++;
+        src++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : PK_ExpandPalette
+ * Description    : Converts 8-bit palette indices to RGB565
+ * Input          : dst, src: indices, palette: RGB565 entries, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_ExpandPalette(uint16_t *dst, const uint8_t *src, const uint16_t *palette, uint32_t count)
+{
+#if PK_USE_DSP
+    uint32_t *dst32;
+
+    if(count && !WordAligned(dst)){
+        *dst++ = palette[*src++];
+        count--;
+    }
+
+    dst32 = (uint32_t *)dst;
+    while(count >= 2){
+        *dst32++ = palette[src[0]] | ((uint32_t)palette[src[1]] << 16);
+        src += 2;
+        count -= 2;
+    }
+    dst = (uint16_t *)dst32;
+#endif
+    while(count--){
+        *dst++ = palette[*src++];
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : PK_ExpandPaletteSwapped
+ * Description    : Converts 8-bit palette indices to byte-swapped RGB565
+ * Input          : dst, src: indices, palette: RGB565 entries, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : Output is in the big-endian order the ILI9325 expects on the wire
+ *******************************************************************************/
+void PK_ExpandPaletteSwapped(uint16_t *dst, const uint8_t *src, const uint16_t *palette, uint32_t count)
+{
+    uint16_t c;
+#if PK_USE_DSP
+    uint32_t *dst32;
+
+    if(count && !WordAligned(dst)){
+        c = palette[*src++];
+        *dst++ = (c << 8) | (c >> 8);
+        count--;
+    }
+
+    dst32 = (uint32_t *)dst;
+    while(count >= 2){
+        *dst32++ = __REV16(palette[src[0]] | ((uint32_t)palette[src[1]] << 16));
+        src += 2;
+        count -= 2;
+    }
+    dst = (uint16_t *)dst32;
+#endif
+    while(count--){
+        c = palette[*src++];
+        *dst++ = (c << 8) | (c >> 8);
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : PK_SwapBytes
+ * Description    : Byte-swaps every pixel, converting between CPU and LCD byte order
+ * Input          : dst, src, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : dst may equal src
+ *******************************************************************************/
+void PK_SwapBytes(uint16_t *dst, const uint16_t *src, uint32_t count)
+{
+    uint16_t c;
+#if PK_USE_DSP
+    uint32_t *dst32;
+    const uint32_t *src32;
+
+    if(WordAligned(dst) == WordAligned(src)){
+        if(count && !WordAligned(dst)){
+            c = *src++;
+            *dst++ = (c << 8) | (c >> 8);
+            count--;
+        }
+
+        dst32 = (uint32_t *)dst;
+        src32 = (const uint32_t *)src;
+        while(count >= 2){
+            *dst32++ = __REV16(*src32++);
+            count -= 2;
+        }
+        dst = (uint16_t *)dst32;
+        src = (const uint16_t *)src32;
+    }
+#endif
+    while(count--){
+        c = *src++;
+        *dst++ = (c << 8) | (c >> 8);
+    }
+}
+
+/************************************  Public Functions  *******************************************/
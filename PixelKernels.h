@@ -0,0 +1,80 @@
+/*
+ * PixelKernels.h
+ *
+ * RGB565 pixel kernels for pixel data built in RAM before it is sent to the LCD.
+ * On a Cortex-M4 with the DSP extension two pixels are processed per 32-bit word
+ * (REV16, SEL, USUB16); everywhere else a portable C version is used. tools/pktest
+ * checks one against the other.
+ */
+
+#ifndef PIXELKERNELS_H_
+#define PIXELKERNELS_H_
+
+#include <stdint.h>
+
+/************************************ Defines *******************************************/
+
+/* Select the kernel implementation at compile time, define PK_FORCE_PORTABLE to skip the DSP path */
+#if defined(__ARM_FEATURE_DSP) && !defined(PK_FORCE_PORTABLE)
+#define PK_USE_DSP          1
+#else
+#define PK_USE_DSP          0
+#endif
+
+/************************************ Defines *******************************************/
+
+/************************************ Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : PK_Fill
+ * Description    : Fills a pixel buffer with a single color
+ * Input          : dst: destination, color: RGB565 color, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_Fill(uint16_t *dst, uint16_t color, uint32_t count);
+
+/*******************************************************************************
+ * Function Name  : PK_BlitTransparent
+ * Description    : Copies pixels, leaving the destination alone where src is the key color
+ * Input          : dst, src, count: number of pixels, key: transparent RGB565 color
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_BlitTransparent(uint16_t *dst, const uint16_t *src, uint32_t count, uint16_t key);
+
+/*******************************************************************************
+ * Function Name  : PK_ExpandPalette
+ * Description    : Converts 8-bit palette indices to RGB565
+ * Input          : dst, src: indices, palette: RGB565 entries, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : None
+ *******************************************************************************/
+void PK_ExpandPalette(uint16_t *dst, const uint8_t *src, const uint16_t *palette, uint32_t count);
+
+/*******************************************************************************
+ * Function Name  : PK_ExpandPaletteSwapped
+ * Description    : Converts 8-bit palette indices to byte-swapped RGB565
+ * Input          : dst, src: indices, palette: RGB565 entries, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : Output is in the big-endian order the ILI9325 expects on the wire
+ *******************************************************************************/
+void PK_ExpandPaletteSwapped(uint16_t *dst, const uint8_t *src, const uint16_t *palette, uint32_t count);
+
+/*******************************************************************************
+ * Function Name  : PK_SwapBytes
+ * Description    : Byte-swaps every pixel, converting between CPU and LCD byte order
+ * Input          : dst, src, count: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : dst may equal src
+ *******************************************************************************/
+void PK_SwapBytes(uint16_t *dst, const uint16_t *src, uint32_t count);
+
+/************************************ Public Functions  *******************************************/
+
+#endif /* PIXELKERNELS_H_ */
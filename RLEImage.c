@@ -0,0 +1,66 @@
+/*
+ * RLEImage.c
+ */
+
+#include "RLEImage.h"
+#include "PixelKernels.h"
+#include "msp.h"
+#include "driverlib.h"
+
+/************************************  Private Functions  *******************************************/
+
+/*
+ * Sends the same pixel count times into an open GRAM stream
+ */
+static void WriteSolidRun(uint16_t color, uint16_t count)
+{
+    uint8_t hi = color >> 8;
+    uint8_t lo = color & 0xff;
+    while(count--){
+        SPI_transmitData(EUSCI_B3_BASE, hi);
+        SPI_transmitData(EUSCI_B3_BASE, lo);
+    }
+}
+
+/************************************  Private Functions  *******************************************/
+
+
+/************************************  Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : RLE_DrawImage
+ * Description    : Decodes an RLE image straight into GRAM
+ * Input          : Xpos, Ypos: top left corner, image: encoded image
+ * Output         : None
+ * Return         : None
+ * Attention      : Image must fit on the screen, caller must own the screen
+ *******************************************************************************/
+void RLE_DrawImage(uint16_t Xpos, uint16_t Ypos, const RLEImage_t *image)
+{
+    const uint8_t *data = image->data;
+    const uint8_t *end = image->data + image->length;
+    uint16_t line[RLE_MAX_PACKET];
+    uint8_t header;
+    uint16_t count;
+
+    //The window wraps rows for us, so the stream can be sent as is
+    LCD_SetWindow(Xpos, Xpos + image->width, Ypos, Ypos + image->height);
+    LCD_WriteGRAMStart();
+
+    while(data < end){
+        header = *data++;
+        count = (header & RLE_LENGTH_MASK) + 1;
+
+        if(header & RLE_RUN_FLAG){
+            WriteSolidRun(image->palette[*data++], count);
+        } else {
+            PK_ExpandPaletteSwapped(line, data, image->palette, count);
+            LCD_WriteGRAMBuffer(line, count);
+            data += count;
+        }
+    }
+
+    LCD_WriteGRAMEnd();
+}
+
+/************************************  Public Functions  *******************************************/
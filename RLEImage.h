@@ -0,0 +1,53 @@
+/*
+ * RLEImage.h
+ *
+ * Palette + run-length encoded images kept in flash and streamed straight into a GRAM window.
+ * Images are produced offline with tools/rle_convert.py.
+ *
+ * Encoded data is a sequence of packets, each starting with a header byte:
+ *  - bit 7 set:   solid run, (header & 0x7F) + 1 pixels of the palette index in the next byte
+ *  - bit 7 clear: literal,   (header & 0x7F) + 1 palette indices follow
+ * Pixels run left to right, top to bottom, and packets may cross rows.
+ */
+
+#ifndef RLEIMAGE_H_
+#define RLEIMAGE_H_
+
+#include <stdint.h>
+#include "LCDLib.h"
+
+/************************************ Defines *******************************************/
+
+#define RLE_RUN_FLAG        0x80
+#define RLE_LENGTH_MASK     0x7F
+#define RLE_MAX_PACKET      128
+
+/************************************ Defines *******************************************/
+
+/********************************** Structures ******************************************/
+typedef struct
+{
+    uint16_t width;
+    uint16_t height;
+    uint16_t paletteSize;
+    const uint16_t *palette;    // RGB565 colors
+    uint32_t length;            // bytes of encoded data
+    const uint8_t *data;
+}RLEImage_t;
+/********************************** Structures ******************************************/
+
+/************************************ Public Functions  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : RLE_DrawImage
+ * Description    : Decodes an RLE image straight into GRAM
+ * Input          : Xpos, Ypos: top left corner, image: encoded image
+ * Output         : None
+ * Return         : None
+ * Attention      : Image must fit on the screen, caller must own the screen
+ *******************************************************************************/
+void RLE_DrawImage(uint16_t Xpos, uint16_t Ypos, const RLEImage_t *image);
+
+/************************************ Public Functions  *******************************************/
+
+#endif /* RLEIMAGE_H_ */
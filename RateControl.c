@@ -0,0 +1,194 @@
+/*
+ * RateControl.c
+ */
+
+#include <string.h>
+#include "RateControl.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+static inline bool SentValid(const RateControl_t *rc, uint8_t slot)
+{
+    return rc->sentValid[slot >> 3] & (1 << (slot & 7));
+}
+
+/*
+ * Folds a loss sample for the interval that just ended into the estimate
+ */
+static void LossSample(RateControl_t *rc)
+{
+    uint16_t expected = rc->highestReceived - rc->intervalStart + 1;
+    uint32_t lost;
+
+    //Nothing at all is an outage, duplicates and late packets can push the count over what was expected
+    if(!rc->receivedCount){
+        lost = 1000;
+    } else {
+        lost = rc->receivedCount >= expected ? 0 : (uint32_t)(expected - rc->receivedCount) * 1000 / expected;
+    }
+    rc->stats.loss = (3 * rc->stats.loss + lost) / 4;
+    if(rc->receivedCount < expected){
+        rc->stats.lost += expected - rc->receivedCount;
+    }
+
+    rc->intervalStart = rc->highestReceived + 1;
+    rc->receivedCount = 0;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a controller at the fastest rate
+ */
+void Rate_Init(RateControl_t *rc, uint32_t now)
+{
+    memset(rc, 0, sizeof(*rc));
+    rc->stats.period = RATE_MIN_PERIOD_MS;
+    rc->windowMinRtt = UINT32_MAX;
+    rc->lastUpdate = now;
+}
+
+/*
+ * Records the send time of the packet carrying sequence seq
+ * Only the first send of a sequence counts, resends give ambiguous samples
+ */
+void Rate_OnSend(RateControl_t *rc, uint16_t seq, uint32_t now)
+{
+    uint8_t slot = seq % RATE_HISTORY;
+
+    if(rc->anySent && seq == rc->lastSent){
+        return;
+    }
+
+    rc->sentSequence[slot] = seq;
+    rc->sentTime[slot] = now;
+    rc->sentValid[slot >> 3] |= 1 << (slot & 7);
+    rc->anySent = true;
+    rc->lastSent = seq;
+}
+
+/*
+ * Takes a round trip sample when the peer acknowledges sequence seq
+ */
+void Rate_OnAck(RateControl_t *rc, uint16_t seq, uint32_t now)
+{
+    uint8_t slot = seq % RATE_HISTORY;
+    uint32_t rtt, err;
+
+    //Only the first ack of a newer packet we still have a send time for
+    if((rc->anyAcked && (int16_t)(seq - rc->lastAcked) <= 0) ||
+            !SentValid(rc, slot) || rc->sentSequence[slot] != seq){
+        return;
+    }
+    rc->anyAcked = true;
+    rc->lastAcked = seq;
+    rc->sentValid[slot >> 3] &= ~(1 << (slot & 7));
+
+    rtt = now - rc->sentTime[slot];
+    if(!rc->stats.rttSamples){
+        rc->stats.srtt = rtt;
+        rc->stats.rttvar = rtt / 2;
+        rc->stats.minRtt = rtt;
+    } else {
+        err = rc->stats.srtt > rtt ? rc->stats.srtt - rtt : rtt - rc->stats.srtt;
+        rc->stats.rttvar = (3 * rc->stats.rttvar + err) / 4;
+        rc->stats.srtt = (7 * rc->stats.srtt + rtt) / 8;
+        if(rtt < rc->stats.minRtt){
+            rc->stats.minRtt = rtt;
+        }
+    }
+    if(rtt < rc->windowMinRtt){
+        rc->windowMinRtt = rtt;
+    }
+    rc->stats.rttSamples++;
+}
+
+/*
+ * Counts a packet received from the peer with header sequence seq
+ */
+void Rate_OnReceive(RateControl_t *rc, uint16_t seq)
+{
+    rc->stats.received++;
+    if(!rc->anyReceived){
+        rc->anyReceived = true;
+        rc->highestReceived = seq;
+        rc->intervalStart = seq;
+    } else if((int16_t)(seq - rc->highestReceived) > 0){
+        rc->highestReceived = seq;
+    } else if((int16_t)(seq - rc->intervalStart) < 0){
+        //Belongs to an interval already counted
+        rc->stats.late++;
+        return;
+    }
+    rc->receivedCount++;
+}
+
+/*
+ * Counts a packet to the peer that the device could not send, the next update backs off
+ */
+void Rate_OnSendFailed(RateControl_t *rc)
+{
+    rc->stats.sendFailures++;
+    rc->sendFailed = true;
+}
+
+/*
+ * Runs the controller once RATE_INTERVAL_MS has passed
+ * Returns: the send period to use, ms
+ */
+uint32_t Rate_Update(RateControl_t *rc, uint32_t now)
+{
+    RateStats_t *s = &rc->stats;
+    bool congested;
+
+    if(now - rc->lastUpdate < RATE_INTERVAL_MS){
+        return s->period;
+    }
+    rc->lastUpdate = now;
+
+    if(rc->anyReceived){
+        LossSample(rc);
+    }
+
+    //Acks wait for the peer's next packet, so single samples swing by a whole send period
+    //Queueing shows when even the best sample of an interval stays above the minimum
+    //A failed send means the device is out of buffers or cannot reach the peer
+    congested = s->loss > RATE_LOSS_HIGH || rc->sendFailed ||
+            (rc->windowMinRtt != UINT32_MAX && rc->windowMinRtt > s->minRtt + RATE_QUEUE_DELAY_MS);
+    rc->sendFailed = false;
+
+    //Forget an old minimum now and then, it may belong to a route that is gone
+    if(++rc->minRttAge >= RATE_MIN_RTT_INTERVALS && rc->windowMinRtt != UINT32_MAX){
+        s->minRtt = rc->windowMinRtt;
+        rc->minRttAge = 0;
+    }
+    rc->windowMinRtt = UINT32_MAX;
+
+    if(congested){
+        if(s->period < RATE_MAX_PERIOD_MS){
+            s->period = s->period * 3 / 2;
+            if(s->period > RATE_MAX_PERIOD_MS){
+                s->period = RATE_MAX_PERIOD_MS;
+            }
+            s->backoffs++;
+        }
+    } else if(s->loss < RATE_LOSS_LOW && s->period > RATE_MIN_PERIOD_MS){
+        s->period = s->period - RATE_STEP_MS < RATE_MIN_PERIOD_MS ? RATE_MIN_PERIOD_MS : s->period - RATE_STEP_MS;
+        s->speedups++;
+    }
+
+    return s->period;
+}
+
+/*
+ * Copies the controller state
+ */
+void Rate_GetStats(const RateControl_t *rc, RateStats_t *stats)
+{
+    *stats = rc->stats;
+}
+
+/*********************************************** Public Functions *********************************************************************/
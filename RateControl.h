@@ -0,0 +1,140 @@
+/*
+ * RateControl.h
+ *
+ * Adapts how often a board sends to the quality of the link to its peer.
+ * The round trip time comes from acks of the packets we send (snapshot acks on the
+ * host, input acks on the client), the loss rate from gaps in the header sequence
+ * numbers of the packets we receive, assuming the link loses about as much in both
+ * directions. Every RATE_INTERVAL_MS the send period is raised multiplicatively when
+ * loss is high or the round trip grows past its minimum (queues building up), and
+ * lowered additively when the link is clean.
+ */
+
+#ifndef RATECONTROL_H_
+#define RATECONTROL_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Send period bounds, ms */
+#define RATE_MIN_PERIOD_MS          20
+#define RATE_MAX_PERIOD_MS          100
+
+/* Time between controller decisions, ms */
+#define RATE_INTERVAL_MS            500
+
+/* Loss above RATE_LOSS_HIGH backs off, below RATE_LOSS_LOW allows speeding up, per mille */
+#define RATE_LOSS_HIGH              100
+#define RATE_LOSS_LOW               20
+
+/* Round trip growth over the minimum that counts as queueing, ms */
+#define RATE_QUEUE_DELAY_MS         40
+
+/* Additive step when speeding up, ms */
+#define RATE_STEP_MS                2
+
+/* Intervals after which the minimum round trip is measured afresh, follows route changes */
+#define RATE_MIN_RTT_INTERVALS      20
+
+/* Send times kept for matching acks, power of two */
+#define RATE_HISTORY                32
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Controller state, times in ms, loss in per mille
+ */
+typedef struct
+{
+    uint32_t period;            // current send period
+    uint32_t srtt;              // smoothed round trip time, 0 before the first sample
+    uint32_t rttvar;
+    uint32_t minRtt;
+    uint32_t loss;              // smoothed loss of received packets
+    uint32_t rttSamples;
+    uint32_t backoffs;          // times the period was raised
+    uint32_t speedups;          // times the period was lowered
+    uint32_t received;          // packets received from the peer
+    uint32_t lost;              // sequence numbers missing when their interval ended
+    uint32_t late;              // packets that arrived after their interval had counted them lost
+    uint32_t sendFailures;      // our packets the device reported it could not send
+} RateStats_t;
+
+/*
+ * One peer's controller
+ */
+typedef struct
+{
+    /* Send times of our packets, by sequence */
+    uint16_t sentSequence[RATE_HISTORY];
+    uint32_t sentTime[RATE_HISTORY];
+    uint8_t sentValid[RATE_HISTORY / 8];
+    bool anySent;
+    uint16_t lastSent;
+    bool anyAcked;
+    uint16_t lastAcked;
+
+    /* Sequence numbers received from the peer this interval */
+    bool anyReceived;
+    uint16_t highestReceived;
+    uint16_t intervalStart;     // first sequence expected this interval
+    uint16_t receivedCount;
+
+    uint32_t windowMinRtt;      // smallest sample this interval
+    bool sendFailed;            // the device failed a send this interval
+    uint8_t minRttAge;          // intervals since minRtt was refreshed
+    uint32_t lastUpdate;
+
+    RateStats_t stats;
+} RateControl_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a controller at the fastest rate
+ */
+void Rate_Init(RateControl_t *rc, uint32_t now);
+
+/*
+ * Records the send time of the packet carrying sequence seq
+ * Only the first send of a sequence counts, resends give ambiguous samples
+ */
+void Rate_OnSend(RateControl_t *rc, uint16_t seq, uint32_t now);
+
+/*
+ * Takes a round trip sample when the peer acknowledges sequence seq
+ */
+void Rate_OnAck(RateControl_t *rc, uint16_t seq, uint32_t now);
+
+/*
+ * Counts a packet received from the peer with header sequence seq
+ */
+void Rate_OnReceive(RateControl_t *rc, uint16_t seq);
+
+/*
+ * Counts a packet to the peer that the device could not send, the next update backs off
+ */
+void Rate_OnSendFailed(RateControl_t *rc);
+
+/*
+ * Runs the controller once RATE_INTERVAL_MS has passed
+ * Returns: the send period to use, ms
+ */
+uint32_t Rate_Update(RateControl_t *rc, uint32_t now);
+
+/*
+ * Copies the controller state
+ */
+void Rate_GetStats(const RateControl_t *rc, RateStats_t *stats);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* RATECONTROL_H_ */
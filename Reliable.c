@@ -0,0 +1,338 @@
+/*
+ * Reliable.c
+ */
+
+#include <string.h>
+#include "Reliable.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Updates the round trip estimate with a new sample (RFC 6298)
+ */
+static void RttSample(ReliableChannel_t *ch, uint32_t rtt)
+{
+    uint32_t err;
+
+    if(!ch->rttValid){
+        ch->srtt = rtt;
+        ch->rttvar = rtt / 2;
+        ch->rttValid = true;
+    } else {
+        err = ch->srtt > rtt ? ch->srtt - rtt : rtt - ch->srtt;
+        ch->rttvar = (3 * ch->rttvar + err) / 4;
+        ch->srtt = (7 * ch->srtt + rtt) / 8;
+    }
+
+    ch->rto = ch->srtt + 4 * ch->rttvar;
+    if(ch->rto < REL_MIN_RTO){
+        ch->rto = REL_MIN_RTO;
+    } else if(ch->rto > REL_MAX_RTO){
+        ch->rto = REL_MAX_RTO;
+    }
+    ch->stats.srtt = ch->srtt;
+    ch->stats.rto = ch->rto;
+}
+
+/*
+ * Queues the held event once the window has room for it
+ */
+static void QueueHeld(ReliableChannel_t *ch)
+{
+    if(ch->held.used && Rel_Space(ch)){
+        ch->held.used = false;
+        Rel_Send(ch, ch->held.type, ch->held.payload, ch->held.length);
+    }
+}
+
+/*
+ * Applies an ack to the send side
+ */
+static void HandleAck(ReliableChannel_t *ch, uint16_t ack, uint32_t bits, uint32_t now)
+{
+    RelEvent_t *ev;
+    uint16_t diff;
+    int i;
+
+    for(i = 0; i < REL_WINDOW; i++){
+        ev = &ch->outgoing[i];
+        if(!ev->used || !ev->sends){
+            continue;
+        }
+
+        diff = ack - ev->sequence;
+        if(diff == 0 || (diff <= 32 && (bits & (1UL << (diff - 1))))){
+            //Karn: only events sent once give an unambiguous sample
+            if(ev->sends == 1){
+                RttSample(ch, now - ev->firstSent);
+            }
+            ev->used = false;
+        }
+    }
+
+    while(ch->oldestUnacked != ch->nextSequence && !ch->outgoing[ch->oldestUnacked % REL_WINDOW].used){
+        ch->oldestUnacked++;
+    }
+    QueueHeld(ch);
+}
+
+/*
+ * Records a received sequence in the ack fields
+ */
+static void MarkReceived(ReliableChannel_t *ch, uint16_t seq)
+{
+    int16_t diff;
+
+    if(!ch->received){
+        ch->received = true;
+        ch->ackSequence = seq;
+        ch->ackBits = 0;
+        return;
+    }
+
+    diff = seq - ch->ackSequence;
+    if(diff > 0){
+        ch->ackBits = diff > 32 ? 0 : (ch->ackBits << diff);
+        if(diff <= 32){
+            ch->ackBits |= 1UL << (diff - 1);
+        }
+        ch->ackSequence = seq;
+    } else if(diff < 0 && diff >= -32){
+        ch->ackBits |= 1UL << (-diff - 1);
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Resets both directions of a channel
+ */
+void Rel_Init(ReliableChannel_t *ch)
+{
+    memset(ch, 0, sizeof(*ch));
+    ch->rto = REL_INITIAL_RTO;
+    ch->stats.rto = REL_INITIAL_RTO;
+}
+
+/*
+ * Queues an event for reliable, ordered delivery
+ * Returns: false if the window is full or the payload is too long
+ */
+bool Rel_Send(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    RelEvent_t *ev;
+
+    if(len > REL_MAX_PAYLOAD){
+        return false;
+    }
+    if(!Rel_Space(ch)){
+        ch->stats.full++;
+        return false;
+    }
+
+    ev = &ch->outgoing[ch->nextSequence % REL_WINDOW];
+    ev->used = true;
+    ev->sequence = ch->nextSequence++;
+    ev->type = type;
+    ev->length = len;
+    memcpy(ev->payload, payload, len);
+    ev->sends = 0;
+
+    ch->stats.sent++;
+    return true;
+}
+
+/*
+ * Queues an event of which only the newest value matters
+ * Replaces the newest queued event if it has the same type and was not sent yet. When the window
+ * is full the event is held, replacing any held before it, and queued once an ack frees a slot.
+ */
+void Rel_SendLatest(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    RelEvent_t *ev = &ch->outgoing[(uint16_t)(ch->nextSequence - 1) % REL_WINDOW];
+
+    if(len > REL_MAX_PAYLOAD){
+        return;
+    }
+
+    //Only the newest queued event, replacing an older one would reorder it past the events after it
+    if(ch->held.used){
+        ev = &ch->held;
+    } else if(ch->nextSequence == ch->oldestUnacked || !ev->used || ev->sends || ev->type != type){
+        ev = NULL;
+    }
+
+    if(ev && ev->type == type){
+        ev->length = len;
+        memcpy(ev->payload, payload, len);
+        ch->stats.replaced++;
+    } else if(Rel_Space(ch)){
+        Rel_Send(ch, type, payload, len);
+    } else {
+        if(ch->held.used){
+            ch->stats.replaced++;
+        }
+        ch->held.used = true;
+        ch->held.type = type;
+        ch->held.length = len;
+        memcpy(ch->held.payload, payload, len);
+    }
+}
+
+/*
+ * Returns: events Rel_Send can queue now
+ */
+uint8_t Rel_Space(const ReliableChannel_t *ch)
+{
+    return REL_WINDOW - (uint16_t)(ch->nextSequence - ch->oldestUnacked);
+}
+
+/*
+ * Adds the ack and every event due for (re)transmission to a bundle
+ * Events that do not fit wait for the next bundle
+ */
+void Rel_Write(ReliableChannel_t *ch, NetBundle_t *bundle, uint32_t now)
+{
+    uint8_t msg[REL_HEADER_SIZE + REL_MAX_PAYLOAD];
+    uint8_t *p;
+    RelEvent_t *ev;
+    uint32_t timeout;
+    uint16_t seq;
+
+    if(ch->received){
+        p = Net_PutU16(msg, ch->ackSequence);
+        Net_PutU32(p, ch->ackBits);
+        Net_BundleAdd(bundle, NET_MSG_ACK, msg, REL_ACK_SIZE);
+    }
+
+    //Oldest first, so events go out in order whenever they fit
+    for(seq = ch->oldestUnacked; seq != ch->nextSequence; seq++){
+        ev = &ch->outgoing[seq % REL_WINDOW];
+        if(!ev->used){
+            continue;
+        }
+
+        if(ev->sends && !ch->resendNow){
+            timeout = ch->rto << (ev->sends - 1 < REL_MAX_BACKOFF ? ev->sends - 1 : REL_MAX_BACKOFF);
+            if(now - ev->lastSent < timeout){
+                continue;
+            }
+        }
+
+        p = Net_PutU16(msg, ev->sequence);
+        p = Net_PutU8(p, ev->type);
+        memcpy(p, ev->payload, ev->length);
+        if(!Net_BundleAdd(bundle, NET_MSG_RELIABLE, msg, REL_HEADER_SIZE + ev->length)){
+            break;
+        }
+
+        if(ev->sends){
+            ch->stats.retransmits++;
+        } else {
+            ev->firstSent = now;
+        }
+        if(ev->sends < 0xFF){
+            ev->sends++;
+        }
+        ev->lastSent = now;
+    }
+    ch->resendNow = false;
+}
+
+/*
+ * The device could not send a datagram to the peer, every unacked event goes
+ * out again with the next Rel_Write instead of after its timeout
+ */
+void Rel_OnSendFailed(ReliableChannel_t *ch)
+{
+    ch->stats.sendFailures++;
+    ch->resendNow = true;
+}
+
+/*
+ * Handles a NET_MSG_RELIABLE or NET_MSG_ACK message from a received bundle
+ * Other message types are ignored
+ */
+void Rel_Read(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint16_t len, uint32_t now)
+{
+    RelEvent_t *ev;
+    uint16_t seq;
+    uint16_t ahead;
+
+    if(type == NET_MSG_ACK && len == REL_ACK_SIZE){
+        HandleAck(ch, Net_GetU16(payload), Net_GetU32(payload + 2), now);
+        return;
+    }
+
+    if(type != NET_MSG_RELIABLE || len < REL_HEADER_SIZE || len > REL_HEADER_SIZE + REL_MAX_PAYLOAD){
+        return;
+    }
+
+    seq = Net_GetU16(payload);
+    ahead = seq - ch->nextDeliver;
+
+    //Already delivered or beyond the window, the ack tells the sender to stop
+    if(ahead >= REL_WINDOW){
+        if((int16_t)ahead < 0){
+            MarkReceived(ch, seq);
+            ch->stats.duplicates++;
+        }
+        return;
+    }
+
+    MarkReceived(ch, seq);
+    ev = &ch->incoming[seq % REL_WINDOW];
+    if(ev->used){
+        ch->stats.duplicates++;
+        return;
+    }
+
+    ev->used = true;
+    ev->sequence = seq;
+    ev->type = Net_GetU8(payload + 2);
+    ev->length = len - REL_HEADER_SIZE;
+    memcpy(ev->payload, payload + REL_HEADER_SIZE, ev->length);
+}
+
+/*
+ * Takes the next event in order, payload must hold REL_MAX_PAYLOAD bytes
+ * Returns: false if the next event has not arrived yet
+ */
+bool Rel_Deliver(ReliableChannel_t *ch, uint8_t *type, uint8_t *payload, uint8_t *len)
+{
+    RelEvent_t *ev = &ch->incoming[ch->nextDeliver % REL_WINDOW];
+
+    if(!ev->used || ev->sequence != ch->nextDeliver){
+        return false;
+    }
+
+    *type = ev->type;
+    *len = ev->length;
+    memcpy(payload, ev->payload, ev->length);
+
+    ev->used = false;
+    ch->nextDeliver++;
+    ch->stats.delivered++;
+    return true;
+}
+
+/*
+ * True once every queued and held event has been acknowledged
+ */
+bool Rel_Idle(const ReliableChannel_t *ch)
+{
+    return ch->oldestUnacked == ch->nextSequence && !ch->held.used;
+}
+
+/*
+ * Copies the channel statistics
+ */
+void Rel_GetStats(const ReliableChannel_t *ch, RelStats_t *stats)
+{
+    *stats = ch->stats;
+}
+
+/*********************************************** Public Functions *********************************************************************/
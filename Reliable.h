@@ -0,0 +1,173 @@
+/*
+ * Reliable.h
+ *
+ * Reliable, ordered event channel carried inside the unreliable bundles.
+ * Events get their own sequence numbers and are resent until the peer acknowledges them,
+ * so a lost datagram delays only the events in it and never holds back the state stream.
+ *
+ * Bundle messages, little endian:
+ *  - NET_MSG_RELIABLE: sequence (u16), event type (u8), event payload
+ *  - NET_MSG_ACK:      newest sequence received (u16), bit n set if sequence - 1 - n was also received (u32)
+ *
+ * Each unacknowledged event is resent once its retransmit timeout expires. The timeout
+ * follows the smoothed round trip time (Jacobson/Karn) and doubles with each resend.
+ *
+ * Events whose newest value is all that matters (scores) go through Rel_SendLatest: a newer
+ * value replaces one not sent yet, and waits in the channel instead of failing when the window is full.
+ */
+
+#ifndef RELIABLE_H_
+#define RELIABLE_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "NetProtocol.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Events in flight in each direction, at most 32 so the ack bitfield covers the window */
+#define REL_WINDOW                  8
+
+/* Largest event payload */
+#define REL_MAX_PAYLOAD             8
+
+/* Retransmit timeout bounds and starting value, ms */
+#define REL_MIN_RTO                 40
+#define REL_MAX_RTO                 1000
+#define REL_INITIAL_RTO             200
+
+/* Resends after which the timeout stops doubling */
+#define REL_MAX_BACKOFF             4
+
+#define REL_HEADER_SIZE             3
+#define REL_ACK_SIZE                6
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Event waiting for an ack (send side) or for delivery (receive side)
+ */
+typedef struct
+{
+    bool used;
+    uint16_t sequence;
+    uint8_t type;
+    uint8_t length;
+    uint8_t payload[REL_MAX_PAYLOAD];
+    uint8_t sends;              // Times sent, 0 until first written
+    uint32_t firstSent;         // ms
+    uint32_t lastSent;          // ms
+} RelEvent_t;
+
+/*
+ * Channel statistics, times in ms
+ */
+typedef struct
+{
+    uint32_t sent;              // events queued
+    uint32_t retransmits;       // resends after a timeout
+    uint32_t delivered;         // events handed to the application
+    uint32_t duplicates;        // events received more than once
+    uint32_t full;              // Rel_Send calls refused because the window was full
+    uint32_t replaced;          // Rel_SendLatest values replaced by a newer one before they were sent
+    uint32_t sendFailures;      // datagrams to the peer the device reported it could not send
+    uint32_t srtt;              // smoothed round trip time
+    uint32_t rto;               // current retransmit timeout
+} RelStats_t;
+
+/*
+ * One end of a reliable channel
+ */
+typedef struct
+{
+    /* Send side */
+    RelEvent_t outgoing[REL_WINDOW];
+    uint16_t nextSequence;      // Sequence of the next queued event
+    uint16_t oldestUnacked;
+    RelEvent_t held;            // Rel_SendLatest event waiting for room in the window
+    bool resendNow;             // The device dropped a datagram, resend without waiting for the timeout
+
+    /* Receive side */
+    RelEvent_t incoming[REL_WINDOW];
+    uint16_t nextDeliver;       // Sequence the application gets next
+    bool received;              // Anything received yet, ack fields are valid
+    uint16_t ackSequence;       // Newest sequence received
+    uint32_t ackBits;
+
+    /* Round trip estimate */
+    bool rttValid;
+    uint32_t srtt;
+    uint32_t rttvar;
+    uint32_t rto;
+
+    RelStats_t stats;
+} ReliableChannel_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Resets both directions of a channel
+ */
+void Rel_Init(ReliableChannel_t *ch);
+
+/*
+ * Queues an event for reliable, ordered delivery
+ * Returns: false if the window is full or the payload is too long
+ */
+bool Rel_Send(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint8_t len);
+
+/*
+ * Queues an event of which only the newest value matters
+ * Replaces the newest queued event if it has the same type and was not sent yet. When the window
+ * is full the event is held, replacing any held before it, and queued once an ack frees a slot.
+ */
+void Rel_SendLatest(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint8_t len);
+
+/*
+ * Returns: events Rel_Send can queue now
+ */
+uint8_t Rel_Space(const ReliableChannel_t *ch);
+
+/*
+ * Adds the ack and every event due for (re)transmission to a bundle
+ * Events that do not fit wait for the next bundle
+ */
+void Rel_Write(ReliableChannel_t *ch, NetBundle_t *bundle, uint32_t now);
+
+/*
+ * The device could not send a datagram to the peer, every unacked event goes
+ * out again with the next Rel_Write instead of after its timeout
+ */
+void Rel_OnSendFailed(ReliableChannel_t *ch);
+
+/*
+ * Handles a NET_MSG_RELIABLE or NET_MSG_ACK message from a received bundle
+ * Other message types are ignored
+ */
+void Rel_Read(ReliableChannel_t *ch, uint8_t type, const uint8_t *payload, uint16_t len, uint32_t now);
+
+/*
+ * Takes the next event in order, payload must hold REL_MAX_PAYLOAD bytes
+ * Returns: false if the next event has not arrived yet
+ */
+bool Rel_Deliver(ReliableChannel_t *ch, uint8_t *type, uint8_t *payload, uint8_t *len);
+
+/*
+ * True once every queued and held event has been acknowledged
+ */
+bool Rel_Idle(const ReliableChannel_t *ch);
+
+/*
+ * Copies the channel statistics
+ */
+void Rel_GetStats(const ReliableChannel_t *ch, RelStats_t *stats);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* RELIABLE_H_ */
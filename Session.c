@@ -0,0 +1,107 @@
+/*
+ * Session.c
+ */
+
+#include <string.h>
+#include "Session.h"
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Host: client sessions, slot n plays paddle n + 1 */
+static Session_t sessions[MAX_SESSIONS];
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Resets a session for the peer at IP playing paddle player
+ */
+void Session_Init(Session_t *session, uint32_t IP, uint8_t player, uint32_t now)
+{
+    memset(session, 0, sizeof(*session));
+    session->used = true;
+    session->IP = IP;
+    session->player = player;
+    session->lastSeen = now;
+    session->nextSend = now;
+    session->snapshotAck = SNAPSHOT_NO_BASE;
+    Input_Clear(&session->inputs);
+    Rel_Init(&session->channel);
+    Rate_Init(&session->rate, now);
+}
+
+/*
+ * Host: empties the session table
+ */
+void Session_ClearTable()
+{
+    memset(sessions, 0, sizeof(sessions));
+}
+
+/*
+ * Host: returns the session of the client at IP, or NULL if it has none
+ */
+Session_t *Session_Find(uint32_t IP)
+{
+    int i;
+
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if(sessions[i].used && sessions[i].IP == IP){
+            return &sessions[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Host: opens a session for a new client, slot n plays paddle n + 1
+ * Returns: the session, or NULL if the table is full
+ */
+Session_t *Session_Add(uint32_t IP, uint32_t now)
+{
+    int i;
+
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if(!sessions[i].used){
+            Session_Init(&sessions[i], IP, i + 1, now);
+            return &sessions[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Host: returns the session in slot index, or NULL if the slot is free
+ */
+Session_t *Session_Get(uint8_t index)
+{
+    return index < MAX_SESSIONS && sessions[index].used ? &sessions[index] : NULL;
+}
+
+/*
+ * Host: frees a session's slot
+ */
+void Session_Remove(Session_t *session)
+{
+    session->used = false;
+}
+
+/*
+ * Host: counts sessions, only the ready ones if readyOnly is set
+ */
+uint8_t Session_Count(bool readyOnly)
+{
+    uint8_t count = 0;
+    int i;
+
+    for(i = 0; i < MAX_SESSIONS; i++){
+        if(sessions[i].used && (sessions[i].ready || !readyOnly)){
+            count++;
+        }
+    }
+    return count;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,100 @@
+/*
+ * Session.h
+ *
+ * Network state kept for each peer. The host keeps a table of client sessions
+ * keyed by the client's IP, each playing one paddle. A client keeps a single
+ * session for the host. A game is at most MAX_NUM_OF_PLAYERS boards, the host
+ * and MAX_SESSIONS clients, join requests past that are left unanswered.
+ */
+
+#ifndef SESSION_H_
+#define SESSION_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "GameTypes.h"
+#include "Snapshot.h"
+#include "Input.h"
+#include "Reliable.h"
+#include "RateControl.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Clients the host can serve, one for every paddle but its own: 3 with 4 paddles */
+#define MAX_SESSIONS                (MAX_NUM_OF_PLAYERS - 1)
+
+/* A client silent for this long is dropped, ms */
+#define SESSION_TIMEOUT_MS          5000
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * One peer
+ */
+typedef struct
+{
+    bool used;
+    bool ready;                 // Client has finished joining
+    uint32_t IP;
+    uint8_t player;             // Paddle the client plays, index into game.players
+    uint32_t lastSeen;          // Time of the last intact packet, ms
+    uint32_t nextSend;          // Earliest time of the next packet to this peer, ms
+    uint16_t txSequence;        // Header sequence of the next packet to this peer
+
+    /* Host: snapshot stream to this client */
+    uint16_t snapshotAck;                           // Newest snapshot it confirmed, SNAPSHOT_NO_BASE before the first
+    uint16_t inputSequence;                         // First input of the client not queued yet
+    uint16_t sentInputSequence[SNAPSHOT_HISTORY];   // inputSequence each snapshot carried to it, by snapshot sequence
+    InputBuffer_t inputs;                           // Inputs received but not applied yet
+
+    ReliableChannel_t channel;
+    RateControl_t rate;
+} Session_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Resets a session for the peer at IP playing paddle player
+ */
+void Session_Init(Session_t *session, uint32_t IP, uint8_t player, uint32_t now);
+
+/*
+ * Host: empties the session table
+ */
+void Session_ClearTable();
+
+/*
+ * Host: returns the session of the client at IP, or NULL if it has none
+ */
+Session_t *Session_Find(uint32_t IP);
+
+/*
+ * Host: opens a session for a new client, slot n plays paddle n + 1
+ * Returns: the session, or NULL if the table is full
+ */
+Session_t *Session_Add(uint32_t IP, uint32_t now);
+
+/*
+ * Host: returns the session in slot index, or NULL if the slot is free
+ */
+Session_t *Session_Get(uint8_t index);
+
+/*
+ * Host: frees a session's slot
+ */
+void Session_Remove(Session_t *session);
+
+/*
+ * Host: counts sessions, only the ready ones if readyOnly is set
+ */
+uint8_t Session_Count(bool readyOnly);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* SESSION_H_ */
@@ -0,0 +1,325 @@
+/*
+ * Snapshot.c
+ */
+
+#include <stddef.h>
+#include "Snapshot.h"
+#include "NetProtocol.h"
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Wire index to RGB565 ball color */
+static const uint16_t snapColors[SNAP_NUM_COLORS] = {SNAP_COLOR_WHITE, SNAP_COLOR_BLUE, SNAP_COLOR_RED};
+
+/* Base used for full snapshots */
+static const Snapshot_t emptySnapshot;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+static uint8_t ColorToIndex(uint16_t color)
+{
+    uint8_t i;
+    for(i = 0; i < SNAP_NUM_COLORS; i++){
+        if(snapColors[i] == color){
+            return i;
+        }
+    }
+    return 0;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Quantizes the parts of the game state that go on the wire
+ */
+void Snapshot_Capture(Snapshot_t *snap, const GameState_t *state)
+{
+    int i;
+
+    //Paddle 0 can never be a real position, it marks a player nobody controls
+    for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        snap->paddles[i] = state->players[i].currentCenter == PLAYER_ABSENT ? 0 : state->players[i].currentCenter - ARENA_MIN_X;
+    }
+
+    snap->alive = 0;
+    for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+        if(state->balls[i].alive){
+            snap->alive |= (1 << i);
+            snap->balls[i].x = state->balls[i].currentCenterX - ARENA_MIN_X;
+            snap->balls[i].y = state->balls[i].currentCenterY - ARENA_MIN_Y;
+            snap->balls[i].color = ColorToIndex(state->balls[i].color);
+        } else {
+            //Dead balls are zeroed so they never show up as changed
+            snap->balls[i].x = 0;
+            snap->balls[i].y = 0;
+            snap->balls[i].color = 0;
+        }
+    }
+
+    snap->LEDScores[0] = state->LEDScores[0];
+    snap->LEDScores[1] = state->LEDScores[1];
+    snap->overallScores[0] = state->overallScores[0];
+    snap->overallScores[1] = state->overallScores[1];
+    snap->status = (state->gameDone ? SNAP_STATUS_GAME_DONE : 0) | (state->winner ? SNAP_STATUS_WINNER : 0);
+}
+
+/*
+ * Writes a snapshot back into the game state
+ */
+void Snapshot_Apply(const Snapshot_t *snap, GameState_t *state)
+{
+    int i;
+
+    for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        state->players[i].currentCenter = snap->paddles[i] ? snap->paddles[i] + ARENA_MIN_X : PLAYER_ABSENT;
+    }
+
+    for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+        state->balls[i].alive = (snap->alive >> i) & 1;
+        if(state->balls[i].alive){
+            state->balls[i].currentCenterX = snap->balls[i].x + ARENA_MIN_X;
+            state->balls[i].currentCenterY = snap->balls[i].y + ARENA_MIN_Y;
+            state->balls[i].color = snapColors[snap->balls[i].color];
+        }
+    }
+
+    state->LEDScores[0] = snap->LEDScores[0];
+    state->LEDScores[1] = snap->LEDScores[1];
+    state->overallScores[0] = snap->overallScores[0];
+    state->overallScores[1] = snap->overallScores[1];
+    state->gameDone = (snap->status & SNAP_STATUS_GAME_DONE) != 0;
+    state->winner = (snap->status & SNAP_STATUS_WINNER) != 0;
+}
+
+/*
+ * Returns the RGB565 color of a wire color index
+ */
+uint16_t Snapshot_Color(uint8_t index)
+{
+    return snapColors[index];
+}
+
+/*
+ * Encodes snap as a delta against base (NULL for a full snapshot)
+ *  - sequence and base sequence (little endian)
+ *  - field mask, then only the fields whose bit is set
+ * Returns: number of bytes written to buf, at most SNAPSHOT_MAX_SIZE
+ */
+uint16_t Snapshot_Encode(const Snapshot_t *snap, const Snapshot_t *base, uint8_t *buf)
+{
+    uint8_t *p = buf;
+    uint8_t *fields;
+    uint8_t *mask;
+    int i;
+
+    p = Net_PutU16(p, snap->sequence);
+    p = Net_PutU16(p, base ? base->sequence : SNAPSHOT_NO_BASE);
+    if(!base){
+        base = &emptySnapshot;
+    }
+
+    fields = p++;
+    *fields = 0;
+
+    //Paddles: change mask then each changed center
+    mask = p++;
+    *mask = 0;
+    for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        if(snap->paddles[i] != base->paddles[i]){
+            *mask |= (1 << i);
+            *p++ = snap->paddles[i];
+        }
+    }
+    if(*mask){
+        *fields |= SNAP_PADDLES;
+    } else {
+        p--;
+    }
+
+    if(snap->alive != base->alive){
+        *fields |= SNAP_ALIVE;
+        *p++ = snap->alive;
+    }
+
+    //Balls: change mask then x, y, color of each changed ball
+    mask = p++;
+    *mask = 0;
+    for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+        if(snap->balls[i].x != base->balls[i].x || snap->balls[i].y != base->balls[i].y ||
+                snap->balls[i].color != base->balls[i].color){
+            *mask |= (1 << i);
+            *p++ = snap->balls[i].x;
+            *p++ = snap->balls[i].y;
+            *p++ = snap->balls[i].color;
+        }
+    }
+    if(*mask){
+        *fields |= SNAP_BALLS;
+    } else {
+        p--;
+    }
+
+    if(snap->LEDScores[0] != base->LEDScores[0] || snap->LEDScores[1] != base->LEDScores[1]){
+        *fields |= SNAP_LED_SCORES;
+        *p++ = snap->LEDScores[0];
+        *p++ = snap->LEDScores[1];
+    }
+
+    if(snap->overallScores[0] != base->overallScores[0] || snap->overallScores[1] != base->overallScores[1]){
+        *fields |= SNAP_OVERALL_SCORES;
+        *p++ = snap->overallScores[0];
+        *p++ = snap->overallScores[1];
+    }
+
+    if(snap->status != base->status){
+        *fields |= SNAP_STATUS;
+        *p++ = snap->status;
+    }
+
+    if(snap->inputSequence != base->inputSequence){
+        *fields |= SNAP_INPUT_SEQUENCE;
+        p = Net_PutU16(p, snap->inputSequence);
+    }
+
+    if(snap->hostTime != base->hostTime){
+        *fields |= SNAP_HOST_TIME;
+        p = Net_PutU16(p, snap->hostTime);
+    }
+
+    return p - buf;
+}
+
+/*
+ * Decodes a snapshot, looking up its base in history
+ * Returns: false if the packet is malformed or its base is no longer in history
+ */
+bool Snapshot_Decode(const uint8_t *buf, uint16_t len, const SnapshotHistory_t *history, Snapshot_t *snap)
+{
+    const uint8_t *p = buf;
+    const uint8_t *end = buf + len;
+    const Snapshot_t *base;
+    uint16_t baseSeq;
+    uint8_t fields, mask;
+    int i;
+
+    if(len < 5){
+        return false;
+    }
+
+    baseSeq = Net_GetU16(p + 2);
+    if(baseSeq == SNAPSHOT_NO_BASE){
+        base = &emptySnapshot;
+    } else {
+        base = Snapshot_Find(history, baseSeq);
+        if(!base){
+            return false;
+        }
+    }
+
+    *snap = *base;
+    snap->sequence = Net_GetU16(p);
+    p += 4;
+    fields = *p++;
+
+    if(fields & SNAP_PADDLES){
+        if(p >= end) return false;
+        mask = *p++;
+        for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+            if(mask & (1 << i)){
+                if(p >= end) return false;
+                snap->paddles[i] = *p++;
+            }
+        }
+    }
+
+    if(fields & SNAP_ALIVE){
+        if(p >= end) return false;
+        snap->alive = *p++;
+    }
+
+    if(fields & SNAP_BALLS){
+        if(p >= end) return false;
+        mask = *p++;
+        for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+            if(mask & (1 << i)){
+                if(p + 3 > end) return false;
+                snap->balls[i].x = *p++;
+                snap->balls[i].y = *p++;
+                snap->balls[i].color = *p++;
+                if(snap->balls[i].color >= SNAP_NUM_COLORS) return false;
+            }
+        }
+    }
+
+    if(fields & SNAP_LED_SCORES){
+        if(p + 2 > end) return false;
+        snap->LEDScores[0] = *p++;
+        snap->LEDScores[1] = *p++;
+    }
+
+    if(fields & SNAP_OVERALL_SCORES){
+        if(p + 2 > end) return false;
+        snap->overallScores[0] = *p++;
+        snap->overallScores[1] = *p++;
+    }
+
+    if(fields & SNAP_STATUS){
+        if(p >= end) return false;
+        snap->status = *p++;
+    }
+
+    if(fields & SNAP_INPUT_SEQUENCE){
+        if(p + 2 > end) return false;
+        snap->inputSequence = Net_GetU16(p);
+        p += 2;
+    }
+
+    if(fields & SNAP_HOST_TIME){
+        if(p + 2 > end) return false;
+        snap->hostTime = Net_GetU16(p);
+        p += 2;
+    }
+
+    return true;
+}
+
+/*
+ * Empties a history ring
+ */
+void Snapshot_ClearHistory(SnapshotHistory_t *history)
+{
+    int i;
+    for(i = 0; i < SNAPSHOT_HISTORY; i++){
+        history->valid[i] = false;
+    }
+}
+
+/*
+ * Stores a snapshot in history, replacing the one SNAPSHOT_HISTORY sequences older
+ */
+void Snapshot_Store(SnapshotHistory_t *history, const Snapshot_t *snap)
+{
+    uint16_t slot = snap->sequence % SNAPSHOT_HISTORY;
+    history->entries[slot] = *snap;
+    history->valid[slot] = true;
+}
+
+/*
+ * Returns the snapshot with the given sequence, or NULL if it is not in history
+ */
+const Snapshot_t *Snapshot_Find(const SnapshotHistory_t *history, uint16_t sequence)
+{
+    uint16_t slot = sequence % SNAPSHOT_HISTORY;
+    if(history->valid[slot] && history->entries[slot].sequence == sequence){
+        return &history->entries[slot];
+    }
+    return NULL;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,146 @@
+/*
+ * Snapshot.h
+ *
+ * Sequenced game state snapshots sent from the host to the client.
+ * Each snapshot is delta encoded against the last one the client acknowledged,
+ * with positions quantized to arena relative bytes and no velocities or thread IDs.
+ */
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+/*********************************************** Includes ********************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "GameTypes.h"
+/*********************************************** Includes ********************************************************************/
+
+/*********************************************** Global Defines ********************************************************************/
+
+/* Number of past snapshots each side keeps to delta against */
+#define SNAPSHOT_HISTORY            32
+
+/* Base sequence of a snapshot that is encoded against an empty state */
+#define SNAPSHOT_NO_BASE            0xFFFF
+
+/* Largest encoded snapshot: header, masks, every paddle and every ball */
+#define SNAPSHOT_MAX_SIZE           (4 + 1 + 1 + MAX_NUM_OF_PLAYERS + 1 + 1 + 3*MAX_NUM_OF_BALLS + 2 + 2 + 1 + 2 + 2)
+
+/* Field mask bits, in the order the fields follow the header */
+#define SNAP_PADDLES                0x01
+#define SNAP_ALIVE                  0x02
+#define SNAP_BALLS                  0x04
+#define SNAP_LED_SCORES             0x08
+#define SNAP_OVERALL_SCORES         0x10
+#define SNAP_STATUS                 0x20
+#define SNAP_INPUT_SEQUENCE         0x40
+#define SNAP_HOST_TIME              0x80
+
+/* Status byte bits */
+#define SNAP_STATUS_GAME_DONE       0x01
+#define SNAP_STATUS_WINNER          0x02
+
+/* Ball colors travel as an index into this table */
+#define SNAP_NUM_COLORS             3
+
+/* The table's RGB565 colors, LCDLib.h's LCD_WHITE, LCD_BLUE and LCD_RED without its LCD driver */
+#define SNAP_COLOR_WHITE            0xFFFF
+#define SNAP_COLOR_BLUE             0x0197
+#define SNAP_COLOR_RED              0xF800
+
+/*********************************************** Global Defines ********************************************************************/
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*
+ * Ball as it is sent, coordinates are relative to the arena's top left corner
+ */
+typedef struct
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t color;
+} SnapshotBall_t;
+
+/*
+ * Quantized copy of everything the client needs from GameState_t
+ */
+typedef struct
+{
+    uint16_t sequence;
+    uint8_t paddles[MAX_NUM_OF_PLAYERS];
+    uint8_t alive;
+    SnapshotBall_t balls[MAX_NUM_OF_BALLS];
+    uint8_t LEDScores[2];
+    uint8_t overallScores[2];
+    uint8_t status;
+    uint16_t inputSequence;     // First client input the host has not processed yet
+    uint16_t hostTime;          // Host SystemTime when captured, ms
+} Snapshot_t;
+
+/*
+ * Ring of recent snapshots, looked up by sequence number
+ */
+typedef struct
+{
+    Snapshot_t entries[SNAPSHOT_HISTORY];
+    bool valid[SNAPSHOT_HISTORY];
+} SnapshotHistory_t;
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * True if sequence a is newer than sequence b, allowing for wrap around
+ */
+static inline bool Snapshot_SeqNewer(uint16_t a, uint16_t b)
+{
+    return (int16_t)(a - b) > 0;
+}
+
+/*
+ * Quantizes the parts of the game state that go on the wire
+ */
+void Snapshot_Capture(Snapshot_t *snap, const GameState_t *state);
+
+/*
+ * Writes a snapshot back into the game state
+ */
+void Snapshot_Apply(const Snapshot_t *snap, GameState_t *state);
+
+/*
+ * Returns the RGB565 color of a wire color index
+ */
+uint16_t Snapshot_Color(uint8_t index);
+
+/*
+ * Encodes snap as a delta against base (NULL for a full snapshot)
+ * Returns: number of bytes written to buf, at most SNAPSHOT_MAX_SIZE
+ */
+uint16_t Snapshot_Encode(const Snapshot_t *snap, const Snapshot_t *base, uint8_t *buf);
+
+/*
+ * Decodes a snapshot, looking up its base in history
+ * Returns: false if the packet is malformed or its base is no longer in history
+ */
+bool Snapshot_Decode(const uint8_t *buf, uint16_t len, const SnapshotHistory_t *history, Snapshot_t *snap);
+
+/*
+ * Empties a history ring
+ */
+void Snapshot_ClearHistory(SnapshotHistory_t *history);
+
+/*
+ * Stores a snapshot in history, replacing the one SNAPSHOT_HISTORY sequences older
+ */
+void Snapshot_Store(SnapshotHistory_t *history, const Snapshot_t *snap);
+
+/*
+ * Returns the snapshot with the given sequence, or NULL if it is not in history
+ */
+const Snapshot_t *Snapshot_Find(const SnapshotHistory_t *history, uint16_t sequence);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* SNAPSHOT_H_ */
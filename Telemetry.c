@@ -0,0 +1,224 @@
+/*
+ * Telemetry.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "Telemetry.h"
+#include "Game.h"
+#include "NetProtocol.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Private Defines **********************************************************************/
+
+/* Wire size of a sample, the scalar fields then both histograms */
+#define TELEMETRY_SIZE              (0 TELEMETRY_FIELDS(NET_FIELD_SIZE) + (TELEMETRY_RATES + TELEMETRY_RSSI_BINS) * NET_SIZE_U16)
+
+#define TELEMETRY_ENCODE_FIELD(type, name)  p = Net_Put##type(p, src->name);
+
+/* Overlay: a label row above a value row for each item, in the strip right of the arena */
+#define OVERLAY_X                   (ARENA_MAX_X + 4)
+#define OVERLAY_ROW_HEIGHT          16
+#define OVERLAY_CHARS               4
+#define OVERLAY_MAX                 9999
+#define OVERLAY_ITEMS               7
+
+/*********************************************** Private Defines **********************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Newest and previous sample, the overlay shows the change between them */
+static Telemetry_t latest;
+static Telemetry_t previous;
+
+/* Broadcast packet and its header sequence */
+static uint8_t packet[NET_HEADER_SIZE + TELEMETRY_SIZE + NET_CRC_SIZE];
+static uint16_t sequence;
+
+#if TELEMETRY_OVERLAY
+static const char *const overlayLabels[OVERLAY_ITEMS] = {"RSSI", "FCS", "LOST", "LATE", "DUP", "RTT", "DROP"};
+
+/* Text on screen for each value, only changed values are redrawn */
+static char overlayShown[OVERLAY_ITEMS][OVERLAY_CHARS + 1];
+#endif
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Growth of a counter since the previous sample, 0 if it went down because a link was closed
+ */
+static inline uint32_t Delta(uint32_t now, uint32_t before)
+{
+    return now > before ? now - before : 0;
+}
+
+/*
+ * Reads and clears the CC3100's receive statistics
+ */
+static void SampleRadio(RadioStats_t *radio)
+{
+    SlGetRxStatResponse_t rx;
+
+    memset(radio, 0, sizeof(*radio));
+    if(getWlanRxStats(&rx) < 0){
+        return;
+    }
+
+    radio->period = rx.GetTimeStamp - rx.StartTimeStamp;
+    radio->rssi = rx.AvarageDataCtrlRssi;
+    radio->mgmtRssi = rx.AvarageMgMntRssi;
+    radio->frames = rx.ReceivedValidPacketsNumber;
+    radio->fcsErrors = rx.ReceivedFcsErrorPacketsNumber;
+    radio->plcpErrors = rx.ReceivedPlcpErrorPacketsNumber;
+    memcpy(radio->rates, rx.RateHistogram, sizeof(radio->rates));
+    memcpy(radio->rssiBins, rx.RssiHistogram, sizeof(radio->rssiBins));
+}
+
+/*
+ * Serializes a sample, returns TELEMETRY_SIZE
+ */
+static uint16_t Encode(uint8_t *buf, const Telemetry_t *src)
+{
+    uint8_t *p = buf;
+
+    TELEMETRY_FIELDS(TELEMETRY_ENCODE_FIELD)
+    for(int i = 0; i < TELEMETRY_RATES; i++){
+        p = Net_PutU16(p, src->radio.rates[i]);
+    }
+    for(int i = 0; i < TELEMETRY_RSSI_BINS; i++){
+        p = Net_PutU16(p, src->radio.rssiBins[i]);
+    }
+    return p - buf;
+}
+
+#if TELEMETRY_OVERLAY
+/*
+ * Redraws one overlay value if its text changed
+ * Takes the screen for one row at a time so the render thread never waits long
+ */
+static void DrawValue(uint8_t item, int32_t value)
+{
+    char text[OVERLAY_CHARS + 1];
+    uint16_t y = (2 * item + 1) * OVERLAY_ROW_HEIGHT;
+
+    if(value > OVERLAY_MAX){
+        value = OVERLAY_MAX;
+    }
+    snprintf(text, sizeof(text), "%ld", (long)value);
+    if(!strcmp(text, overlayShown[item])){
+        return;
+    }
+    strcpy(overlayShown[item], text);
+
+    G8RTOS_WaitSemaphore(screen_s);
+    LCD_DrawRectangle(OVERLAY_X, OVERLAY_X + OVERLAY_CHARS * 8, y, y + OVERLAY_ROW_HEIGHT, BACK_COLOR);
+    LCD_Text(OVERLAY_X, y, (uint8_t *)text, LCD_WHITE);
+    G8RTOS_SignalSemaphore(screen_s);
+}
+
+/*
+ * Shows the newest sample, counters as their change over the last period
+ */
+static void DrawOverlay()
+{
+    DrawValue(0, latest.radio.rssi);
+    DrawValue(1, latest.radio.fcsErrors);
+    DrawValue(2, Delta(latest.traffic.lost, previous.traffic.lost));
+    DrawValue(3, Delta(latest.traffic.late + latest.traffic.lateSnapshots,
+                       previous.traffic.late + previous.traffic.lateSnapshots));
+    DrawValue(4, Delta(latest.traffic.duplicates, previous.traffic.duplicates));
+    DrawValue(5, latest.traffic.srtt);
+    DrawValue(6, Delta(latest.rxDropped + latest.txDropped, previous.rxDropped + previous.txDropped));
+}
+#endif
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts the CC3100's receive statistics and draws the overlay labels
+ * Call once the CC3100 is connected and the board is drawn
+ */
+void Telemetry_Start()
+{
+    memset(&latest, 0, sizeof(latest));
+    memset(&previous, 0, sizeof(previous));
+    sequence = 0;
+
+    //Not fatal, the radio fields then stay zero
+    startWlanRxStats();
+
+#if TELEMETRY_OVERLAY
+    G8RTOS_WaitSemaphore(screen_s);
+    for(int i = 0; i < OVERLAY_ITEMS; i++){
+        LCD_Text(OVERLAY_X, 2 * i * OVERLAY_ROW_HEIGHT, (uint8_t *)overlayLabels[i], LCD_CYAN);
+        overlayShown[i][0] = '\0';
+    }
+    G8RTOS_SignalSemaphore(screen_s);
+#endif
+}
+
+/*
+ * Takes a sample, redraws the overlay values that changed and broadcasts it
+ * Call every TELEMETRY_PERIOD_MS from a low priority thread
+ */
+void Telemetry_Sample()
+{
+    Telemetry_t sample;
+    uint16_t len;
+    int32_t primask;
+
+    sample.time = SystemTime;
+    sample.samples = latest.samples + 1;
+    SampleRadio(&sample.radio);
+    NetGame_GetTrafficStats(&sample.traffic);
+    sample.rxDropped = getRxDropped();
+    sample.txDropped = getTxDropped();
+    getConnectTiming(&sample.connect);
+
+    //The driver's thread updates these between transfers, copy them in one piece
+    primask = StartCriticalSection();
+    spi_GetStats(&sample.spi);
+    EndCriticalSection(primask);
+
+    //And the receive thread these as datagrams arrive
+    primask = StartCriticalSection();
+    getRxFilterStats(&sample.rxFilters);
+    EndCriticalSection(primask);
+
+    primask = StartCriticalSection();
+    previous = latest;
+    latest = sample;
+    EndCriticalSection(primask);
+
+#if TELEMETRY_OVERLAY
+    DrawOverlay();
+#endif
+
+    len = Encode(packet + NET_HEADER_SIZE, &sample);
+    len = Net_FinishPacket(packet, NET_MSG_TELEMETRY, sequence++, len);
+    SendStats(packet, len);
+}
+
+/*
+ * Copies the newest sample, all zero before the first one
+ */
+void Telemetry_Get(Telemetry_t *sample)
+{
+    int32_t primask = StartCriticalSection();
+    *sample = latest;
+    EndCriticalSection(primask);
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,132 @@
+/*
+ * Telemetry.h
+ *
+ * Link quality telemetry, to tell stutters caused by the radio or the AP from our own.
+ * A low priority thread samples the CC3100's receive statistics, the SPI link's transfer counters,
+ * the game's packet counters, how long the last connect took and what got past the RX filters
+ * once every TELEMETRY_PERIOD_MS, shows them on a debug overlay beside the arena and broadcasts
+ * them to STATS_PORT as a NET_MSG_TELEMETRY packet, fields in TELEMETRY_FIELDS order.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include "cc3100_usage.h"
+#include "NetGame.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Time between samples, ms, the device's receive statistics cover one period each */
+#define TELEMETRY_PERIOD_MS         1000
+
+/* Priority of the telemetry thread, below every game thread */
+#define TELEMETRY_THREAD_PRIORITY   3
+
+/* 1 draws the overlay in the strip right of the arena, 0 only broadcasts */
+#define TELEMETRY_OVERLAY           1
+
+/* Histogram sizes of the device's receive statistics */
+#define TELEMETRY_RATES             NUM_OF_RATE_INDEXES
+#define TELEMETRY_RSSI_BINS         SIZE_OF_RSSI_HISTOGRAM
+
+/*
+ * Scalar fields of Telemetry_t in wire order: FIELD(wire type, struct member)
+ * The rate and RSSI histograms follow them as u16 each
+ */
+#define TELEMETRY_FIELDS(FIELD)             \
+    FIELD(U32,  time)                       \
+    FIELD(U32,  samples)                    \
+    FIELD(U32,  radio.period)               \
+    FIELD(I16,  radio.rssi)                 \
+    FIELD(I16,  radio.mgmtRssi)             \
+    FIELD(U32,  radio.frames)               \
+    FIELD(U32,  radio.fcsErrors)            \
+    FIELD(U32,  radio.plcpErrors)           \
+    FIELD(U32,  traffic.sent)               \
+    FIELD(U32,  traffic.received)           \
+    FIELD(U32,  traffic.late)               \
+    FIELD(U32,  traffic.lost)               \
+    FIELD(U32,  traffic.duplicates)         \
+    FIELD(U32,  traffic.lateSnapshots)      \
+    FIELD(U32,  traffic.inputsOverwritten)  \
+    FIELD(U32,  traffic.srtt)               \
+    FIELD(U32,  traffic.loss)               \
+    FIELD(U32,  rxDropped)                  \
+    FIELD(U32,  txDropped)                  \
+    FIELD(U32,  spi.pio.transfers)          \
+    FIELD(U32,  spi.pio.bytes)              \
+    FIELD(U32,  spi.pio.cycles)             \
+    FIELD(U32,  spi.dma.transfers)          \
+    FIELD(U32,  spi.dma.bytes)              \
+    FIELD(U32,  spi.dma.cycles)             \
+    FIELD(U32,  spi.mclkHz)                 \
+    FIELD(U32,  connect.started)            \
+    FIELD(U32,  connect.configured)         \
+    FIELD(U32,  connect.connected)          \
+    FIELD(U32,  connect.ipAcquired)         \
+    FIELD(U8,   connect.fastBoot)           \
+    FIELD(U8,   rxFilters.installed)        \
+    FIELD(U8,   rxFilters.enabled)          \
+    FIELD(U32,  rxFilters.passed)           \
+    FIELD(U32,  rxFilters.escaped)
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures **********************************************************************/
+
+/*
+ * What the CC3100 heard over the last period, filtered frames included
+ */
+typedef struct
+{
+    uint32_t period;                        // time covered, us, 0 if the device did not answer
+    int16_t rssi;                           // average of valid data and control frames, dBm
+    int16_t mgmtRssi;                       // average of valid management frames, dBm
+    uint32_t frames;                        // valid frames
+    uint32_t fcsErrors;                     // frames dropped for a bad FCS
+    uint32_t plcpErrors;                    // frames dropped for a PLCP error
+    uint16_t rates[TELEMETRY_RATES];        // valid frames by rate index
+    uint16_t rssiBins[TELEMETRY_RSSI_BINS]; // valid frames by RSSI, -40 to -87 dBm
+} RadioStats_t;
+
+/*
+ * One sample
+ */
+typedef struct
+{
+    uint32_t time;                          // SystemTime of the sample, ms
+    uint32_t samples;                       // taken since Telemetry_Start
+    RadioStats_t radio;
+    TrafficStats_t traffic;
+    uint32_t rxDropped;                     // RX ring full, see getRxDropped
+    uint32_t txDropped;                     // CC3100 out of TX buffers, see getTxDropped
+    SpiStats_t spi;                         // CC3100 SPI transfers polled and on the uDMA, see spi_GetStats
+    ConnectTiming_t connect;                // time to IP of each phase of initCC3100, see getConnectTiming
+    RxFilterStats_t rxFilters;              // CC3100 RX filters and what got past them, see getRxFilterStats
+} Telemetry_t;
+
+/*********************************************** Data Structures **********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts the CC3100's receive statistics and draws the overlay labels
+ * Call once the CC3100 is connected and the board is drawn
+ */
+void Telemetry_Start();
+
+/*
+ * Takes a sample, redraws the overlay values that changed and broadcasts it
+ * Call every TELEMETRY_PERIOD_MS from a low priority thread
+ */
+void Telemetry_Sample();
+
+/*
+ * Copies the newest sample, all zero before the first one
+ */
+void Telemetry_Get(Telemetry_t *sample);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* TELEMETRY_H_ */
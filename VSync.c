@@ -0,0 +1,163 @@
+/*
+ * VSync.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include "msp.h"
+#include "BSP.h"
+#include "VSync.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Signalled once per frame marker, never counts past one pending frame */
+static semaphore_t vsync_s;
+
+static VSyncStats_t stats;
+
+/* Time of the last pulse and of the last wake-up */
+static uint32_t lastMarkerTime;
+static uint32_t lastMarkerMs;
+static uint32_t frameStartTime;
+
+/* Pulse count when the current frame started */
+static uint32_t frameStartMarker;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Periodic event, paces the renderer at VSYNC_FALLBACK_PERIOD_MS while no marker arrives
+ * Keeps the render thread from blocking forever when FMARK is not wired
+ */
+static void VSync_Watchdog()
+{
+    if(SystemTime - lastMarkerMs < VSYNC_TIMEOUT_MS){
+        return;
+    }
+    if(vsync_s <= 0){
+        stats.fallbacks++;
+        G8RTOS_SignalSemaphore(&vsync_s);
+    }
+}
+
+/*
+ * Microseconds since launch, from the system time and the SysTick count
+ */
+static uint32_t VSync_Now()
+{
+    uint32_t ticksPerUs = ClockSys_GetSysFreq() / 1000000;
+    return SystemTime * 1000 + (SysTick->LOAD - SysTick->VAL) / ticksPerUs;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Turns on FMARK at VSYNC_MARKER_LINE, routes its interrupt to VSync_isr and starts the watchdog
+ * Must be called after G8RTOS_Init
+ */
+sched_ErrCode_t VSync_Init()
+{
+    sched_ErrCode_t err;
+
+    G8RTOS_InitSemaphore(&vsync_s, 0);
+    VSync_ResetStats();
+    lastMarkerTime = 0;
+    lastMarkerMs = SystemTime;
+
+    LCD_EnableFrameMarker(VSYNC_MARKER_LINE);
+    err = G8RTOS_AddAPeriodicEvent(VSync_isr, VSYNC_IRQ_PRIORITY, LCD_FMARK_IRQn);
+    if(err != NO_ERROR){
+        return err;
+    }
+    return G8RTOS_AddPeriodicEvent(VSync_Watchdog, VSYNC_FALLBACK_PERIOD_MS);
+}
+
+/*
+ * FMARK interrupt, wakes the render thread
+ */
+void VSync_isr()
+{
+    uint32_t now = VSync_Now();
+
+    P3IFG &= ~LCD_FMARK_PIN;
+
+    stats.markers++;
+    if(lastMarkerTime){
+        stats.framePeriod = now - lastMarkerTime;
+    }
+    lastMarkerTime = now;
+    lastMarkerMs = SystemTime;
+
+    //Only ever hold one pending frame, a slow renderer skips frames instead of queueing them
+    if(vsync_s > 0){
+        stats.missed++;
+    } else {
+        G8RTOS_SignalSemaphore(&vsync_s);
+    }
+}
+
+/*
+ * Blocks the calling thread until the next frame marker, or the watchdog's frame without one
+ */
+void VSync_WaitForFrame()
+{
+    G8RTOS_WaitSemaphore(&vsync_s);
+    frameStartTime = VSync_Now();
+    frameStartMarker = stats.markers;
+}
+
+/*
+ * Marks the end of the drawing started after VSync_WaitForFrame
+ */
+void VSync_EndFrame()
+{
+    uint32_t elapsed = VSync_Now() - frameStartTime;
+
+    stats.rendered++;
+    stats.renderTime = elapsed;
+    if(elapsed > stats.maxRenderTime){
+        stats.maxRenderTime = elapsed;
+    }
+    if(stats.markers != frameStartMarker){
+        stats.late++;
+    }
+}
+
+/*
+ * Copies the current frame statistics
+ */
+void VSync_GetStats(VSyncStats_t *out)
+{
+    int32_t primask = StartCriticalSection();
+    *out = stats;
+    EndCriticalSection(primask);
+}
+
+/*
+ * Clears the frame statistics
+ */
+void VSync_ResetStats()
+{
+    int32_t primask = StartCriticalSection();
+    stats.markers = 0;
+    stats.rendered = 0;
+    stats.missed = 0;
+    stats.fallbacks = 0;
+    stats.late = 0;
+    stats.framePeriod = 0;
+    stats.renderTime = 0;
+    stats.maxRenderTime = 0;
+    EndCriticalSection(primask);
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,87 @@
+/*
+ * VSync.h
+ *
+ * Frame pacing driven by the panel's FMARK output.
+ * The render thread waits for the frame marker, draws, then reports the end of its frame.
+ * Without markers (FMARK not wired, or the panel never raises it) a watchdog paces
+ * the renderer at the old fixed period instead.
+ */
+
+#ifndef VSYNC_H_
+#define VSYNC_H_
+
+#include <stdint.h>
+#include "G8RTOS.h"
+#include "LCDLib.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Scan line the panel pulses FMARK on, 0 is the start of the vertical back porch */
+#define VSYNC_MARKER_LINE       0
+
+/* Priority of the FMARK interrupt (0-6, see G8RTOS_AddAPeriodicEvent) */
+#define VSYNC_IRQ_PRIORITY      1
+
+/* No marker for this long (about two frames) and the watchdog starts pacing frames, ms */
+#define VSYNC_TIMEOUT_MS        34
+
+/* Frame period the watchdog paces at, ms, the fixed sleep used before FMARK */
+#define VSYNC_FALLBACK_PERIOD_MS    20
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures **********************************************************************/
+
+/*
+ * Frame timing statistics, all times in microseconds
+ */
+typedef struct
+{
+    uint32_t markers;           // FMARK pulses seen
+    uint32_t rendered;          // frames the render thread drew
+    uint32_t missed;            // pulses that arrived while a frame was already pending
+    uint32_t fallbacks;         // frames the watchdog started because no pulse came
+    uint32_t late;              // frames still drawing when the next pulse arrived
+    uint32_t framePeriod;       // time between the last two pulses
+    uint32_t renderTime;        // wake-up to VSync_EndFrame of the last frame
+    uint32_t maxRenderTime;     // worst renderTime since the last reset
+} VSyncStats_t;
+
+/*********************************************** Data Structures **********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Turns on FMARK at VSYNC_MARKER_LINE, routes its interrupt to VSync_isr and starts the watchdog
+ * Must be called after G8RTOS_Init
+ */
+sched_ErrCode_t VSync_Init();
+
+/*
+ * FMARK interrupt, wakes the render thread
+ */
+void VSync_isr();
+
+/*
+ * Blocks the calling thread until the next frame marker, or the watchdog's frame without one
+ */
+void VSync_WaitForFrame();
+
+/*
+ * Marks the end of the drawing started after VSync_WaitForFrame
+ */
+void VSync_EndFrame();
+
+/*
+ * Copies the current frame statistics
+ */
+void VSync_GetStats(VSyncStats_t *stats);
+
+/*
+ * Clears the frame statistics
+ */
+void VSync_ResetStats();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* VSYNC_H_ */
@@ -0,0 +1,379 @@
+/*
+ * winScreenRed - generated by tools/rle_convert.py from red_wins.ppm
+ * 320x240, 4 colors, 5843 bytes encoded (153600 bytes as raw RGB565)
+ */
+#include "RLEImage.h"
+
+static const uint16_t winScreenRed_palette[4] = {
+    0x0000, 0x8000, 0xF800, 0xFFFF,
+};
+
+static const uint8_t winScreenRed_data[5835] = {
+    0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02,
+    0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0x85, 0x02,
+    0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0x8B, 0x02,
+    0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02,
+    0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xE2, 0x02, 0x85, 0x03, 0x85, 0x02, 0x85, 0x03, 0x83, 0x02, 0x01, 0x03, 0x03, 0x85,
+    0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x89, 0x03, 0x8F, 0x02, 0x85, 0x03, 0x83, 0x02, 0x01, 0x03,
+    0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x89, 0x03, 0x01, 0x02, 0x02, 0x87, 0x03, 0xE2,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE2, 0x02, 0x85, 0x03, 0x85, 0x02, 0x85, 0x03, 0x83,
+    0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x89, 0x03, 0x8F, 0x02, 0x85,
+    0x03, 0x83, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x89, 0x03, 0x01,
+    0x02, 0x02, 0x87, 0x03, 0xE2, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03,
+    0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02,
+    0x02, 0x83, 0x03, 0x01, 0x02, 0x02, 0x83, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01,
+    0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0x89, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0xE0, 0x02,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x83, 0x03, 0x01, 0x02, 0x02,
+    0x83, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03,
+    0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x89, 0x02,
+    0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0xE0, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xE0, 0x02, 0x01, 0x03, 0x03, 0x89, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x11, 0x03, 0x03, 0x02,
+    0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95,
+    0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05,
+    0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x89, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03,
+    0xE0, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03, 0x03, 0x89, 0x02, 0x01,
+    0x03, 0x03, 0x85, 0x02, 0x11, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02,
+    0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03,
+    0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x89, 0x02,
+    0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0xE0, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xE0, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x85, 0x03, 0x01, 0x02, 0x02, 0x89, 0x03, 0x0D, 0x02,
+    0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x87, 0x03, 0x8F,
+    0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x03,
+    0x03, 0x03, 0x02, 0x02, 0x87, 0x03, 0x83, 0x02, 0x87, 0x03, 0xE2, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xE0, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x85, 0x03, 0x01, 0x02, 0x02, 0x89, 0x03,
+    0x0D, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x87,
+    0x03, 0x8F, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85,
+    0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x87, 0x03, 0x83, 0x02, 0x87, 0x03, 0xE2, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02,
+    0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02,
+    0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x89, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0xE4, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03,
+    0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02,
+    0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01, 0x03,
+    0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02,
+    0x02, 0x03, 0x03, 0x89, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0xE4, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02,
+    0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0x95, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0x83, 0x02,
+    0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x83, 0x02, 0x01, 0x03, 0x03, 0x89, 0x02, 0x01, 0x03,
+    0x03, 0x83, 0x02, 0x01, 0x03, 0x03, 0xE2, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE0, 0x02,
+    0x01, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03,
+    0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x95, 0x02,
+    0x01, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0x83, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03,
+    0x03, 0x83, 0x02, 0x01, 0x03, 0x03, 0x89, 0x02, 0x01, 0x03, 0x03, 0x83, 0x02, 0x01, 0x03, 0x03,
+    0xE2, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xE2, 0x02, 0x87, 0x03, 0x03, 0x02, 0x02, 0x03,
+    0x03, 0x85, 0x02, 0x05, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02,
+    0x02, 0x89, 0x03, 0x8F, 0x02, 0x85, 0x03, 0x87, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x89, 0x03,
+    0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x01, 0x03, 0x03, 0xE0, 0x02, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0xE2, 0x02, 0x87, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x05, 0x03, 0x03,
+    0x02, 0x02, 0x03, 0x03, 0x85, 0x02, 0x03, 0x03, 0x03, 0x02, 0x02, 0x89, 0x03, 0x8F, 0x02, 0x85,
+    0x03, 0x87, 0x02, 0x01, 0x03, 0x03, 0x85, 0x02, 0x89, 0x03, 0x03, 0x02, 0x02, 0x03, 0x03, 0x85,
+    0x02, 0x01, 0x03, 0x03, 0xE0, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02,
+    0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02,
+    0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02,
+    0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02,
+    0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01,
+    0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0x9F, 0x01, 0x93, 0x03, 0x89, 0x01, 0x98, 0x03, 0x84, 0x01, 0x93, 0x03, 0xA7, 0x01, 0x84, 0x03,
+    0x8E, 0x01, 0x84, 0x03, 0x89, 0x01, 0x8E, 0x03, 0x89, 0x01, 0x84, 0x03, 0x8E, 0x01, 0x84, 0x03,
+    0x89, 0x01, 0x93, 0x03, 0xA0, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03,
+    0x89, 0x01, 0x98, 0x03, 0x84, 0x01, 0x93, 0x03, 0xA7, 0x01, 0x84, 0x03, 0x8E, 0x01, 0x84, 0x03,
+    0x89, 0x01, 0x8E, 0x03, 0x89, 0x01, 0x84, 0x03, 0x8E, 0x01, 0x84, 0x03, 0x89, 0x01, 0x93, 0x03,
+    0xA0, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03, 0x89, 0x01, 0x98, 0x03,
+    0x84, 0x01, 0x93, 0x03, 0xA7, 0x01, 0x84, 0x03, 0x8E, 0x01, 0x84, 0x03, 0x89, 0x01, 0x8E, 0x03,
+    0x89, 0x01, 0x84, 0x03, 0x8E, 0x01, 0x84, 0x03, 0x89, 0x01, 0x93, 0x03, 0xA0, 0x01, 0x83, 0x03,
+    0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03, 0x82, 0x00, 0x86, 0x01, 0x98, 0x03, 0x82, 0x00,
+    0x01, 0x01, 0x01, 0x93, 0x03, 0x82, 0x00, 0xA4, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x86, 0x01, 0x93, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03, 0x82, 0x00, 0x86, 0x01, 0x98, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x93, 0x03, 0x82, 0x00, 0xA4, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x86, 0x01, 0x93, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x8E, 0x00, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x96, 0x00,
+    0x01, 0x01, 0x01, 0x84, 0x03, 0x8E, 0x00, 0x84, 0x03, 0xA2, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x87, 0x00, 0x86, 0x01,
+    0x89, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x01, 0x93,
+    0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x8E, 0x00, 0x84,
+    0x03, 0x84, 0x01, 0x84, 0x03, 0x96, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x8E, 0x00, 0x84, 0x03,
+    0xA2, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x01, 0x00,
+    0x00, 0x84, 0x03, 0x87, 0x00, 0x86, 0x01, 0x89, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x84, 0x03, 0x82, 0x01, 0x93, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03,
+    0x9F, 0x01, 0x84, 0x03, 0x8E, 0x00, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x96, 0x00, 0x01, 0x01,
+    0x01, 0x84, 0x03, 0x8E, 0x00, 0x84, 0x03, 0xA2, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x87, 0x00, 0x86, 0x01, 0x89, 0x03,
+    0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x01, 0x93, 0x00, 0x9D,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x89, 0x03, 0x82, 0x00, 0x86, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x89, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x8B, 0x01, 0x84, 0x03, 0x84, 0x00, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x84, 0x00, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x84, 0x00, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0xB1, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83,
+    0x03, 0x9F, 0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x89, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x01, 0x01, 0x01, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00, 0x00, 0x89, 0x03, 0x82, 0x00,
+    0x84, 0x01, 0x01, 0x00, 0x00, 0x8E, 0x03, 0xA5, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F,
+    0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x89, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01,
+    0x01, 0x84, 0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00, 0x00, 0x89, 0x03, 0x82, 0x00, 0x84, 0x01,
+    0x01, 0x00, 0x00, 0x8E, 0x03, 0xA5, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93,
+    0x03, 0x82, 0x01, 0x84, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84,
+    0x03, 0x84, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00, 0x00, 0x89, 0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00,
+    0x00, 0x8E, 0x03, 0xA5, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03, 0x82,
+    0x00, 0x86, 0x01, 0x93, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x86, 0x01, 0x89, 0x03, 0x82, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x82, 0x00, 0xA2,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x93, 0x03, 0x82, 0x00, 0x86, 0x01, 0x93,
+    0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x86,
+    0x01, 0x89, 0x03, 0x82, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x82, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x84, 0x00, 0x84, 0x03, 0x87, 0x00, 0x86, 0x01, 0x84,
+    0x03, 0x91, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x89,
+    0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x8B, 0x00, 0x84, 0x03, 0xA0, 0x01,
+    0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x84, 0x00, 0x84, 0x03, 0x87, 0x00,
+    0x86, 0x01, 0x84, 0x03, 0x91, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x8B, 0x00, 0x84,
+    0x03, 0xA0, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x84, 0x00, 0x84,
+    0x03, 0x87, 0x00, 0x86, 0x01, 0x84, 0x03, 0x91, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01,
+    0x8B, 0x00, 0x84, 0x03, 0xA0, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02,
+    0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x89,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83,
+    0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x84, 0x01, 0x01, 0x00, 0x00,
+    0x84, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x84, 0x01,
+    0x01, 0x00, 0x00, 0x84, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x95,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x95, 0x01, 0x84, 0x03, 0x82, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F,
+    0x01, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x84, 0x01, 0x98, 0x03,
+    0x84, 0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00, 0xA2, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82,
+    0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x01, 0x84, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x89, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x82,
+    0x01, 0x84, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x89, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x84, 0x01, 0x98, 0x03, 0x84, 0x01, 0x93, 0x03,
+    0x82, 0x01, 0x84, 0x00, 0xA2, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x01, 0x01, 0x00, 0x00,
+    0x84, 0x03, 0x82, 0x01, 0x84, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00,
+    0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00, 0x9D,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x89, 0x01, 0x01,
+    0x00, 0x00, 0x84, 0x03, 0x84, 0x01, 0x98, 0x03, 0x84, 0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00,
+    0xA2, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x01, 0x01, 0x00, 0x00, 0x84, 0x03, 0x82, 0x01,
+    0x84, 0x00, 0x86, 0x01, 0x8E, 0x03, 0x89, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x82, 0x01, 0x84, 0x00, 0x9D, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01,
+    0x01, 0x01, 0x98, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x82, 0x00, 0xA9, 0x01, 0x84,
+    0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x8E, 0x03, 0x82, 0x00,
+    0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x93,
+    0x03, 0x82, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0x9F, 0x01, 0x84, 0x03, 0x82,
+    0x00, 0x8B, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x98, 0x03, 0x82, 0x00, 0x01, 0x01,
+    0x01, 0x93, 0x03, 0x82, 0x00, 0xA9, 0x01, 0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x84, 0x03,
+    0x82, 0x00, 0x8B, 0x01, 0x8E, 0x03, 0x82, 0x00, 0x86, 0x01, 0x84, 0x03, 0x82, 0x00, 0x8B, 0x01,
+    0x84, 0x03, 0x82, 0x00, 0x01, 0x01, 0x01, 0x93, 0x03, 0x82, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xA2, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x98, 0x00, 0x84,
+    0x01, 0x93, 0x00, 0xAC, 0x01, 0x84, 0x00, 0x84, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x8E, 0x00, 0x89,
+    0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x93, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xA2, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x98, 0x00, 0x84,
+    0x01, 0x93, 0x00, 0xAC, 0x01, 0x84, 0x00, 0x84, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x8E, 0x00, 0x89,
+    0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x93, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xA2, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x98, 0x00, 0x84,
+    0x01, 0x93, 0x00, 0xAC, 0x01, 0x84, 0x00, 0x84, 0x01, 0x84, 0x00, 0x8E, 0x01, 0x8E, 0x00, 0x89,
+    0x01, 0x84, 0x00, 0x8E, 0x01, 0x84, 0x00, 0x84, 0x01, 0x93, 0x00, 0xA2, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB,
+    0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x01, 0xFF, 0x01, 0xAB, 0x01, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF,
+    0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB,
+    0x02, 0x83, 0x03, 0x8B, 0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B,
+    0x02, 0x83, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xAB, 0x02, 0x83, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF,
+    0x03, 0xB3, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF,
+    0x03, 0xB3, 0x03, 0x8B, 0x02, 0xFF, 0x03, 0xFF, 0x03, 0xB3, 0x03, 0xFF, 0x02, 0xFF, 0x02, 0xFF,
+    0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF,
+    0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0xFF, 0x02, 0x85, 0x02,
+};
+
+const RLEImage_t winScreenRed = {320, 240, 4, winScreenRed_palette, 5835, winScreenRed_data};
@@ -2,6 +2,7 @@
 #include "G8RTOS.h"
 //#include "Threads.h"
 #include <time.h>
+#include <stdio.h>
 
 
 void main(void){
@@ -21,6 +22,21 @@ void main(void){
     //Initialize the OS, board, and LCD
     G8RTOS_Init();
 
+#ifdef LCD_BENCHMARK
+    //Benchmark mode: measure the LCD bus and show the numbers instead of starting the game
+    LCDBenchmark bench;
+    char str[32];
+    LCD_Benchmark(&bench);
+    LCD_Clear(LCD_BLACK, MAX_SCREEN_X, MAX_SCREEN_Y);
+    snprintf(str, 32, "SPI: %lu Hz", bench.spiClockHz);
+    LCD_Text(10, 10, (uint8_t *)str, LCD_WHITE);
+    snprintf(str, 32, "Clear: %lu us", bench.clearTimeUs);
+    LCD_Text(10, 30, (uint8_t *)str, LCD_WHITE);
+    snprintf(str, 32, "Fill: %lu KB/s", bench.fillBytesPerSec / 1000);
+    LCD_Text(10, 50, (uint8_t *)str, LCD_WHITE);
+    while(1);
+#endif
+
     //Add an idle thread as thread 1, with low priority
     G8RTOS_AddThread(IdleThread,5, "idle");
 
@@ -30,6 +46,9 @@ void main(void){
     //Add the ISR for the touch screen
     G8RTOS_AddAPeriodicEvent(Button_isr, 0, PORT4_IRQn);
 
+    //Pace the renderer off the LCD's frame marker
+    VSync_Init();
+
     //Start the OS
     G8RTOS_Launch();
 }
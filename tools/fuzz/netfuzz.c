@@ -0,0 +1,340 @@
+/*
+ * netfuzz.c
+ *
+ * Fuzz target for everything a datagram from the air goes through before the
+ * game sees it: Net_ParsePacket, the bundle reader and the snapshot, input and
+ * reliable decoders, dispatched the way NetGame_ReadPacket does. The first
+ * input byte picks the mode: odd feeds the rest as a raw datagram, even wraps
+ * it as a bundle payload with a valid header and CRC so the decoders behind
+ * the CRC are reached too.
+ *
+ *     clang -g -O1 -fsanitize=fuzzer,address,undefined -DNETFUZZ_LIBFUZZER \
+ *         -I. tools/fuzz/netfuzz.c NetProtocol.c Snapshot.c Input.c Reliable.c -o netfuzz
+ *     gcc -g -O1 -fsanitize=address,undefined \
+ *         -I. tools/fuzz/netfuzz.c NetProtocol.c Snapshot.c Input.c Reliable.c -o netfuzz
+ *     ./netfuzz [iterations | files...]
+ *
+ * Without libFuzzer, main() replays the given files, or first checks that
+ * every single bit error in a set of valid packets is rejected, bit errors in
+ * the version byte as NET_ERR_CRC, then runs iterations random mutations of
+ * those packets (200000 by default). Exits with 1 on a failed check, the
+ * sanitizers abort on a memory error.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NetProtocol.h"
+#include "Snapshot.h"
+#include "Input.h"
+#include "Reliable.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define NUM_SEEDS              4
+#define MAX_MUTATIONS          4
+#define VERSION_OFFSET         2                        // Version byte in the header
+
+typedef struct
+{
+    uint8_t data[NET_MAX_DATAGRAM];
+    uint16_t length;
+} Seed_t;
+
+static SnapshotHistory_t history;
+static Snapshot_t base;
+static Seed_t seeds[NUM_SEEDS];                         // Bundle datagrams the game could send
+static uint32_t rng = 1;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static void Check(bool ok, const char *what)
+{
+    if(!ok){
+        printf("FAILED: %s\n", what);
+        fflush(stdout);
+        abort();
+    }
+}
+
+/*
+ * A history with a few snapshots in it, so delta snapshots find their base
+ */
+static void Setup()
+{
+    static bool done;
+    GameState_t state;
+
+    if(done){
+        return;
+    }
+    done = true;
+
+    memset(&state, 0, sizeof(state));
+    state.numberOfBalls = 2;
+    for(int i = 0; i < 2; i++){
+        state.balls[i].alive = true;
+        state.balls[i].currentCenterX = 40 + 50 * i;
+        state.balls[i].currentCenterY = 60 + 30 * i;
+    }
+    Snapshot_ClearHistory(&history);
+    for(uint16_t seq = 1; seq <= SNAPSHOT_HISTORY; seq++){
+        Snapshot_Capture(&base, &state);
+        base.sequence = seq;
+        Snapshot_Store(&history, &base);
+    }
+}
+
+/*
+ * Handles one datagram as NetGame_ReadPacket would, on a fresh reliable channel
+ */
+static net_ErrCode_t Receive(const uint8_t *buf, uint16_t len)
+{
+    static ReliableChannel_t channel;
+    NetHeader_t hdr;
+    NetBundleReader_t reader;
+    Snapshot_t snap;
+    InputPacket_t input;
+    const uint8_t *payload;
+    uint8_t event[REL_MAX_PAYLOAD];
+    uint8_t type, eventLen;
+    uint16_t msgLen;
+    net_ErrCode_t err;
+
+    err = Net_ParsePacket(buf, len, &hdr);
+    if(err != NET_OK || hdr.type != NET_MSG_BUNDLE){
+        return err;
+    }
+    Check(hdr.length == len - NET_OVERHEAD, "parsed length");
+
+    Rel_Init(&channel);
+    Net_BundleOpen(&reader, buf, &hdr);
+    while(Net_BundleNext(&reader, &type, &payload, &msgLen)){
+        Check(payload >= buf + NET_HEADER_SIZE && payload + msgLen <= buf + NET_HEADER_SIZE + hdr.length,
+              "bundled message outside the payload");
+        switch(type){
+        case NET_MSG_SNAPSHOT:
+            Snapshot_Decode(payload, msgLen, &history, &snap);
+            break;
+        case NET_MSG_INPUT:
+            if(Input_Decode(payload, msgLen, &input)){
+                Check(input.count <= INPUT_BUFFER_SIZE, "input count");
+            }
+            break;
+        case NET_MSG_ACK:
+        case NET_MSG_RELIABLE:
+            Rel_Read(&channel, type, payload, msgLen, 0);
+            break;
+        default:
+            break;
+        }
+    }
+    while(Rel_Deliver(&channel, &type, event, &eventLen)){
+        Check(eventLen <= REL_MAX_PAYLOAD, "event length");
+    }
+    return err;
+}
+
+static uint32_t Random()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/*
+ * Datagrams the game sends: full and delta snapshots, inputs, events and acks
+ */
+static void BuildSeeds()
+{
+    NetBundle_t bundle;
+    ReliableChannel_t a, b;
+    InputBuffer_t inputs;
+    NetHeader_t hdr;
+    NetBundleReader_t reader;
+    const uint8_t *payload;
+    uint16_t len;
+    uint8_t type;
+    Snapshot_t snap = base;
+    uint8_t msg[NET_SUBMSG_MAX_SIZE];
+    uint8_t join[4] = {10, 0, 0, 7};
+
+    snap.sequence = base.sequence + 1;
+    snap.balls[0].x += 3;
+    snap.LEDScores[1] = 2;
+
+    Net_BundleBegin(&bundle);
+    Net_BundleAdd(&bundle, NET_MSG_SNAPSHOT, msg, Snapshot_Encode(&snap, NULL, msg));
+    seeds[0].length = Net_BundleFinish(&bundle, 1);
+    memcpy(seeds[0].data, bundle.data, seeds[0].length);
+
+    Net_BundleBegin(&bundle);
+    Net_BundleAdd(&bundle, NET_MSG_SNAPSHOT, msg, Snapshot_Encode(&snap, &base, msg));
+    seeds[1].length = Net_BundleFinish(&bundle, 2);
+    memcpy(seeds[1].data, bundle.data, seeds[1].length);
+
+    Input_Clear(&inputs);
+    for(int i = 0; i < 6; i++){
+        Input_Push(&inputs, i * 3 - 7);
+    }
+    Net_BundleBegin(&bundle);
+    Net_BundleAdd(&bundle, NET_MSG_INPUT, msg, Input_Encode(&inputs, base.sequence, msg));
+    seeds[2].length = Net_BundleFinish(&bundle, 3);
+    memcpy(seeds[2].data, bundle.data, seeds[2].length);
+
+    //An ack from b for a's first event, then b's events ride with it
+    Rel_Init(&a);
+    Rel_Init(&b);
+    Rel_Send(&a, NET_EVT_JOIN, join, sizeof(join));
+    Net_BundleBegin(&bundle);
+    Rel_Write(&a, &bundle, 0);
+    Net_BundleFinish(&bundle, 4);
+    Net_ParsePacket(bundle.data, NET_OVERHEAD + bundle.length, &hdr);
+    Net_BundleOpen(&reader, bundle.data, &hdr);
+    while(Net_BundleNext(&reader, &type, &payload, &len)){
+        Rel_Read(&b, type, payload, len, 0);
+    }
+    Rel_Send(&b, NET_EVT_JOIN_ACK, join, 1);
+    Rel_Send(&b, NET_EVT_SCORE, join, 2);
+    Net_BundleBegin(&bundle);
+    Rel_Write(&b, &bundle, 0);
+    seeds[3].length = Net_BundleFinish(&bundle, 5);
+    memcpy(seeds[3].data, bundle.data, seeds[3].length);
+}
+
+/*
+ * Every single bit error must be caught, and never read as another protocol version
+ */
+static void CheckBitErrors()
+{
+    uint8_t buf[NET_MAX_DATAGRAM];
+    net_ErrCode_t err;
+
+    for(int s = 0; s < NUM_SEEDS; s++){
+        Check(Receive(seeds[s].data, seeds[s].length) == NET_OK, "seed packet rejected");
+        for(int bit = 0; bit < seeds[s].length * 8; bit++){
+            memcpy(buf, seeds[s].data, seeds[s].length);
+            buf[bit / 8] ^= 1 << (bit % 8);
+            err = Receive(buf, seeds[s].length);
+            Check(err != NET_OK, "bit error accepted");
+            Check(err != NET_ERR_VERSION, "bit error reported as a version mismatch");
+            if(bit / 8 == VERSION_OFFSET){
+                Check(err == NET_ERR_CRC, "version bit error not reported as NET_ERR_CRC");
+            }
+        }
+    }
+}
+
+/*
+ * Flips bits, overwrites, inserts and drops bytes
+ */
+static size_t Mutate(uint8_t *buf, size_t len, size_t max)
+{
+    for(uint32_t n = Random() % MAX_MUTATIONS + 1; n; n--){
+        uint32_t at = len ? Random() % len : 0;
+        switch(Random() % 4){
+        case 0:
+            if(len){
+                buf[at] ^= 1 << (Random() % 8);
+            }
+            break;
+        case 1:
+            if(len){
+                buf[at] = Random();
+            }
+            break;
+        case 2:
+            if(len < max){
+                memmove(buf + at + 1, buf + at, len - at);
+                buf[at] = Random();
+                len++;
+            }
+            break;
+        default:
+            if(len){
+                memmove(buf + at, buf + at + 1, len - at - 1);
+                len--;
+            }
+            break;
+        }
+    }
+    return len;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uint8_t packet[NET_MAX_DATAGRAM];
+    uint16_t len;
+
+    Setup();
+    if(!size){
+        return 0;
+    }
+
+    if(data[0] & 1){
+        Receive(data + 1, size - 1 > 0xffff ? 0xffff : size - 1);
+    } else {
+        len = size - 1 > NET_MAX_DATAGRAM - NET_OVERHEAD ? NET_MAX_DATAGRAM - NET_OVERHEAD : size - 1;
+        memcpy(packet + NET_HEADER_SIZE, data + 1, len);
+        len = Net_FinishPacket(packet, NET_MSG_BUNDLE, 0, len);
+        Check(Receive(packet, len) == NET_OK, "packet with a valid CRC rejected");
+    }
+    return 0;
+}
+
+#ifndef NETFUZZ_LIBFUZZER
+int main(int argc, char **argv)
+{
+    uint8_t input[NET_MAX_DATAGRAM + 1 + MAX_MUTATIONS];
+    uint32_t iterations = 200000;
+    const Seed_t *seed;
+    size_t len;
+
+    Setup();
+    BuildSeeds();
+
+    //Replay files, as libFuzzer would
+    if(argc > 1 && !(argv[1][0] >= '0' && argv[1][0] <= '9')){
+        for(int i = 1; i < argc; i++){
+            static uint8_t file[1 << 16];
+            FILE *f = fopen(argv[i], "rb");
+            if(!f){
+                perror(argv[i]);
+                return 1;
+            }
+            len = fread(file, 1, sizeof(file), f);
+            fclose(f);
+            LLVMFuzzerTestOneInput(file, len);
+        }
+        printf("%d inputs OK\n", argc - 1);
+        return 0;
+    }
+    if(argc > 1){
+        iterations = atoi(argv[1]);
+    }
+
+    CheckBitErrors();
+    printf("every single bit error in %d packets rejected\n", NUM_SEEDS);
+
+    for(uint32_t i = 0; i < iterations; i++){
+        seed = &seeds[Random() % NUM_SEEDS];
+        input[0] = Random();
+        if(input[0] & 1){
+            memcpy(input + 1, seed->data, seed->length);
+            len = seed->length;
+        } else {
+            len = seed->length - NET_OVERHEAD;
+            memcpy(input + 1, seed->data + NET_HEADER_SIZE, len);
+        }
+        len = Mutate(input + 1, len, sizeof(input) - 1);
+        LLVMFuzzerTestOneInput(input, len + 1);
+    }
+    printf("%u mutated packets OK\n", iterations);
+    return 0;
+}
+#endif
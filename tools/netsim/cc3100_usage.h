@@ -0,0 +1,144 @@
+/*
+ * cc3100_usage.h
+ *
+ * Linux stand-in for CC3100SupportPackage/cc3100_usage/cc3100_usage.h.
+ *
+ * Put this directory ahead of the support package on the include path and link
+ * netsim.c instead of cc3100_usage.c. Each process is one board: datagrams travel
+ * over UDP on 127.0.0.1 and every board address maps to port NETSIM_BASE_PORT plus
+ * its last octet. Sent datagrams pass through a configurable impairment stage
+ * (loss, latency, jitter, duplication, reordering) before they reach the socket.
+ *
+ *     gcc -pthread -Itools/netsim ... tools/netsim/netsim.c
+ *
+ * gamesim.c in this directory runs the game's own network code (NetGame.c) on it.
+ *
+ * The impairments can also be set from the environment, so two unmodified
+ * processes can be run against each other:
+ *     NETSIM_LOSS, NETSIM_DUPLICATE, NETSIM_REORDER   percent
+ *     NETSIM_TX_FAIL   percent of sends reported as SOCKET_TX_FAILED instead
+ *     NETSIM_LATENCY, NETSIM_JITTER, NETSIM_REORDER_DELAY   ms
+ *     NETSIM_SEED      random seed
+ *     NETSIM_CLIENT    last octet of the client address (default 10)
+ */
+
+#ifndef CC3100_USAGE_H_
+#define CC3100_USAGE_H_
+
+/********************** Includes *********************/
+#include <stdint.h>
+/********************** Includes *********************/
+
+/**************************** Defines ******************************/
+typedef uint8_t  _u8;
+typedef int16_t  _i16;
+typedef uint16_t _u16;
+typedef int32_t  _i32;
+typedef uint32_t _u32;
+
+/*
+ * Determines whether player is the host or client
+ */
+typedef enum
+{
+    Client = 0,
+    Host = 1
+}playerType;
+
+#define HOST_IP_ADDR           0xC0A80109               // IP address of server to connect to
+#define PORT_NUM               5001                     // Port number to be used
+
+#define NOTHING_RECEIVED -1
+
+#define RX_RING_SIZE           5                        // Slots to lend to the RX ring
+#define RX_PACKET_SIZE         128                      // Largest datagram kept, longer ones are truncated
+
+/*
+ * One slot of the RX ring, recvfrom writes straight into it
+ */
+typedef struct
+{
+    _u8 data[RX_PACKET_SIZE];
+    _i16 length;
+    _u32 from;                      // Sender's board address
+} RxPacket_t;
+
+/*
+ * Socket readiness and error notifications, see registerSocketEventHandler
+ */
+typedef enum
+{
+    SOCKET_RX_READY = 0,            // value datagrams were added to the RX ring, IP is 0
+    SOCKET_TX_FAILED = 1,           // The device could not send to IP, value is the SimpleLink status
+    SOCKET_ERROR = 2                // Async socket error, value is its type
+} SocketEvent_e;
+
+typedef void (*SocketEventHandler_t)(SocketEvent_e event, _u32 IP, _i16 value);
+
+/* Status passed with SOCKET_TX_FAILED, SimpleLink's SL_ENOBUFS */
+#define NETSIM_TX_FAIL_STATUS  (-105)
+
+/* Board address a.b.c.d is reached at 127.0.0.1 port NETSIM_BASE_PORT + d */
+#define NETSIM_BASE_PORT       (PORT_NUM + 1000)
+
+/* Datagrams held back by the impairment stage at one time */
+#define NETSIM_QUEUE_SIZE      256
+
+/*
+ * Impairments applied to every datagram this process sends
+ */
+typedef struct
+{
+    uint8_t lossPercent;
+    uint8_t duplicatePercent;
+    uint8_t reorderPercent;     // datagrams held back an extra reorderDelayMs
+    uint8_t txFailPercent;      // datagrams dropped and reported as SOCKET_TX_FAILED after latencyMs
+    uint16_t latencyMs;
+    uint16_t jitterMs;          // uniform, +-jitterMs around latencyMs
+    uint16_t reorderDelayMs;
+    uint32_t seed;
+} NetSimConfig_t;
+
+/*
+ * Counters for bandwidth and correctness checks
+ */
+typedef struct
+{
+    uint32_t sent;              // SendData calls
+    uint32_t bytesSent;
+    uint32_t lost;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t queueFull;         // dropped because the impairment queue was full
+    uint32_t txFailed;          // reported as SOCKET_TX_FAILED
+    uint32_t received;
+    uint32_t bytesReceived;
+    uint32_t truncated;         // longer than the caller's buffer
+} NetSimStats_t;
+/**************************** Defines ******************************/
+
+
+/*********************** User Functions ************************/
+void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE);
+_i32 ReceiveData(_u8 *data, _u16 BUF_SIZE);
+_i32 ReceiveDataNonBlocking(_u8 *data, _u16 BUF_SIZE);
+_i32 ReceiveDatagram(_u8 *data, _u16 BUF_SIZE, _u32 *IP);
+_i32 ReceiveDatagramNonBlocking(_u8 *data, _u16 BUF_SIZE, _u32 *IP);
+void lendRxRing(RxPacket_t *slots, _u8 count);
+RxPacket_t *ReceivePacket();
+RxPacket_t *ReceivePacketNonBlocking();
+void ReleasePacket(RxPacket_t *packet);
+_u32 getRxDropped();
+void registerSocketEventHandler(SocketEventHandler_t handler);
+void initCC3100(playerType playerRole);
+_u32 getLocalIP();
+/*********************** User Functions ************************/
+
+
+/*********************** Simulator Functions ************************/
+void NetSim_Configure(const NetSimConfig_t *config);
+void NetSim_GetStats(NetSimStats_t *stats);
+void NetSim_ResetStats();
+/*********************** Simulator Functions ************************/
+
+#endif /* CC3100_USAGE_H_ */
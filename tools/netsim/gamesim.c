@@ -0,0 +1,478 @@
+/*
+ * gamesim.c
+ *
+ * Runs the game's network code (NetGame and the protocol modules under it) as
+ * host and client processes over netsim, so joining, the snapshot and input
+ * streams, the reliable events and the rate controllers can be exercised and
+ * measured off target with the impairments from cc3100_usage.h.
+ *
+ *     gamesim host [clients] [seconds]     host waiting for clients, 1 by default
+ *     gamesim client [seconds]             one client, NETSIM_CLIENT picks its address
+ *     gamesim bench [clients] [seconds]    forks a host and clients against each other
+ *
+ * The host stands in for the game threads: balls bounce and score, its paddle
+ * sweeps, and after seconds (10 by default) it ends the game and waits for the
+ * clients to acknowledge it. Clients sweep their paddle every input tick and
+ * sample the jitter buffer every frame. Each process prints one line of
+ * results; a client fails the run if it never joins, never hears the game over
+ * or ends with other scores than the host.
+ *
+ *     gcc -O2 -pthread -Itools/netsim -I. -IG8RTOS tools/netsim/gamesim.c tools/netsim/netsim.c \
+ *         NetGame.c NetProtocol.c Snapshot.c Input.c Interpolation.c Reliable.c Session.c RateControl.c \
+ *         -o gamesim
+ *     NETSIM_LOSS=15 ./gamesim bench 3
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "cc3100_usage.h"
+#include "NetGame.h"
+#include "Input.h"
+#include "Interpolation.h"
+#include "Session.h"
+#include "G8RTOS_CriticalSection.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define FRAME_PERIOD_MS        16                       // DrawObjects at the panel's refresh
+#define BALL_PERIOD_MS         35                       // MoveBall
+#define BALLS_IN_PLAY          4
+#define JOIN_TIMEOUT_MS        10000
+#define GAME_OVER_FLUSH_MS     2000                     // as in Game.h
+#define CLIENT_GRACE_MS        (JOIN_TIMEOUT_MS + GAME_OVER_FLUSH_MS + 3000)
+
+static GameState_t game;
+static SpecificPlayerInfo_t self;
+static RxPacket_t rxPackets[RX_RING_SIZE];
+static uint64_t startTime;
+static volatile bool running = true;
+static volatile bool moving = true;             // cleared at the game over, as EndOfGameClient kills ReadJoystickClient
+
+/* Stands in for the PRIMASK, one lock for every thread */
+static pthread_mutex_t primask;
+
+/* Host */
+static uint32_t ticks;
+static uint64_t tickNs;
+static uint64_t maxTickNs;
+static uint32_t gameOverRetries;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static uint64_t Nanoseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* SystemTime, ms since start */
+static uint32_t Now()
+{
+    return (Nanoseconds() - startTime) / 1000000;
+}
+
+static void Sleep(uint32_t ms)
+{
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+static void DrainPackets()
+{
+    RxPacket_t *rx;
+
+    while((rx = ReceivePacketNonBlocking())){
+        NetGame_ReadPacket(rx->from, rx->data, rx->length, Now());
+        ReleasePacket(rx);
+    }
+}
+
+/*
+ * SocketEvent in Game.c
+ */
+static void SocketEvent(SocketEvent_e event, _u32 IP, _i16 value)
+{
+    (void)value;
+    if(event == SOCKET_TX_FAILED && IP){
+        NetGame_SendFailed(IP);
+    }
+}
+
+/*
+ * ReceiveDataFromClient and ReceiveDataFromHost, keeps reading acks after the game ends
+ */
+static void *ReceiveThread(void *arg)
+{
+    RxPacket_t *rx;
+
+    (void)arg;
+    while(1){
+        rx = ReceivePacket();
+        NetGame_ReadPacket(rx->from, rx->data, rx->length, Now());
+        ReleasePacket(rx);
+    }
+    return NULL;
+}
+
+/*
+ * A paddle sweeping across the arena and back, as a joystick held to each side in turn
+ */
+static int16_t Sweep(uint32_t step)
+{
+    return (step / 40) % 2 ? 5 : -5;
+}
+
+/*
+ * MoveBall for a few balls at once, a ball that reaches a goal scores for the team that hit it last
+ */
+static void *BallThread(void *arg)
+{
+    int32_t mask;
+    int16_t x, y;
+    uint8_t scores[2];
+    int scored;
+
+    (void)arg;
+    for(int i = 0; i < BALLS_IN_PLAY; i++){
+        game.balls[i].alive = 1;
+        game.balls[i].currentCenterX = (ARENA_MIN_X + ARENA_MAX_X) / 2 + 20 * i;
+        game.balls[i].currentCenterY = (ARENA_MIN_Y + ARENA_MAX_Y) / 2;
+        game.balls[i].velocityX = 2 + i % 2;
+        game.balls[i].velocityY = i % 2 ? 3 : -3;
+    }
+
+    while(running){
+        scored = -1;
+        mask = StartCriticalSection();
+        for(int i = 0; i < BALLS_IN_PLAY; i++){
+            Ball_t *b = &game.balls[i];
+
+            x = b->currentCenterX + b->velocityX;
+            y = b->currentCenterY + b->velocityY;
+            if(x >= HORIZ_CENTER_MAX_BALL || x <= HORIZ_CENTER_MIN_BALL){
+                b->velocityX = -b->velocityX;
+                x = b->currentCenterX;
+            }
+            if(y >= VERT_CENTER_MAX_BALL || y <= VERT_CENTER_MIN_BALL){
+                scored = y <= VERT_CENTER_MIN_BALL;
+                if(game.LEDScores[scored] < 8){
+                    game.LEDScores[scored]++;
+                }
+                b->velocityY = -b->velocityY;
+                y = (ARENA_MIN_Y + ARENA_MAX_Y) / 2;
+            }
+            b->currentCenterX = x;
+            b->currentCenterY = y;
+        }
+        scores[0] = game.LEDScores[0];
+        scores[1] = game.LEDScores[1];
+        EndCriticalSection(mask);
+
+        if(scored >= 0){
+            NetGame_BroadcastLatest(NET_EVT_SCORE, scores, 2);
+        }
+        Sleep(BALL_PERIOD_MS);
+    }
+    return NULL;
+}
+
+static void PrintRate(uint8_t link)
+{
+    RateStats_t rate;
+
+    if(NetGame_GetRateStats(link, &rate)){
+        printf(" link%u period %u srtt %u loss %u backoffs %u", link, rate.period, rate.srtt, rate.loss, rate.backoffs);
+        if(rate.sendFailures){
+            printf(" send failures %u", rate.sendFailures);
+        }
+    }
+}
+
+/*
+ * Host: reliable channel of a client session
+ */
+static void PrintEvents(uint8_t link)
+{
+    Session_t *s = Session_Get(link);
+    RelStats_t events;
+
+    if(s){
+        Rel_GetStats(&s->channel, &events);
+        printf(" link%u events %u resent %u full %u replaced %u", link, events.sent, events.retransmits,
+               events.full, events.replaced);
+    }
+}
+
+static void PrintTraffic(const char *role, uint32_t seconds)
+{
+    TrafficStats_t traffic;
+    NetSimStats_t sim;
+
+    NetGame_GetTrafficStats(&traffic);
+    NetSim_GetStats(&sim);
+    printf("%s: sent %u (%u B/s) received %u lost %u late %u duplicates %u srtt %u loss %u",
+           role, traffic.sent, sim.bytesSent / (seconds ? seconds : 1), traffic.received,
+           traffic.lost, traffic.late, traffic.duplicates, traffic.srtt, traffic.loss);
+    if(traffic.inputsOverwritten){
+        printf(" inputs overwritten %u", traffic.inputsOverwritten);
+    }
+}
+
+static int RunHost(uint8_t clients, uint32_t seconds)
+{
+    pthread_t rxThread, ballThread;
+    uint8_t result[3];
+    uint32_t end, i;
+    int32_t mask;
+    bool queued;
+
+    lendRxRing(rxPackets, RX_RING_SIZE);
+    initCC3100(Host);
+    NetGame_Init(Host, &game, &self);
+    registerSocketEventHandler(SocketEvent);
+    NetGame_HostOpen();
+
+    while(NetGame_HostJoinStep(Now()) < clients){
+        if(Now() > JOIN_TIMEOUT_MS){
+            printf("host: only %u of %u clients joined\n", Session_Count(true), clients);
+            return 1;
+        }
+        Sleep(NETGAME_JOIN_STEP_MS);
+        DrainPackets();
+    }
+    NetGame_HostStart();
+
+    pthread_create(&rxThread, NULL, ReceiveThread, NULL);
+    pthread_create(&ballThread, NULL, BallThread, NULL);
+    NetSim_ResetStats();
+
+    //SendDataToClient, with ReadJoystickHost folded in
+    end = Now() + seconds * 1000;
+    for(i = 0; Now() < end; i++){
+        uint64_t t = Nanoseconds();
+        mask = StartCriticalSection();
+        game.players[0].currentCenter = Input_MovePaddle(game.players[0].currentCenter, Sweep(i));
+        EndCriticalSection(mask);
+
+        NetGame_HostTick(Now());
+        t = Nanoseconds() - t;
+        tickNs += t;
+        if(t > maxTickNs){
+            maxTickNs = t;
+        }
+        ticks++;
+        Sleep(RATE_MIN_PERIOD_MS);
+    }
+
+    //Stats of the game itself, before the clients go quiet
+    running = false;
+    pthread_join(ballThread, NULL);
+    PrintTraffic("host", seconds);
+    printf(" tick %llu/%llu us avg/max", (unsigned long long)(tickNs / ticks / 1000), (unsigned long long)(maxTickNs / 1000));
+    for(i = 0; i < MAX_SESSIONS; i++){
+        PrintRate(i);
+    }
+
+    //MoveBall ends the game in the state the snapshots carry, then EndOfGameHost sends the result
+    mask = StartCriticalSection();
+    game.overallScores[0] = game.LEDScores[0];
+    game.overallScores[1] = game.LEDScores[1];
+    game.winner = game.LEDScores[1] > game.LEDScores[0];
+    game.gameDone = 1;
+    EndCriticalSection(mask);
+    result[0] = game.winner;
+    result[1] = game.overallScores[0];
+    result[2] = game.overallScores[1];
+    end = Now();
+    queued = false;
+    for(i = 0; i < GAME_OVER_FLUSH_MS / RATE_MIN_PERIOD_MS; i++){
+        if(!queued && !(queued = NetGame_Broadcast(NET_EVT_GAME_OVER, result, sizeof(result)))){
+            gameOverRetries++;
+        }
+        if(queued && NetGame_EventsDelivered()){
+            break;
+        }
+        NetGame_HostTick(Now());
+        Sleep(RATE_MIN_PERIOD_MS);
+    }
+    printf("\n      score %u:%u game over retries %u acknowledged %s %u ms\n      ",
+           result[1], result[2], gameOverRetries, NetGame_EventsDelivered() ? "after" : "NOT in", Now() - end);
+    for(i = 0; i < MAX_SESSIONS; i++){
+        PrintEvents(i);
+    }
+    printf("\n");
+    return queued && NetGame_EventsDelivered() ? 0 : 1;
+}
+
+/*
+ * SendDataToHost
+ */
+static void *SendThread(void *arg)
+{
+    (void)arg;
+    while(running){
+        Sleep(NetGame_ClientTick(Now()));
+    }
+    return NULL;
+}
+
+/*
+ * ReadJoystickClient
+ */
+static void *InputThread(void *arg)
+{
+    (void)arg;
+    for(uint32_t i = 0; moving; i++){
+        NetGame_ClientMove(Sweep(i));
+        Sleep(INPUT_PERIOD_MS);
+    }
+    return NULL;
+}
+
+static int RunClient(uint32_t seconds)
+{
+    pthread_t rxThread, txThread, inThread;
+    Ball_t balls[MAX_NUM_OF_BALLS];
+    InterpStats_t interp;
+    uint32_t joined, frames = 0;
+    int32_t mask;
+    bool done, scoresMatch;
+    char name[16];
+
+    lendRxRing(rxPackets, RX_RING_SIZE);
+    initCC3100(Client);
+    NetGame_Init(Client, &game, &self);
+    registerSocketEventHandler(SocketEvent);
+    NetGame_ClientOpen(HOST_IP_ADDR, getLocalIP(), Now());
+
+    while(!NetGame_ClientJoinStep(Now())){
+        if(Now() > JOIN_TIMEOUT_MS){
+            printf("client %u: never joined\n", getLocalIP() & 0xFF);
+            return 1;
+        }
+        Sleep(NETGAME_JOIN_STEP_MS);
+        DrainPackets();
+    }
+    NetGame_ClientReady(Now());
+    joined = Now();
+    for(int i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        NetGame_InitPlayer(i);
+        if(i != 0 && i != self.playerNumber){
+            game.players[i].currentCenter = PLAYER_ABSENT;
+        }
+    }
+
+    pthread_create(&rxThread, NULL, ReceiveThread, NULL);
+    pthread_create(&txThread, NULL, SendThread, NULL);
+    pthread_create(&inThread, NULL, InputThread, NULL);
+    NetSim_ResetStats();
+
+    //DrawObjects, until the host ends the game
+    do{
+        Interp_Sample(Now(), balls);
+        frames++;
+        Sleep(FRAME_PERIOD_MS);
+        mask = StartCriticalSection();
+        done = game.gameDone;
+        EndCriticalSection(mask);
+    } while(!done && Now() < joined + seconds * 1000 + CLIENT_GRACE_MS);
+
+    //EndOfGameClient keeps the send path acking the game over while the host flushes it
+    moving = false;
+    Sleep(GAME_OVER_FLUSH_MS);
+    running = false;
+
+    //The last score event is delivered before the game over that repeats it
+    scoresMatch = game.LEDScores[0] == game.overallScores[0] && game.LEDScores[1] == game.overallScores[1];
+
+    Interp_GetStats(&interp);
+    snprintf(name, sizeof(name), "client %u", getLocalIP() & 0xFF);
+    PrintTraffic(name, seconds);
+    printf(" joined %u ms", joined);
+    PrintRate(0);
+    printf("\n      frames %u interpolated %u extrapolated %u held %u late %u delay %u jitter %u score %u:%u %s\n",
+           frames, interp.interpolated, interp.extrapolated, interp.held, interp.late, interp.delay, interp.jitter,
+           game.LEDScores[0], game.LEDScores[1], !done ? "NO GAME OVER" : scoresMatch ? "ok" : "SCORE MISMATCH");
+    return done && scoresMatch ? 0 : 1;
+}
+
+static int Bench(uint8_t clients, uint32_t seconds)
+{
+    char octet[4];
+    pid_t pid;
+    int status, failed = 0;
+
+    if(!fork()){
+        exit(RunHost(clients, seconds));
+    }
+    for(uint8_t i = 0; i < clients; i++){
+        if(!fork()){
+            snprintf(octet, sizeof(octet), "%u", 10 + i);
+            setenv("NETSIM_CLIENT", octet, 1);
+            exit(RunClient(seconds));
+        }
+    }
+    while((pid = wait(&status)) > 0){
+        if(!WIFEXITED(status) || WEXITSTATUS(status)){
+            failed = 1;
+        }
+    }
+    printf("%s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/*********************************************** PUBLIC FUNCTIONS ************************************************************/
+int32_t StartCriticalSection()
+{
+    pthread_mutex_lock(&primask);
+    return 0;
+}
+
+void EndCriticalSection(int32_t IBit_State)
+{
+    (void)IBit_State;
+    pthread_mutex_unlock(&primask);
+}
+
+int main(int argc, char **argv)
+{
+    pthread_mutexattr_t attr;
+    uint8_t clients = argc > 2 ? atoi(argv[2]) : 1;
+    uint32_t seconds;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&primask, &attr);
+    startTime = Nanoseconds();
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    if(argc > 1 && !strcmp(argv[1], "client")){
+        return RunClient(argc > 2 ? atoi(argv[2]) : 10);
+    }
+
+    seconds = argc > 3 ? atoi(argv[3]) : 10;
+    if(argc < 2 || clients < 1 || clients > MAX_SESSIONS){
+        fprintf(stderr, "usage: gamesim host|bench [1-%u clients] [seconds] | gamesim client [seconds]\n", MAX_SESSIONS);
+        return 2;
+    }
+    if(!strcmp(argv[1], "host")){
+        return RunHost(clients, seconds);
+    }
+    if(!strcmp(argv[1], "bench")){
+        return Bench(clients, seconds);
+    }
+    fprintf(stderr, "usage: gamesim host|bench [1-%u clients] [seconds] | gamesim client [seconds]\n", MAX_SESSIONS);
+    return 2;
+}
+/*********************************************** PUBLIC FUNCTIONS ************************************************************/
@@ -0,0 +1,414 @@
+/*
+ * netsim.c
+ *
+ * Linux stand-in for cc3100_usage.c, see cc3100_usage.h in this directory.
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "cc3100_usage.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define MAX_DATAGRAM           1472
+
+typedef struct
+{
+    uint64_t due;               // ms, monotonic
+    uint32_t IP;
+    uint16_t length;
+    bool failed;                // reported as SOCKET_TX_FAILED instead of sent
+    _u8 data[MAX_DATAGRAM];
+} Pending_t;
+
+static int sock = -1;
+static _u32 localIP;
+static bool configured;
+static NetSimConfig_t config;
+static NetSimStats_t stats;
+static uint32_t rng;
+
+/* Impairment queue, sorted by due time, guarded by lock */
+static Pending_t queue[NETSIM_QUEUE_SIZE];
+static int queued;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake;
+static pthread_t txThread;
+static SocketEventHandler_t socketEventHandler;
+
+/* Lent by the application, one slot is received into at a time */
+static RxPacket_t *rxRing;
+static _u8 rxRingSize;
+static _u8 rxNext;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static uint64_t NowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* xorshift32, called with lock held */
+static uint32_t Random()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static bool Chance(uint8_t percent)
+{
+    return percent && Random() % 100 < percent;
+}
+
+static struct sockaddr_in Address(_u32 IP)
+{
+    struct sockaddr_in addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(NETSIM_BASE_PORT + (IP & 0xFF));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+static uint16_t EnvValue(const char *name, uint16_t fallback)
+{
+    const char *value = getenv(name);
+    return value ? (uint16_t)atoi(value) : fallback;
+}
+
+/*
+ * Places one copy of a datagram in the queue, called with lock held
+ */
+static void Enqueue(const _u8 *data, _u32 IP, _u16 length, bool failed)
+{
+    Pending_t *p;
+    int64_t delay;
+    uint64_t due;
+    int i;
+
+    if(queued == NETSIM_QUEUE_SIZE){
+        stats.queueFull++;
+        return;
+    }
+
+    delay = config.latencyMs;
+    if(config.jitterMs){
+        delay += (int64_t)(Random() % (2 * config.jitterMs + 1)) - config.jitterMs;
+    }
+    if(Chance(config.reorderPercent)){
+        delay += config.reorderDelayMs;
+        stats.reordered++;
+    }
+    due = NowMs() + (delay > 0 ? delay : 0);
+
+    //Insertion keeps the queue sorted, equal due times keep their send order
+    for(i = queued; i > 0 && queue[i - 1].due > due; i--){
+        queue[i] = queue[i - 1];
+    }
+    p = &queue[i];
+    p->due = due;
+    p->IP = IP;
+    p->length = length;
+    p->failed = failed;
+    memcpy(p->data, data, length);
+    queued++;
+}
+
+/*
+ * Sends queued datagrams once they are due
+ */
+static void *TxThread(void *arg)
+{
+    Pending_t p;
+    struct sockaddr_in addr;
+    struct timespec until;
+    uint64_t now;
+
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    while(1){
+        if(!queued){
+            pthread_cond_wait(&wake, &lock);
+            continue;
+        }
+
+        now = NowMs();
+        if(queue[0].due > now){
+            until.tv_sec = queue[0].due / 1000;
+            until.tv_nsec = (queue[0].due % 1000) * 1000000;
+            pthread_cond_timedwait(&wake, &lock, &until);
+            continue;
+        }
+
+        p = queue[0];
+        queued--;
+        memmove(&queue[0], &queue[1], queued * sizeof(Pending_t));
+
+        pthread_mutex_unlock(&lock);
+        if(p.failed){
+            //The device reports a failed send from its own thread, some time after the call
+            if(socketEventHandler){
+                socketEventHandler(SOCKET_TX_FAILED, p.IP, NETSIM_TX_FAIL_STATUS);
+            }
+        } else {
+            addr = Address(p.IP);
+            sendto(sock, p.data, p.length, 0, (struct sockaddr *)&addr, sizeof(addr));
+        }
+        pthread_mutex_lock(&lock);
+    }
+    return NULL;
+}
+
+static _i32 Receive(_u8 *data, _u16 BUF_SIZE, _u32 *IP, int flags)
+{
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    ssize_t length;
+
+    do{
+        length = recvfrom(sock, data, BUF_SIZE, flags | MSG_TRUNC, (struct sockaddr *)&from, &fromLength);
+    } while(length < 0 && errno == EINTR);
+
+    if(length < 0){
+        return NOTHING_RECEIVED;
+    }
+    if(IP){
+        *IP = (HOST_IP_ADDR & 0xFFFFFF00) | ((ntohs(from.sin_port) - NETSIM_BASE_PORT) & 0xFF);
+    }
+
+    pthread_mutex_lock(&lock);
+    stats.received++;
+    stats.bytesReceived += length;
+    if(length > BUF_SIZE){
+        stats.truncated++;
+        length = BUF_SIZE;
+    }
+    pthread_mutex_unlock(&lock);
+    return length;
+}
+
+/*
+ * Receives into the next lent slot, NULL if nothing is waiting and flags has MSG_DONTWAIT
+ */
+static RxPacket_t *ReceiveSlot(int flags)
+{
+    RxPacket_t *packet = &rxRing[rxNext];
+    _i32 length;
+
+    while((length = Receive(packet->data, RX_PACKET_SIZE, &packet->from, flags)) == NOTHING_RECEIVED && !flags);
+    if(length == NOTHING_RECEIVED){
+        return NULL;
+    }
+    packet->length = length;
+    return packet;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/*********************************************** PUBLIC FUNCTIONS ************************************************************/
+/*
+ * Sets the impairments, takes the place of the NETSIM_ environment variables when called before initCC3100
+ */
+void NetSim_Configure(const NetSimConfig_t *newConfig)
+{
+    pthread_mutex_lock(&lock);
+    config = *newConfig;
+    rng = config.seed ? config.seed : 1;
+    configured = true;
+    pthread_mutex_unlock(&lock);
+}
+
+void NetSim_GetStats(NetSimStats_t *out)
+{
+    pthread_mutex_lock(&lock);
+    *out = stats;
+    pthread_mutex_unlock(&lock);
+}
+
+void NetSim_ResetStats()
+{
+    pthread_mutex_lock(&lock);
+    memset(&stats, 0, sizeof(stats));
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ * Opens this board's socket and starts the impairment stage
+ */
+void initCC3100(playerType playerRole)
+{
+    NetSimConfig_t env;
+    pthread_condattr_t attr;
+    struct sockaddr_in addr;
+
+    if(!configured){
+        env.lossPercent = EnvValue("NETSIM_LOSS", 0);
+        env.duplicatePercent = EnvValue("NETSIM_DUPLICATE", 0);
+        env.reorderPercent = EnvValue("NETSIM_REORDER", 0);
+        env.txFailPercent = EnvValue("NETSIM_TX_FAIL", 0);
+        env.latencyMs = EnvValue("NETSIM_LATENCY", 0);
+        env.jitterMs = EnvValue("NETSIM_JITTER", 0);
+        env.reorderDelayMs = EnvValue("NETSIM_REORDER_DELAY", 0);
+        env.seed = EnvValue("NETSIM_SEED", getpid());
+        NetSim_Configure(&env);
+    }
+
+    localIP = playerRole == Host ? HOST_IP_ADDR : (HOST_IP_ADDR & 0xFFFFFF00) | EnvValue("NETSIM_CLIENT", 10);
+
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    addr = Address(localIP);
+    if(sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0){
+        perror("netsim");
+        exit(1);
+    }
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&wake, &attr);
+    pthread_create(&txThread, NULL, TxThread, NULL);
+}
+
+_u32 getLocalIP()
+{
+    return localIP;
+}
+
+/*
+ * Passes a datagram through the impairment stage
+ */
+void SendData(_u8 *data, _u32 IP, _u16 BUF_SIZE)
+{
+    if(BUF_SIZE > MAX_DATAGRAM){
+        BUF_SIZE = MAX_DATAGRAM;
+    }
+
+    pthread_mutex_lock(&lock);
+    stats.sent++;
+    stats.bytesSent += BUF_SIZE;
+
+    if(Chance(config.txFailPercent)){
+        stats.txFailed++;
+        Enqueue(data, IP, BUF_SIZE, true);
+        pthread_cond_signal(&wake);
+    } else if(Chance(config.lossPercent)){
+        stats.lost++;
+    } else {
+        Enqueue(data, IP, BUF_SIZE, false);
+        if(Chance(config.duplicatePercent)){
+            stats.duplicated++;
+            Enqueue(data, IP, BUF_SIZE, false);
+        }
+        pthread_cond_signal(&wake);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ * Blocks until a datagram arrives
+ * Returns: its length, cut to BUF_SIZE
+ */
+_i32 ReceiveData(_u8 *data, _u16 BUF_SIZE)
+{
+    return ReceiveDatagram(data, BUF_SIZE, NULL);
+}
+
+/*
+ * Returns: length of a waiting datagram, NOTHING_RECEIVED if there is none
+ */
+_i32 ReceiveDataNonBlocking(_u8 *data, _u16 BUF_SIZE)
+{
+    return ReceiveDatagramNonBlocking(data, BUF_SIZE, NULL);
+}
+
+/*
+ * Same as ReceiveData, also stores the sender's board address in *IP when IP is not NULL
+ */
+_i32 ReceiveDatagram(_u8 *data, _u16 BUF_SIZE, _u32 *IP)
+{
+    _i32 length;
+
+    while((length = Receive(data, BUF_SIZE, IP, 0)) == NOTHING_RECEIVED);
+    return length;
+}
+
+/*
+ * Same as ReceiveDataNonBlocking, also stores the sender's board address in *IP when IP is not NULL
+ */
+_i32 ReceiveDatagramNonBlocking(_u8 *data, _u16 BUF_SIZE, _u32 *IP)
+{
+    return Receive(data, BUF_SIZE, IP, MSG_DONTWAIT);
+}
+
+/*
+ * Lends the slots datagrams are received into, must be called before ReceivePacket
+ */
+void lendRxRing(RxPacket_t *slots, _u8 count)
+{
+    rxRing = slots;
+    rxRingSize = count;
+    rxNext = 0;
+}
+
+/*
+ * Blocks until a datagram arrives, returns the lent slot holding it
+ */
+RxPacket_t *ReceivePacket()
+{
+    return ReceiveSlot(0);
+}
+
+/*
+ * Returns: the lent slot holding a waiting datagram, NULL if there is none
+ */
+RxPacket_t *ReceivePacketNonBlocking()
+{
+    return ReceiveSlot(MSG_DONTWAIT);
+}
+
+/*
+ * Moves on to the next lent slot
+ */
+void ReleasePacket(RxPacket_t *packet)
+{
+    (void)packet;
+    rxNext = (rxNext + 1) % rxRingSize;
+}
+
+/*
+ * Returns: datagrams cut short by a small receive buffer
+ */
+_u32 getRxDropped()
+{
+    _u32 dropped;
+
+    pthread_mutex_lock(&lock);
+    dropped = stats.truncated;
+    pthread_mutex_unlock(&lock);
+    return dropped;
+}
+
+/*
+ * Registers handler for socket notifications, 0 removes it
+ * Only SOCKET_TX_FAILED is raised, from the impairment stage's thread
+ */
+void registerSocketEventHandler(SocketEventHandler_t handler)
+{
+    socketEventHandler = handler;
+}
+/*********************************************** PUBLIC FUNCTIONS ************************************************************/
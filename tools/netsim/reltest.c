@@ -0,0 +1,246 @@
+/*
+ * reltest.c
+ *
+ * Runs two Reliable channels against each other over an in-process lossy link:
+ * loss, duplication and up to LINK_JITTER_MS of reordering, in simulated 20 ms
+ * ticks. One end sends ordered events in bursts that fill the window, and a
+ * score through Rel_SendLatest every few ticks; the other end acknowledges.
+ *
+ *     gcc -O2 -Itools/netsim -I. tools/netsim/reltest.c Reliable.c NetProtocol.c -o reltest
+ *     ./reltest [seeds]
+ *
+ * Checks that every ordered event is delivered exactly once and in order, that
+ * scores are only ever delivered newer than the last one and the final score
+ * arrives, and that the sender goes idle. Exits with 1 on a failed check.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Reliable.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define TICK_MS                20
+#define SEND_TICKS             1000                     // ticks with new events, then the ends drain
+#define DRAIN_TICKS            3000
+#define LINK_SIZE              512                      // datagrams in flight
+#define LINK_LATENCY_MS        30
+#define LINK_JITTER_MS         30
+
+#define EVT_ORDERED            1
+#define EVT_SCORE              2
+
+typedef struct
+{
+    uint32_t due;
+    bool toB;
+    uint16_t length;
+    uint8_t data[NET_MAX_DATAGRAM];
+} Datagram_t;
+
+typedef struct
+{
+    uint8_t lossPercent;
+    uint8_t duplicatePercent;
+} Scenario_t;
+
+static const Scenario_t scenarios[] = {{0, 0}, {10, 2}, {30, 5}, {50, 5}};
+
+static Datagram_t link[LINK_SIZE];
+static uint32_t rng;
+
+/* Sender side */
+static uint32_t orderedQueued;
+static uint16_t scoreSent;
+
+/* Receiver side */
+static uint32_t orderedDelivered;
+static uint16_t scoreDelivered;
+static bool failed;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static uint32_t Random()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static bool Chance(uint8_t percent)
+{
+    return percent && Random() % 100 < percent;
+}
+
+static void Fail(const char *what, uint32_t got, uint32_t expected)
+{
+    if(!failed){
+        printf("  FAILED: %s, got %u expected %u\n", what, got, expected);
+    }
+    failed = true;
+}
+
+/*
+ * Puts a datagram on the link, maybe losing or duplicating it
+ */
+static void Transmit(const Scenario_t *sc, const NetBundle_t *bundle, uint16_t length, bool toB, uint32_t now)
+{
+    int copies = Chance(sc->duplicatePercent) ? 2 : 1;
+
+    if(Chance(sc->lossPercent)){
+        return;
+    }
+    for(int i = 0; i < LINK_SIZE && copies; i++){
+        if(!link[i].length){
+            link[i].due = now + LINK_LATENCY_MS + Random() % (LINK_JITTER_MS + 1);
+            link[i].toB = toB;
+            link[i].length = length;
+            memcpy(link[i].data, bundle->data, length);
+            copies--;
+        }
+    }
+}
+
+/*
+ * Sends one end's ack and due events
+ */
+static void Tick(const Scenario_t *sc, ReliableChannel_t *ch, uint16_t *sequence, bool toB, uint32_t now)
+{
+    NetBundle_t bundle;
+    uint16_t length;
+
+    Net_BundleBegin(&bundle);
+    Rel_Write(ch, &bundle, now);
+    length = Net_BundleFinish(&bundle, (*sequence)++);
+    if(length){
+        Transmit(sc, &bundle, length, toB, now);
+    }
+}
+
+/*
+ * Checks the events the receiving end can now deliver
+ */
+static void Deliver(ReliableChannel_t *b)
+{
+    uint8_t type, len;
+    uint8_t payload[REL_MAX_PAYLOAD];
+
+    while(Rel_Deliver(b, &type, payload, &len)){
+        if(type == EVT_ORDERED){
+            if(len != 4 || Net_GetU32(payload) != orderedDelivered){
+                Fail("ordered event out of order", Net_GetU32(payload), orderedDelivered);
+            }
+            orderedDelivered++;
+        } else if(type == EVT_SCORE){
+            if(len != 2 || (int16_t)(Net_GetU16(payload) - scoreDelivered) <= 0){
+                Fail("score not newer than the last one", Net_GetU16(payload), scoreDelivered + 1);
+            }
+            scoreDelivered = Net_GetU16(payload);
+        }
+    }
+}
+
+/*
+ * Hands every datagram that is due to its end
+ */
+static void Receive(ReliableChannel_t *a, ReliableChannel_t *b, uint32_t now)
+{
+    NetHeader_t hdr;
+    NetBundleReader_t reader;
+    const uint8_t *payload;
+    uint16_t len;
+    uint8_t type;
+
+    for(int i = 0; i < LINK_SIZE; i++){
+        if(!link[i].length || link[i].due > now){
+            continue;
+        }
+        if(Net_ParsePacket(link[i].data, link[i].length, &hdr) == NET_OK){
+            Net_BundleOpen(&reader, link[i].data, &hdr);
+            while(Net_BundleNext(&reader, &type, &payload, &len)){
+                Rel_Read(link[i].toB ? b : a, type, payload, len, now);
+            }
+        }
+        link[i].length = 0;
+    }
+    Deliver(b);
+}
+
+static bool Run(const Scenario_t *sc, uint32_t seed)
+{
+    static ReliableChannel_t a, b;
+    RelStats_t sa, sb;
+    uint16_t seqA = 0, seqB = 0;
+    uint8_t payload[4];
+    uint32_t now = 0, tick, refused = 0;
+
+    Rel_Init(&a);
+    Rel_Init(&b);
+    memset(link, 0, sizeof(link));
+    rng = seed;
+    orderedQueued = orderedDelivered = 0;
+    scoreSent = scoreDelivered = 0;
+    failed = false;
+
+    for(tick = 0; tick < SEND_TICKS + DRAIN_TICKS; tick++, now += TICK_MS){
+        if(tick < SEND_TICKS){
+            //Bursts of ordered events, more than the window holds now and then
+            for(uint32_t n = Random() % 4 == 0 ? Random() % (REL_WINDOW + 4) : 0; n; n--){
+                Net_PutU32(payload, orderedQueued);
+                if(Rel_Send(&a, EVT_ORDERED, payload, 4)){
+                    orderedQueued++;
+                } else {
+                    refused++;
+                }
+            }
+            if(Random() % 3 == 0){
+                Net_PutU16(payload, ++scoreSent);
+                Rel_SendLatest(&a, EVT_SCORE, payload, 2);
+            }
+        } else if(Rel_Idle(&a)){
+            break;
+        }
+
+        Receive(&a, &b, now);
+        Tick(sc, &a, &seqA, true, now);
+        Tick(sc, &b, &seqB, false, now);
+    }
+
+    if(orderedDelivered != orderedQueued){
+        Fail("ordered events delivered", orderedDelivered, orderedQueued);
+    }
+    if(scoreDelivered != scoreSent){
+        Fail("final score", scoreDelivered, scoreSent);
+    }
+    if(!Rel_Idle(&a)){
+        Fail("sender idle after draining", 0, 1);
+    }
+
+    Rel_GetStats(&a, &sa);
+    Rel_GetStats(&b, &sb);
+    printf("loss %2u%% dup %u%% seed %-3u events %5u refused %4u full %4u scores %4u replaced %4u "
+           "resent %5u duplicates %4u drained in %4u ms %s\n",
+           sc->lossPercent, sc->duplicatePercent, seed, sa.sent, refused, sa.full, scoreSent, sa.replaced,
+           sa.retransmits, sb.duplicates, (tick - SEND_TICKS) * TICK_MS, failed ? "FAILED" : "ok");
+    return !failed;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+int main(int argc, char **argv)
+{
+    uint32_t seeds = argc > 1 ? atoi(argv[1]) : 3;
+    bool ok = true;
+
+    for(uint32_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++){
+        for(uint32_t seed = 1; seed <= seeds; seed++){
+            ok &= Run(&scenarios[i], seed);
+        }
+    }
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
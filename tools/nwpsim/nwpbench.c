@@ -0,0 +1,516 @@
+/*
+ * nwpbench.c
+ *
+ * Runs the SimpleLink host driver against the NWP emulator and measures what
+ * the game's traffic costs in the driver: UDP datagrams out only, in only, and
+ * both at once from two threads. Every datagram carries a sequence number and a
+ * pattern, so loss, reordering or corruption anywhere in the driver's framing
+ * or flow control fails the run. The last test restarts the device with only
+ * CONTEND_TX_POOL TX buffers and slow airtime, and has CONTEND_WRITERS blocking
+ * writers compete with a reader for them: reads need one buffer less than
+ * writes, so a read left waiting behind a woken writer shows up as a stall.
+ *
+ *     nwpbench [count] [size]
+ *
+ * count datagrams of size bytes per test, 2000 and 64 by default. CPU time is
+ * for the whole process (driver, emulator and the Linux ends of the link), so
+ * compare runs rather than read it as MSP432 time. Exits with 1 on a failed
+ * check, so it can run as a regression test. NWPSIM_TX_FAIL_EVERY makes the
+ * tx checks fail on purpose: a socket stays failed once its TX failed.
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include "simplelink.h"
+#include "nwpsim.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define SINK_PORT              47001                    // Datagrams sent by the driver end up here
+#define SOURCE_PORT            47002                    // Driver's socket datagrams are sent to
+#define HEADER_SIZE            12                       // Sequence number and send time
+#define MAX_SIZE               1400
+#define RX_WINDOW              16                       // Datagrams the source may be ahead of the driver
+#define SINK_TIMEOUT_MS        1000
+#define NOISE_PORT             47003                    // Extra writers' datagrams, nobody reads them
+#define CONTEND_TX_POOL        3
+#define CONTEND_TX_US          200
+#define CONTEND_WRITERS        3                        // The first one sends to the sink
+#define NUM_TESTS              4
+
+typedef struct
+{
+    const char *name;
+    uint32_t datagrams;
+    uint32_t errors;
+    double seconds;
+    double cpuSeconds;
+    double maxLatencyUs;
+    double sumLatencyUs;
+    uint32_t latencySamples;
+} Result_t;
+
+static uint32_t count = 2000;
+static uint16_t size = 64;
+
+/* Linux end of the TX path */
+static pthread_t sinkThread;
+static volatile uint32_t sinkReceived;
+static volatile uint32_t sinkErrors;
+
+/* Linux end of the RX path */
+static pthread_t sourceThread;
+static volatile uint32_t driverReceived;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static uint64_t NowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static double CpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static int LinuxSocket(uint16_t port)
+{
+    struct sockaddr_in addr;
+    struct timeval timeout = {SINK_TIMEOUT_MS / 1000, (SINK_TIMEOUT_MS % 1000) * 1000};
+    int buffer = 4 * 1024 * 1024;
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if(fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr))){
+        perror("nwpbench: socket");
+        exit(1);
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+/* Sequence number, send time and a pattern derived from both */
+static void Fill(uint8_t *data, uint32_t seq)
+{
+    uint64_t now = NowUs();
+    uint16_t i;
+
+    memcpy(data, &seq, 4);
+    memcpy(data + 4, &now, 8);
+    for(i = HEADER_SIZE; i < size; i++){
+        data[i] = (uint8_t)(seq + i);
+    }
+}
+
+/* Returns false if the datagram is not the one expected */
+static bool Check(const uint8_t *data, int length, uint32_t expected, Result_t *result)
+{
+    uint32_t seq;
+    uint64_t sent;
+    double latency;
+    uint16_t i;
+
+    if(length != size){
+        return false;
+    }
+    memcpy(&seq, data, 4);
+    memcpy(&sent, data + 4, 8);
+    if(seq != expected){
+        return false;
+    }
+    for(i = HEADER_SIZE; i < size; i++){
+        if(data[i] != (uint8_t)(seq + i)){
+            return false;
+        }
+    }
+    if(result){
+        latency = (double)(NowUs() - sent);
+        result->sumLatencyUs += latency;
+        result->latencySamples++;
+        if(latency > result->maxLatencyUs){
+            result->maxLatencyUs = latency;
+        }
+    }
+    return true;
+}
+
+/*
+ * Counts the driver's datagrams in order, stops after count or a quiet second
+ */
+static void *SinkThread(void *arg)
+{
+    uint8_t data[MAX_SIZE];
+    int fd = LinuxSocket(SINK_PORT);
+    int n;
+
+    (void)arg;
+    while(sinkReceived + sinkErrors < count){
+        n = recv(fd, data, sizeof(data), 0);
+        if(n < 0){
+            break;
+        }
+        if(Check(data, n, sinkReceived, NULL)){
+            sinkReceived++;
+        } else {
+            sinkErrors++;
+        }
+    }
+    close(fd);
+    return NULL;
+}
+
+/*
+ * Sends count datagrams to the driver's socket, at most RX_WINDOW ahead of what it read
+ */
+static void *SourceThread(void *arg)
+{
+    struct sockaddr_in to;
+    uint8_t data[MAX_SIZE];
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    uint32_t seq;
+
+    (void)arg;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    to.sin_port = htons(SOURCE_PORT);
+    for(seq = 0; seq < count; seq++){
+        while(seq >= __atomic_load_n(&driverReceived, __ATOMIC_ACQUIRE) + RX_WINDOW){
+            usleep(50);
+        }
+        Fill(data, seq);
+        sendto(fd, data, size, 0, (struct sockaddr *)&to, sizeof(to));
+    }
+    close(fd);
+    return NULL;
+}
+
+static _i16 DriverSocket(uint16_t port)
+{
+    SlSockAddrIn_t addr;
+    _i16 sd = sl_Socket(SL_AF_INET, SL_SOCK_DGRAM, 0);
+
+    if(sd < 0){
+        fprintf(stderr, "nwpbench: sl_Socket failed, %d\n", sd);
+        exit(1);
+    }
+    if(port){
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = SL_AF_INET;
+        addr.sin_port = sl_Htons(port);
+        addr.sin_addr.s_addr = 0;
+        if(sl_Bind(sd, (SlSockAddr_t *)&addr, sizeof(addr)) < 0){
+            fprintf(stderr, "nwpbench: sl_Bind failed\n");
+            exit(1);
+        }
+    }
+    return sd;
+}
+
+/* Sends count datagrams to port with sl_SendTo, returns failed calls */
+static uint32_t DriverSendTo(_i16 sd, uint16_t port)
+{
+    SlSockAddrIn_t to;
+    uint8_t data[MAX_SIZE];
+    uint32_t errors = 0;
+    uint32_t seq;
+
+    memset(&to, 0, sizeof(to));
+    to.sin_family = SL_AF_INET;
+    to.sin_port = sl_Htons(port);
+    to.sin_addr.s_addr = sl_Htonl(0x7F000001);
+    for(seq = 0; seq < count; seq++){
+        Fill(data, seq);
+        if(sl_SendTo(sd, data, size, 0, (SlSockAddr_t *)&to, sizeof(to)) != size){
+            errors++;
+        }
+    }
+    return errors;
+}
+
+/* Sends count datagrams to the sink */
+static uint32_t DriverSend(_i16 sd)
+{
+    return DriverSendTo(sd, SINK_PORT);
+}
+
+/* Reads count datagrams with sl_RecvFrom, returns the ones out of order or damaged */
+static uint32_t DriverReceive(_i16 sd, Result_t *result)
+{
+    SlSockAddrIn_t from;
+    SlSocklen_t fromLength;
+    uint8_t data[MAX_SIZE];
+    uint32_t errors = 0;
+    _i16 n;
+
+    while(driverReceived < count){
+        fromLength = sizeof(from);
+        n = sl_RecvFrom(sd, data, sizeof(data), 0, (SlSockAddr_t *)&from, &fromLength);
+        if(n <= 0 || !Check(data, n, driverReceived, result)){
+            errors++;
+            if(errors > count){
+                break;
+            }
+            continue;
+        }
+        __atomic_store_n(&driverReceived, driverReceived + 1, __ATOMIC_RELEASE);
+    }
+    return errors;
+}
+
+typedef struct
+{
+    _i16 sd;
+    Result_t *result;
+    uint32_t errors;
+} ReceiveJob_t;
+
+static void *ReceiveThread(void *arg)
+{
+    ReceiveJob_t *job = arg;
+    job->errors = DriverReceive(job->sd, job->result);
+    return NULL;
+}
+
+typedef struct
+{
+    _i16 sd;
+    uint32_t errors;
+} NoiseJob_t;
+
+/* A blocking writer nobody listens to, only competes for TX buffers */
+static void *NoiseThread(void *arg)
+{
+    NoiseJob_t *job = arg;
+    job->errors = DriverSendTo(job->sd, NOISE_PORT);
+    return NULL;
+}
+
+static void Start(Result_t *result, const char *name)
+{
+    memset(result, 0, sizeof(*result));
+    result->name = name;
+    result->seconds = NowUs() / 1e6;
+    result->cpuSeconds = CpuSeconds();
+}
+
+static void Stop(Result_t *result, uint32_t datagrams)
+{
+    result->seconds = NowUs() / 1e6 - result->seconds;
+    result->cpuSeconds = CpuSeconds() - result->cpuSeconds;
+    result->datagrams = datagrams;
+}
+
+static void Report(const Result_t *result)
+{
+    printf("%-8s %8u %10.0f %10.2f %10.1f %10.1f %6u\n", result->name, result->datagrams,
+           result->datagrams / result->seconds,
+           result->datagrams ? result->cpuSeconds * 1e6 / result->datagrams : 0.0,
+           result->latencySamples ? result->sumLatencyUs / result->latencySamples : 0.0,
+           result->maxLatencyUs, result->errors);
+}
+
+/*
+ * Lengths of the driver's spi_Read and spi_Write calls, and how many of them and
+ * of their bytes each candidate SPI_DMA_THRESHOLD (spi_cc3100.h) would put on the uDMA
+ */
+static void ReportSpiLengths(const NwpSimStats_t *stats)
+{
+    static const int thresholds[] = {8, 16, 24, 32, 48, 64};
+    uint32_t transfers = 0, bytes = stats->spiBytes, dmaTransfers, dmaBytes;
+    int len, i;
+
+    printf("spi transfers by length:");
+    for(len = 0; len < NWPSIM_SPI_LENGTHS; len++){
+        if(stats->spiLengths[len]){
+            printf(" %d%s:%u", len, len == NWPSIM_SPI_LENGTHS - 1 ? "+" : "", stats->spiLengths[len]);
+            transfers += stats->spiLengths[len];
+        }
+    }
+    printf("\n");
+
+    //The last entry lumps the long transfers together, so count down from the total bytes
+    for(i = 0; i < (int)(sizeof(thresholds) / sizeof(thresholds[0])); i++){
+        dmaTransfers = 0;
+        dmaBytes = bytes;
+        for(len = 0; len < thresholds[i]; len++){
+            dmaBytes -= len * stats->spiLengths[len];
+        }
+        for(len = thresholds[i]; len < NWPSIM_SPI_LENGTHS; len++){
+            dmaTransfers += stats->spiLengths[len];
+        }
+        printf("threshold %2d: %4.1f%% of transfers, %4.1f%% of bytes on the uDMA\n", thresholds[i],
+               100.0 * dmaTransfers / transfers, 100.0 * dmaBytes / bytes);
+    }
+}
+
+static void TxTest(_i16 sd, Result_t *result)
+{
+    sinkReceived = sinkErrors = 0;
+    pthread_create(&sinkThread, NULL, SinkThread, NULL);
+    Start(result, "tx");
+    result->errors = DriverSend(sd);
+    pthread_join(sinkThread, NULL);
+    Stop(result, sinkReceived);
+    result->errors += sinkErrors + (count - sinkReceived);
+}
+
+static void RxTest(_i16 sd, Result_t *result)
+{
+    driverReceived = 0;
+    pthread_create(&sourceThread, NULL, SourceThread, NULL);
+    Start(result, "rx");
+    result->errors = DriverReceive(sd, result);
+    Stop(result, driverReceived);
+    pthread_join(sourceThread, NULL);
+}
+
+/* Game traffic: one thread sends while another blocks in sl_RecvFrom */
+static void MixedTest(_i16 txSd, _i16 rxSd, Result_t *result)
+{
+    ReceiveJob_t job = {rxSd, result, 0};
+    pthread_t receiver;
+
+    sinkReceived = sinkErrors = 0;
+    driverReceived = 0;
+    pthread_create(&sinkThread, NULL, SinkThread, NULL);
+    pthread_create(&sourceThread, NULL, SourceThread, NULL);
+    Start(result, "tx+rx");
+    pthread_create(&receiver, NULL, ReceiveThread, &job);
+    result->errors = DriverSend(txSd);
+    pthread_join(receiver, NULL);
+    pthread_join(sinkThread, NULL);
+    Stop(result, sinkReceived + driverReceived);
+    pthread_join(sourceThread, NULL);
+    result->errors += job.errors + sinkErrors + (count - sinkReceived);
+}
+
+/* Blocking writers and a reader on a device with few TX buffers */
+static void ContendedTest(_i16 txSd, _i16 rxSd, Result_t *result)
+{
+    ReceiveJob_t job = {rxSd, result, 0};
+    NoiseJob_t noise[CONTEND_WRITERS - 1];
+    pthread_t receiver, writers[CONTEND_WRITERS - 1];
+    int i;
+
+    sinkReceived = sinkErrors = 0;
+    driverReceived = 0;
+    pthread_create(&sinkThread, NULL, SinkThread, NULL);
+    pthread_create(&sourceThread, NULL, SourceThread, NULL);
+    Start(result, "contend");
+    pthread_create(&receiver, NULL, ReceiveThread, &job);
+    for(i = 0; i < CONTEND_WRITERS - 1; i++){
+        noise[i].sd = DriverSocket(0);
+        noise[i].errors = 0;
+        pthread_create(&writers[i], NULL, NoiseThread, &noise[i]);
+    }
+    result->errors = DriverSend(txSd);
+    for(i = 0; i < CONTEND_WRITERS - 1; i++){
+        pthread_join(writers[i], NULL);
+        result->errors += noise[i].errors;
+        sl_Close(noise[i].sd);
+    }
+    pthread_join(receiver, NULL);
+    pthread_join(sinkThread, NULL);
+    Stop(result, sinkReceived + driverReceived);
+    pthread_join(sourceThread, NULL);
+    result->errors += job.errors + sinkErrors + (count - sinkReceived);
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/****************************************** MAIN *********************************************/
+int main(int argc, char *argv[])
+{
+    Result_t results[NUM_TESTS];
+    NwpSimStats_t stats, contended;
+    NwpSimConfig_t config = {CONTEND_TX_POOL, CONTEND_TX_US, 0, 0};
+    _i16 txSd, rxSd;
+    int failed = 0;
+    int i;
+
+    if(argc > 1){
+        count = strtoul(argv[1], NULL, 0);
+    }
+    if(argc > 2){
+        size = strtoul(argv[2], NULL, 0);
+    }
+    if(size < HEADER_SIZE || size > MAX_SIZE){
+        fprintf(stderr, "nwpbench: size must be %d to %d\n", HEADER_SIZE, MAX_SIZE);
+        return 1;
+    }
+
+    osi_Init();
+    if(sl_Start(NULL, NULL, NULL) < 0){
+        fprintf(stderr, "nwpbench: sl_Start failed\n");
+        return 1;
+    }
+    txSd = DriverSocket(0);
+    rxSd = DriverSocket(SOURCE_PORT);
+
+    TxTest(txSd, &results[0]);
+    RxTest(rxSd, &results[1]);
+    MixedTest(txSd, rxSd, &results[2]);
+
+    NwpSim_GetStats(&stats);
+    sl_Close(txSd);
+    sl_Close(rxSd);
+    sl_Stop(0xFF);
+
+    NwpSim_Configure(&config);
+    if(sl_Start(NULL, NULL, NULL) < 0){
+        fprintf(stderr, "nwpbench: sl_Start failed\n");
+        return 1;
+    }
+    txSd = DriverSocket(0);
+    rxSd = DriverSocket(SOURCE_PORT);
+    ContendedTest(txSd, rxSd, &results[3]);
+    NwpSim_GetStats(&contended);
+    sl_Close(txSd);
+    sl_Close(rxSd);
+    sl_Stop(0xFF);
+
+    printf("%u datagrams of %u bytes per test\n", count, size);
+    printf("%-8s %8s %10s %10s %10s %10s %6s\n", "test", "count", "dgram/s", "cpu us/dg", "lat us", "max us", "errors");
+    for(i = 0; i < NUM_TESTS; i++){
+        Report(&results[i]);
+        failed |= results[i].errors != 0;
+    }
+    printf("nwp: %u commands, %u messages (%u dummy), %u irqs, %u eagain, min TxPoolCnt %u, "
+           "%u credit violations, %u sync errors, spawn dropped %u\n",
+           stats.commands, stats.messages, stats.dummyMessages, stats.irqs, stats.eagain, stats.minTxFree,
+           stats.creditViolations, stats.syncErrors, osi_GetSpawnDropped());
+    ReportSpiLengths(&stats);
+    printf("contend: %u writers and a reader, %u TX buffers, %u us airtime: min TxPoolCnt %u, "
+           "%u credit violations, %u sync errors\n",
+           CONTEND_WRITERS, CONTEND_TX_POOL, CONTEND_TX_US, contended.minTxFree, contended.creditViolations,
+           contended.syncErrors);
+
+    failed |= stats.creditViolations || stats.syncErrors;
+    failed |= contended.creditViolations || contended.syncErrors;
+    printf("%s\n", failed ? "FAILED" : "OK");
+    return failed;
+}
+/****************************************** MAIN *********************************************/
@@ -0,0 +1,899 @@
+/*
+ * nwpsim.c
+ *
+ * Linux stand-in for the CC3100 network processor, see nwpsim.h.
+ *
+ * Everything below runs under one lock. The driver's IRQ handler is never
+ * called with it held: IRQs owed to the host are counted and delivered by
+ * Unlock, so the handler may spawn work or signal the driver right away.
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "simplelink.h"
+#include "protocol.h"
+#include "flowcont.h"
+#include "nwpsim.h"
+
+
+/****** GLOBAL VARIABLES ******/
+#define MAX_DATAGRAM           1472
+#define MSG_BODY_MAX           (NWPSIM_MSG_MAX - _SL_RESP_HDR_SIZE)
+#define ALIGN4(len)            (((len) + 3) & ~3)
+#define POLL_IDLE_US           10000
+
+/*
+ * Emulated socket, backed by a non-blocking Linux UDP socket
+ */
+typedef struct
+{
+    bool used;
+    int fd;
+    bool nonBlocking;
+    bool connected;
+    struct sockaddr_in peer;
+    bool recvPending;           // recv/recvfrom waiting for a datagram
+    uint16_t recvOpcode;        // Async response to answer it with
+    uint16_t recvLength;
+} Socket_t;
+
+/*
+ * Message to the host without sync word and header, the header is filled in when it is read
+ */
+typedef struct
+{
+    uint16_t opcode;
+    uint16_t length;
+    uint8_t body[MSG_BODY_MAX];
+} Message_t;
+
+/*
+ * Datagram holding a TX buffer until its airtime is over
+ */
+typedef struct
+{
+    uint8_t sd;
+    struct sockaddr_in to;
+    uint16_t length;
+    uint8_t data[MAX_DATAGRAM];
+} TxJob_t;
+
+static const _SlSyncPattern_t h2nSync = H2N_SYNC_PATTERN;
+static const _SlSyncPattern_t h2nCnys = H2N_CNYS_PATTERN;
+static const uint32_t n2hSync = N2H_SYNC_PATTERN;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t irqLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t nwpThread;
+static bool threadStarted;
+static int wakePipe[2] = {-1, -1};
+
+static bool configured;
+static bool enabled;
+static NwpSimConfig_t config;
+static NwpSimStats_t stats;
+
+static P_EVENT_HANDLER irqHandler;
+static void *irqValue;
+static bool irqRaised;          // Raised for a message the host has not started to read
+static uint32_t irqDue;         // Raised but not delivered yet, see Unlock
+
+/* Host to NWP, bytes not parsed yet */
+static uint8_t inBuf[NWPSIM_MSG_MAX + 2 * SYNC_PATTERN_LEN];
+static uint32_t inLength;
+
+/* NWP to host, queued messages and the one being read */
+static Message_t queue[NWPSIM_QUEUE_SIZE];
+static int queueHead;
+static int queueCount;
+static uint8_t outBuf[SYNC_PATTERN_LEN + _SL_RESP_HDR_SIZE + MSG_BODY_MAX];
+static uint32_t outLength;
+static uint32_t outPos;
+
+static Socket_t sockets[SL_MAX_SOCKETS];
+
+/* TX buffers: free on the NWP, and as the host counts them since its last header */
+static TxJob_t txJobs[NWPSIM_TX_QUEUE_SIZE];
+static int txHead;
+static int txCount;
+static uint8_t txFree;
+static uint8_t hostTxFree;
+static uint8_t txFailure;       // SocketTXFailure bits
+static uint32_t txSeq;
+static uint64_t nextTxUs;
+
+/* One select at a time, like the driver's SELECT_ID object */
+static bool selectPending;
+static uint16_t selectReadFds;
+static uint16_t selectWriteFds;
+static uint64_t selectDeadlineUs;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static uint64_t NowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t EnvValue(const char *name, uint32_t fallback)
+{
+    const char *value = getenv(name);
+    return value ? (uint32_t)strtoul(value, NULL, 0) : fallback;
+}
+
+/*
+ * Releases the lock, then delivers the IRQs raised while it was held
+ */
+static void Unlock()
+{
+    uint32_t irqs = irqDue;
+    P_EVENT_HANDLER handler = irqHandler;
+    void *value = irqValue;
+
+    irqDue = 0;
+    pthread_mutex_unlock(&lock);
+
+    if(irqs && handler){
+        pthread_mutex_lock(&irqLock);
+        while(irqs--){
+            handler(value);
+        }
+        pthread_mutex_unlock(&irqLock);
+    }
+}
+
+/* Wakes the NWP thread out of poll, called with lock held */
+static void Kick()
+{
+    uint8_t byte = 0;
+    if(write(wakePipe[1], &byte, 1) < 0){
+        // Pipe full, a wake-up is pending already
+    }
+}
+
+/* Counts a transfer and keeps the SPI busy for its len bytes at the configured clock */
+static void SpiDelay(int len)
+{
+    uint64_t until;
+
+    stats.spiBytes += len;
+    stats.spiLengths[len < NWPSIM_SPI_LENGTHS - 1 ? len : NWPSIM_SPI_LENGTHS - 1]++;
+    if(!config.spiKHz){
+        return;
+    }
+    until = NowUs() + (uint64_t)len * 8 * 1000 / config.spiKHz;
+    while(NowUs() < until);
+}
+
+/*
+ * Like HOST_IRQ: raised for the first queued message, again only once the host started reading it
+ */
+static void RaiseIrq()
+{
+    if(irqRaised || !queueCount){
+        return;
+    }
+    irqRaised = true;
+    irqDue++;
+    stats.irqs++;
+}
+
+static void Enqueue(uint16_t opcode, const void *args, uint16_t argsLength, const void *data, uint16_t dataLength)
+{
+    Message_t *msg;
+
+    if(queueCount == NWPSIM_QUEUE_SIZE || argsLength + dataLength > MSG_BODY_MAX){
+        fprintf(stderr, "nwpsim: dropped message 0x%04x, queue full or too long\n", opcode);
+        return;
+    }
+    msg = &queue[(queueHead + queueCount) % NWPSIM_QUEUE_SIZE];
+    msg->opcode = opcode;
+    msg->length = argsLength + dataLength;
+    if(argsLength){
+        memcpy(msg->body, args, argsLength);
+    }
+    if(dataLength){
+        memcpy(msg->body + argsLength, data, dataLength);
+    }
+    queueCount++;
+    stats.messages++;
+    RaiseIrq();
+}
+
+static void Respond(uint16_t opcode, const void *args, uint16_t argsLength)
+{
+    Enqueue(opcode, args, argsLength, NULL, 0);
+}
+
+static void RespondSocket(uint16_t opcode, int16_t status, uint8_t sd)
+{
+    _SocketResponse_t rsp;
+
+    memset(&rsp, 0, sizeof(rsp));
+    rsp.statusOrLen = status;
+    rsp.sd = sd;
+    Respond(opcode, &rsp, sizeof(rsp));
+}
+
+static void RespondBasic(uint16_t opcode, int16_t status)
+{
+    _BasicResponse_t rsp;
+
+    memset(&rsp, 0, sizeof(rsp));
+    rsp.status = status;
+    Respond(opcode, &rsp, sizeof(rsp));
+}
+
+/*
+ * Host sent CNYS: clocks the next message out behind the N2H sync word
+ */
+static void LoadNext()
+{
+    Message_t *msg;
+    _SlResponseHeader_t hdr;
+    uint8_t nonBlocking = 0;
+    int i;
+
+    outLength = 0;
+    outPos = 0;
+    if(!queueCount){
+        stats.syncErrors++;
+        return;
+    }
+    msg = &queue[queueHead];
+    queueHead = (queueHead + 1) % NWPSIM_QUEUE_SIZE;
+    queueCount--;
+
+    for(i = 0; i < SL_MAX_SOCKETS; i++){
+        if(sockets[i].used && sockets[i].nonBlocking){
+            nonBlocking |= 1 << i;
+        }
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.GenHeader.Opcode = msg->opcode;
+    hdr.GenHeader.Len = _SL_RESP_SPEC_HDR_SIZE + msg->length;
+    hdr.TxPoolCnt = txFree;
+    hdr.SocketTXFailure = txFailure;
+    hdr.SocketNonBlocking = nonBlocking;
+
+    // The driver ignores TxPoolCnt in InitComplete and starts from FLOW_CONT_MIN
+    hostTxFree = (msg->opcode == SL_OPCODE_DEVICE_INITCOMPLETE) ? FLOW_CONT_MIN : txFree;
+
+    memcpy(outBuf, &n2hSync, SYNC_PATTERN_LEN);
+    memcpy(outBuf + SYNC_PATTERN_LEN, &hdr, sizeof(hdr));
+    memcpy(outBuf + SYNC_PATTERN_LEN + sizeof(hdr), msg->body, msg->length);
+    outLength = SYNC_PATTERN_LEN + sizeof(hdr) + ALIGN4(msg->length);
+    memset(outBuf + SYNC_PATTERN_LEN + sizeof(hdr) + msg->length, 0, ALIGN4(msg->length) - msg->length);
+
+    irqRaised = false;
+    RaiseIrq();
+}
+
+static Socket_t *FindSocket(uint8_t sd)
+{
+    uint8_t id = sd & BSD_SOCKET_ID_MASK;
+    return (id < SL_MAX_SOCKETS && sockets[id].used) ? &sockets[id] : NULL;
+}
+
+static void CloseSocket(int id)
+{
+    if(sockets[id].used){
+        close(sockets[id].fd);
+    }
+    memset(&sockets[id], 0, sizeof(sockets[id]));
+    txFailure &= ~(1 << id);
+}
+
+/* Every emulated address is 127.0.0.1, the port is kept */
+static struct sockaddr_in Loopback(uint16_t port)
+{
+    struct sockaddr_in addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = port;
+    return addr;
+}
+
+/*
+ * Answers a pending recv/recvfrom with a waiting datagram, or SL_EAGAIN on a non-blocking socket
+ */
+static void TryReceive(int id)
+{
+    Socket_t *s = &sockets[id];
+    uint8_t data[MAX_DATAGRAM];
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    _SocketAddrAsyncIPv4Response_t rsp;
+    ssize_t n;
+
+    if(!s->used || !s->recvPending){
+        return;
+    }
+
+    memset(&rsp, 0, sizeof(rsp));
+    rsp.sd = id | SL_SOCKET_PAYLOAD_TYPE_UDP_IPV4;
+    rsp.family = SL_AF_INET;
+
+    n = recvfrom(s->fd, data, sizeof(data), MSG_DONTWAIT, (struct sockaddr *)&from, &fromLength);
+    if(n < 0){
+        if(!s->nonBlocking){
+            return;
+        }
+        rsp.statusOrLen = SL_EAGAIN;
+        stats.eagain++;
+        n = 0;
+    } else {
+        if(n > s->recvLength){
+            n = s->recvLength;
+        }
+        rsp.statusOrLen = (int16_t)n;
+        rsp.port = from.sin_port;
+        rsp.address = from.sin_addr.s_addr;
+        stats.datagramsReceived++;
+        stats.bytesReceived += n;
+    }
+
+    s->recvPending = false;
+    Enqueue(s->recvOpcode, &rsp,
+            s->recvOpcode == SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE ? sizeof(rsp) : sizeof(_SocketResponse_t),
+            data, (uint16_t)n);
+}
+
+/*
+ * Answers the pending select once a socket is ready or it timed out
+ */
+static void CheckSelect(uint64_t now)
+{
+    _SelectAsyncResponse_t rsp;
+    struct pollfd pfd;
+    int i;
+
+    if(!selectPending){
+        return;
+    }
+
+    memset(&rsp, 0, sizeof(rsp));
+    for(i = 0; i < SL_MAX_SOCKETS; i++){
+        if(!sockets[i].used){
+            continue;
+        }
+        if(selectReadFds & (1 << i)){
+            pfd.fd = sockets[i].fd;
+            pfd.events = POLLIN;
+            if(poll(&pfd, 1, 0) > 0){
+                rsp.readFds |= 1 << i;
+                rsp.readFdsCount++;
+            }
+        }
+        if(selectWriteFds & (1 << i)){
+            rsp.writeFds |= 1 << i;
+            rsp.writeFdsCount++;
+        }
+    }
+
+    if(!rsp.readFdsCount && !rsp.writeFdsCount && now < selectDeadlineUs){
+        return;
+    }
+    rsp.status = rsp.readFdsCount + rsp.writeFdsCount;
+    selectPending = false;
+    Respond(SL_OPCODE_SOCKET_SELECTASYNCRESPONSE, &rsp, sizeof(rsp));
+}
+
+/*
+ * send/sendto: takes a TX buffer until the datagram's airtime is over
+ */
+static void DataWrite(uint8_t sd, const struct sockaddr_in *to, const uint8_t *data, uint16_t length)
+{
+    Socket_t *s = FindSocket(sd);
+    TxJob_t *job;
+
+    stats.dataWrites++;
+    if(hostTxFree <= FLOW_CONT_MIN + 1 || !txFree){
+        stats.creditViolations++;
+    }
+    if(hostTxFree){
+        hostTxFree--;
+    }
+    if(!txFree || !s || !to || txCount == NWPSIM_TX_QUEUE_SIZE || length > MAX_DATAGRAM){
+        return;
+    }
+
+    txFree--;
+    if(txFree < stats.minTxFree){
+        stats.minTxFree = txFree;
+    }
+    job = &txJobs[(txHead + txCount) % NWPSIM_TX_QUEUE_SIZE];
+    job->sd = sd & BSD_SOCKET_ID_MASK;
+    job->to = *to;
+    job->length = length;
+    memcpy(job->data, data, length);
+    txCount++;
+    Kick();
+}
+
+/*
+ * Sends the oldest datagram, or fails it every txFailEvery, and frees its TX buffer
+ */
+static void Transmit(uint64_t now)
+{
+    TxJob_t *job = &txJobs[txHead];
+    Socket_t *s = &sockets[job->sd];
+    SlSockEventData_t evt;
+
+    txHead = (txHead + 1) % NWPSIM_TX_QUEUE_SIZE;
+    txCount--;
+    txFree++;
+    nextTxUs = (nextTxUs > now ? nextTxUs : now) + config.txUs;
+
+    if(!s->used){
+        return;
+    }
+    if(config.txFailEvery && ++txSeq % config.txFailEvery == 0){
+        memset(&evt, 0, sizeof(evt));
+        evt.status = SL_ECLOSE;
+        evt.sd = job->sd;
+        txFailure |= 1 << job->sd;
+        stats.txFailed++;
+        Respond(SL_OPCODE_SOCKET_TXFAILEDASYNCRESPONSE, &evt, sizeof(evt));
+        return;
+    }
+    if(sendto(s->fd, job->data, job->length, 0, (struct sockaddr *)&job->to, sizeof(job->to)) == job->length){
+        stats.datagramsSent++;
+        stats.bytesSent += job->length;
+    }
+}
+
+static void HandleCommand(uint16_t opcode, uint8_t *body, uint16_t length)
+{
+    Socket_t *s;
+    int i;
+
+    stats.commands++;
+    switch(opcode){
+    case SL_OPCODE_SOCKET_SOCKET:
+    {
+        _SocketCommand_t *cmd = (_SocketCommand_t *)body;
+        int fd;
+
+        if(cmd->Domain != SL_AF_INET || cmd->Type != SL_SOCK_DGRAM){
+            RespondSocket(SL_OPCODE_SOCKET_SOCKETRESPONSE, SL_EPROTONOSUPPORT, 0);
+            break;
+        }
+        for(i = 0; i < SL_MAX_SOCKETS && sockets[i].used; i++);
+        fd = (i < SL_MAX_SOCKETS) ? socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0) : -1;
+        if(fd < 0){
+            RespondSocket(SL_OPCODE_SOCKET_SOCKETRESPONSE, SL_ENSOCK, 0);
+            break;
+        }
+        memset(&sockets[i], 0, sizeof(sockets[i]));
+        sockets[i].used = true;
+        sockets[i].fd = fd;
+        RespondSocket(SL_OPCODE_SOCKET_SOCKETRESPONSE, 0, i | SL_SOCKET_PAYLOAD_TYPE_UDP_IPV4);
+        break;
+    }
+    case SL_OPCODE_SOCKET_CLOSE:
+    {
+        _CloseCommand_t *cmd = (_CloseCommand_t *)body;
+
+        s = FindSocket(cmd->sd);
+        if(s){
+            CloseSocket(s - sockets);
+        }
+        RespondSocket(SL_OPCODE_SOCKET_CLOSERESPONSE, s ? 0 : SL_EBADF, cmd->sd);
+        break;
+    }
+    case SL_OPCODE_SOCKET_BIND:
+    {
+        _SocketAddrIPv4Command_t *cmd = (_SocketAddrIPv4Command_t *)body;
+        struct sockaddr_in addr;
+        int16_t status = SL_EBADF;
+
+        s = FindSocket(cmd->sd);
+        if(s){
+            addr = Loopback(cmd->port);
+            status = bind(s->fd, (struct sockaddr *)&addr, sizeof(addr)) ? SL_EADDRINUSE : 0;
+        }
+        RespondSocket(SL_OPCODE_SOCKET_BINDRESPONSE, status, cmd->sd);
+        break;
+    }
+    case SL_OPCODE_SOCKET_SETSOCKOPT:
+    {
+        _setSockOptCommand_t *cmd = (_setSockOptCommand_t *)body;
+        _u32 value;
+
+        s = FindSocket(cmd->sd);
+        if(s && cmd->level == SL_SOL_SOCKET && cmd->optionName == SL_SO_NONBLOCKING &&
+           length >= sizeof(*cmd) + sizeof(value)){
+            memcpy(&value, body + sizeof(*cmd), sizeof(value));
+            s->nonBlocking = value != 0;
+        }
+        RespondSocket(SL_OPCODE_SOCKET_SETSOCKOPTRESPONSE, s ? 0 : SL_EBADF, cmd->sd);
+        break;
+    }
+    case SL_OPCODE_SOCKET_CONNECT:
+    {
+        _SocketAddrIPv4Command_t *cmd = (_SocketAddrIPv4Command_t *)body;
+
+        s = FindSocket(cmd->sd);
+        if(s){
+            s->peer = Loopback(cmd->port);
+            s->connected = true;
+        }
+        RespondSocket(SL_OPCODE_SOCKET_CONNECTRESPONSE, s ? 0 : SL_EBADF, cmd->sd);
+        if(s){
+            RespondSocket(SL_OPCODE_SOCKET_CONNECTASYNCRESPONSE, 0, cmd->sd);
+        }
+        break;
+    }
+    case SL_OPCODE_SOCKET_SEND:
+    {
+        _sendRecvCommand_t *cmd = (_sendRecvCommand_t *)body;
+
+        s = FindSocket(cmd->sd);
+        DataWrite(cmd->sd, (s && s->connected) ? &s->peer : NULL,
+                  body + ALIGN4(sizeof(*cmd)), cmd->StatusOrLen);
+        break;
+    }
+    case SL_OPCODE_SOCKET_SENDTO:
+    {
+        _SocketAddrIPv4Command_t *cmd = (_SocketAddrIPv4Command_t *)body;
+        struct sockaddr_in to = Loopback(cmd->port);
+
+        DataWrite(cmd->sd, &to, body + ALIGN4(sizeof(*cmd)), cmd->lenOrPadding);
+        break;
+    }
+    case SL_OPCODE_SOCKET_RECV:
+    case SL_OPCODE_SOCKET_RECVFROM:
+    {
+        _sendRecvCommand_t *cmd = (_sendRecvCommand_t *)body;
+
+        // The host counts a TX buffer for the read, the NWP needs none
+        if(hostTxFree <= FLOW_CONT_MIN){
+            stats.creditViolations++;
+        }
+        if(hostTxFree){
+            hostTxFree--;
+        }
+        s = FindSocket(cmd->sd);
+        if(!s){
+            break;
+        }
+        s->recvPending = true;
+        s->recvLength = cmd->StatusOrLen;
+        s->recvOpcode = (opcode == SL_OPCODE_SOCKET_RECV) ? SL_OPCODE_SOCKET_RECVASYNCRESPONSE
+                                                         : SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE;
+        TryReceive(s - sockets);
+        Kick();
+        break;
+    }
+    case SL_OPCODE_SOCKET_SELECT:
+    {
+        _SelectCommand_t *cmd = (_SelectCommand_t *)body;
+
+        selectPending = true;
+        selectReadFds = cmd->readFds;
+        selectWriteFds = cmd->writeFds;
+        if(cmd->tv_sec == 0xffff && cmd->tv_usec == 0xffff){
+            selectDeadlineUs = UINT64_MAX;
+        } else {
+            selectDeadlineUs = NowUs() + (uint64_t)cmd->tv_sec * 1000000 + (uint64_t)cmd->tv_usec * 1000;
+        }
+        RespondBasic(SL_OPCODE_SOCKET_SELECTRESPONSE, 0);
+        CheckSelect(NowUs());
+        Kick();
+        break;
+    }
+    case SL_OPCODE_DEVICE_STOP_COMMAND:
+        for(i = 0; i < SL_MAX_SOCKETS; i++){
+            CloseSocket(i);
+        }
+        txCount = 0;
+        selectPending = false;
+        RespondBasic(SL_OPCODE_DEVICE_STOP_RESPONSE, 0);
+        RespondBasic(SL_OPCODE_DEVICE_STOP_ASYNC_RESPONSE, 0);
+        break;
+    default:
+        stats.unknownCommands++;
+        RespondBasic(opcode & ~0x8000, 0);
+        break;
+    }
+}
+
+/*
+ * Parses whatever the host wrote so far: commands, CNYS read requests and dummy words
+ */
+static void Parse()
+{
+    _SlCommandHeader_t hdr;
+    uint32_t used;
+
+    while(inLength >= SYNC_PATTERN_LEN){
+        used = SYNC_PATTERN_LEN;
+        if(!memcmp(inBuf, &h2nSync.Short, SYNC_PATTERN_LEN)){
+            if(inLength < SYNC_PATTERN_LEN + sizeof(hdr)){
+                return;
+            }
+            memcpy(&hdr, inBuf + SYNC_PATTERN_LEN, sizeof(hdr));
+            if(SYNC_PATTERN_LEN + sizeof(hdr) + hdr.Len > sizeof(inBuf)){
+                stats.syncErrors++;
+            } else if(inLength < SYNC_PATTERN_LEN + sizeof(hdr) + hdr.Len){
+                return;
+            } else {
+                HandleCommand(hdr.Opcode, inBuf + SYNC_PATTERN_LEN + sizeof(hdr), hdr.Len);
+                used += sizeof(hdr) + hdr.Len;
+            }
+        } else if(!memcmp(inBuf, &h2nCnys.Short, SYNC_PATTERN_LEN)){
+            LoadNext();
+        } else if(*(uint32_t *)inBuf != H2N_DUMMY_PATTERN){
+            stats.syncErrors++;
+            used = 1;
+        }
+        inLength -= used;
+        memmove(inBuf, inBuf + used, inLength);
+    }
+}
+
+/*
+ * Frees TX buffers as their airtime ends, completes pending recv/select and
+ * returns TX buffers with a dummy message when the host is about to run out
+ */
+static void *NwpThread(void *arg)
+{
+    struct pollfd fds[SL_MAX_SOCKETS + 1];
+    uint8_t drain[64];
+    struct timespec timeout;
+    uint64_t now, waitUs;
+    int i, n;
+
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    while(1){
+        now = NowUs();
+        if(enabled){
+            while(txCount && nextTxUs <= now){
+                Transmit(now);
+            }
+            for(i = 0; i < SL_MAX_SOCKETS; i++){
+                TryReceive(i);
+            }
+            CheckSelect(now);
+            if(hostTxFree <= FLOW_CONT_MIN + 1 && txFree > hostTxFree && !queueCount && !irqRaised){
+                stats.dummyMessages++;
+                Respond(SL_OPCODE_DEVICE_DEVICEASYNCDUMMY, NULL, 0);
+            }
+        }
+
+        fds[0].fd = wakePipe[0];
+        fds[0].events = POLLIN;
+        n = 1;
+        waitUs = POLL_IDLE_US;
+        for(i = 0; enabled && i < SL_MAX_SOCKETS; i++){
+            if(sockets[i].used && (sockets[i].recvPending || (selectPending && (selectReadFds & (1 << i))))){
+                fds[n].fd = sockets[i].fd;
+                fds[n].events = POLLIN;
+                n++;
+            }
+        }
+        if(enabled && txCount && nextTxUs - now < waitUs){
+            waitUs = nextTxUs - now;
+        }
+        if(enabled && selectPending && selectDeadlineUs - now < waitUs){
+            waitUs = selectDeadlineUs - now;
+        }
+        timeout.tv_sec = waitUs / 1000000;
+        timeout.tv_nsec = (waitUs % 1000000) * 1000;
+
+        Unlock();
+        ppoll(fds, n, &timeout, NULL);
+        if(fds[0].revents & POLLIN){
+            while(read(wakePipe[0], drain, sizeof(drain)) > 0);
+        }
+        pthread_mutex_lock(&lock);
+    }
+    return NULL;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
+
+/*
+ * SPI transport, bound to sl_IfOpen/Close/Read/Write by user_nwpsim.h
+ */
+Fd_t spi_Open(char *ifName, unsigned long flags)
+{
+    (void)ifName;
+    (void)flags;
+    return 1;
+}
+
+int spi_Close(Fd_t fd)
+{
+    (void)fd;
+    return 0;
+}
+
+/* Clocks out the message loaded by the last CNYS, then 0xFF like an idle bus */
+int spi_Read(Fd_t fd, unsigned char *pBuff, int len)
+{
+    int i;
+
+    (void)fd;
+    pthread_mutex_lock(&lock);
+    SpiDelay(len);
+    for(i = 0; i < len; i++){
+        pBuff[i] = (outPos < outLength) ? outBuf[outPos++] : 0xFF;
+    }
+    Unlock();
+    return len;
+}
+
+int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
+{
+    int copied = 0;
+    int chunk;
+
+    (void)fd;
+    pthread_mutex_lock(&lock);
+    SpiDelay(len);
+    while(copied < len){
+        chunk = len - copied;
+        if(chunk > (int)(sizeof(inBuf) - inLength)){
+            chunk = sizeof(inBuf) - inLength;
+        }
+        memcpy(inBuf + inLength, pBuff + copied, chunk);
+        inLength += chunk;
+        copied += chunk;
+        Parse();
+        if(inLength == sizeof(inBuf)){
+            // Nothing parseable in a full buffer, drop a byte to resync
+            stats.syncErrors++;
+            memmove(inBuf, inBuf + 1, --inLength);
+        }
+    }
+    Unlock();
+    return len;
+}
+
+int registerInterruptHandler(P_EVENT_HANDLER InterruptHdl, void* pValue)
+{
+    pthread_mutex_lock(&lock);
+    irqHandler = InterruptHdl;
+    irqValue = pValue;
+    pthread_mutex_unlock(&lock);
+    return 0;
+}
+
+/*
+ * nHIB high: the NWP boots with fresh state and reports InitComplete
+ */
+void NwpSim_Enable()
+{
+    _u32 initStatus = INIT_STA_OK;
+    int i;
+
+    pthread_mutex_lock(&lock);
+    if(!configured){
+        config.txPool = EnvValue("NWPSIM_TX_POOL", NWPSIM_TX_POOL_DEFAULT);
+        config.txUs = EnvValue("NWPSIM_TX_US", NWPSIM_TX_US_DEFAULT);
+        config.spiKHz = EnvValue("NWPSIM_SPI_KHZ", 0);
+        config.txFailEvery = EnvValue("NWPSIM_TX_FAIL_EVERY", 0);
+    }
+    if(!config.txPool || config.txPool > NWPSIM_TX_QUEUE_SIZE){
+        config.txPool = NWPSIM_TX_POOL_DEFAULT;
+    }
+
+    for(i = 0; i < SL_MAX_SOCKETS; i++){
+        CloseSocket(i);
+    }
+    memset(&stats, 0, sizeof(stats));
+    stats.minTxFree = config.txPool;
+    inLength = 0;
+    queueHead = queueCount = 0;
+    outLength = outPos = 0;
+    irqRaised = false;
+    irqDue = 0;
+    txHead = txCount = 0;
+    txFree = config.txPool;
+    hostTxFree = FLOW_CONT_MIN;
+    txFailure = 0;
+    txSeq = 0;
+    nextTxUs = 0;
+    selectPending = false;
+    enabled = true;
+
+    if(!threadStarted){
+        threadStarted = true;
+        if(pipe2(wakePipe, O_NONBLOCK) == 0){
+            pthread_create(&nwpThread, NULL, NwpThread, NULL);
+        }
+    }
+
+    Respond(SL_OPCODE_DEVICE_INITCOMPLETE, &initStatus, sizeof(initStatus));
+    Kick();
+    Unlock();
+}
+
+/*
+ * nHIB low: the NWP stops, its sockets and queued messages are gone
+ */
+void NwpSim_Disable()
+{
+    int i;
+
+    pthread_mutex_lock(&lock);
+    enabled = false;
+    for(i = 0; i < SL_MAX_SOCKETS; i++){
+        CloseSocket(i);
+    }
+    queueCount = 0;
+    txCount = 0;
+    outLength = outPos = 0;
+    irqRaised = false;
+    selectPending = false;
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ * Sets the emulated device up for the next sl_Start, instead of the environment
+ */
+void NwpSim_Configure(const NwpSimConfig_t *cfg)
+{
+    pthread_mutex_lock(&lock);
+    config = *cfg;
+    configured = true;
+    pthread_mutex_unlock(&lock);
+}
+
+void NwpSim_GetStats(NwpSimStats_t *out)
+{
+    pthread_mutex_lock(&lock);
+    *out = stats;
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ * Queues an async message for the host, args as the event's descriptor
+ * Returns -1 if the device is not enabled or the message does not fit
+ */
+int NwpSim_InjectAsync(uint16_t opcode, const void *args, uint16_t length)
+{
+    int status = -1;
+
+    pthread_mutex_lock(&lock);
+    if(enabled && length <= MSG_BODY_MAX && queueCount < NWPSIM_QUEUE_SIZE){
+        Respond(opcode, args, length);
+        status = 0;
+    }
+    Unlock();
+    return status;
+}
+
+/*
+ * _SlDrvAssert for the emulator build, a protocol error ends the run where it happened
+ */
+void NwpSim_Assert(const char *file, int line)
+{
+    fprintf(stderr, "nwpsim: SimpleLink assertion failed at %s:%d\n", file, line);
+    abort();
+}
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
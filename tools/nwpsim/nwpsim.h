@@ -0,0 +1,111 @@
+/*
+ * nwpsim.h
+ *
+ * Linux stand-in for the CC3100 network processor (NWP), for running the real
+ * SimpleLink host driver (CC3100SupportPackage/simplelink/source) off target.
+ *
+ * It replaces spi_cc3100.c and the board's IRQ line. Bytes the driver writes
+ * with spi_Write are parsed as SimpleLink commands (sync word, opcode, length,
+ * descriptors, payload), and the answers are clocked out through spi_Read
+ * behind the N2H sync word with a response header that carries the NWP's free
+ * TX buffers (TxPoolCnt), exactly as the driver expects. The IRQ handler the
+ * driver registers is called once per message, the next IRQ is raised only
+ * after the previous message was read, like the real HOST_IRQ line.
+ *
+ * Emulated: sl_Start/sl_Stop, socket, bind, close, setsockopt (non-blocking),
+ * connect, send, sendto, recv, recvfrom and select on UDP sockets. Datagrams
+ * are real: every emulated socket is a UDP socket on 127.0.0.1 and any
+ * destination address maps to 127.0.0.1 on the same port. Other commands get
+ * a zeroed 4 byte _BasicResponse_t and are counted in unknownCommands.
+ *
+ *     gcc -pthread -DSL_USER_HEADER='"user_nwpsim.h"' -Itools/nwpsim \
+ *         -ICC3100SupportPackage/simplelink/include -ICC3100SupportPackage/simplelink/source \
+ *         tools/nwpsim/nwpbench.c tools/nwpsim/nwpsim.c tools/nwpsim/osi_posix.c \
+ *         CC3100SupportPackage/simplelink/source/{device,driver,flowcont,fs,netapp,netcfg,socket,spawn,wlan}.c
+ *
+ * The emulated device is set up from the environment when sl_Start enables it
+ * unless NwpSim_Configure was called first:
+ *     NWPSIM_TX_POOL       TX buffers on the NWP (TxPoolCnt when idle)
+ *     NWPSIM_TX_US         airtime of one datagram, us, the buffer is freed after it
+ *     NWPSIM_SPI_KHZ       SPI clock, transfers busy-wait for it, 0 for instant
+ *     NWPSIM_TX_FAIL_EVERY every Nth datagram fails with SL_SOCKET_TX_FAILED_EVENT, 0 for never
+ *
+ * Tests can script the device further with NwpSim_InjectAsync, e.g. to send
+ * socket async events or WLAN connect/IP acquired events at a chosen time.
+ */
+
+#ifndef NWPSIM_H_
+#define NWPSIM_H_
+
+/********************** Includes *********************/
+#include <stdint.h>
+/********************** Includes *********************/
+
+/**************************** Defines ******************************/
+typedef unsigned int Fd_t;
+typedef void (*P_EVENT_HANDLER)(void* pValue);
+
+#define NWPSIM_TX_POOL_DEFAULT  8
+#define NWPSIM_TX_US_DEFAULT    0
+#define NWPSIM_MSG_MAX          1600                    // Largest message either way, header included
+#define NWPSIM_QUEUE_SIZE       32                      // Messages waiting to be read by the host
+#define NWPSIM_TX_QUEUE_SIZE    32                      // Datagrams waiting for airtime
+#define NWPSIM_SPI_LENGTHS      65                      // Transfer lengths counted one by one, 0 to 64
+
+/*
+ * Emulated device
+ */
+typedef struct
+{
+    uint8_t txPool;             // TX buffers, at most NWPSIM_TX_QUEUE_SIZE
+    uint32_t txUs;
+    uint32_t spiKHz;
+    uint32_t txFailEvery;
+} NwpSimConfig_t;
+
+/*
+ * Counters, reset by sl_Start
+ */
+typedef struct
+{
+    uint32_t commands;          // Messages from the host, data writes included
+    uint32_t dataWrites;        // send/sendto
+    uint32_t datagramsSent;
+    uint32_t bytesSent;
+    uint32_t datagramsReceived; // Delivered to the host by recv/recvfrom
+    uint32_t bytesReceived;
+    uint32_t eagain;            // recv/recvfrom answered SL_EAGAIN
+    uint32_t txFailed;          // Injected TX failures
+    uint32_t messages;          // Messages to the host
+    uint32_t dummyMessages;     // Sent only to return TX buffers
+    uint32_t irqs;
+    uint32_t creditViolations;  // Data writes while the host had no TX buffer
+    uint32_t unknownCommands;
+    uint32_t syncErrors;        // Bytes skipped looking for a sync word
+    uint32_t spiBytes;
+    uint32_t spiLengths[NWPSIM_SPI_LENGTHS];    // spi_Read and spi_Write calls by length, the last entry counts every longer one
+    uint8_t minTxFree;          // Lowest TxPoolCnt reached
+} NwpSimStats_t;
+/**************************** Defines ******************************/
+
+
+/*********************** Interface Functions ************************/
+/* Bound to the driver by user_nwpsim.h */
+Fd_t spi_Open(char *ifName, unsigned long flags);
+int spi_Close(Fd_t fd);
+int spi_Read(Fd_t fd, unsigned char *pBuff, int len);
+int spi_Write(Fd_t fd, unsigned char *pBuff, int len);
+int registerInterruptHandler(P_EVENT_HANDLER InterruptHdl, void* pValue);
+void NwpSim_Enable();
+void NwpSim_Disable();
+/*********************** Interface Functions ************************/
+
+
+/*********************** Simulator Functions ************************/
+void NwpSim_Configure(const NwpSimConfig_t *config);
+void NwpSim_GetStats(NwpSimStats_t *stats);
+int NwpSim_InjectAsync(uint16_t opcode, const void *args, uint16_t length);
+void NwpSim_Assert(const char *file, int line);
+/*********************** Simulator Functions ************************/
+
+#endif /* NWPSIM_H_ */
@@ -0,0 +1,223 @@
+/*
+ * osi_posix.c
+ *
+ * pthread counterpart of osi_g8rtos.c, see osi_posix.h.
+ */
+
+#include <errno.h>
+#include <time.h>
+#include "osi_posix.h"
+
+
+/****** SPAWN QUEUE ******/
+typedef struct
+{
+    void (*pEntry)(void *pValue);
+    void *pValue;
+} SpawnEntry_t;
+
+/* Written at the head by sl_Spawn (thread or IRQ), read at the tail by the spawn thread */
+static SpawnEntry_t spawnQueue[OSI_SPAWN_QUEUE_SIZE];
+static int spawnStarted = 0;
+static uint8_t spawnHead = 0;
+static uint8_t spawnTail = 0;
+static uint32_t spawnDropped = 0;
+
+static OsiSem_t spawn_s;            // Entries waiting in the queue
+static pthread_t spawnThread;
+/****** SPAWN QUEUE ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static void SemInit(OsiSem_t *s, int32_t value)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&s->mutex, NULL);
+    pthread_cond_init(&s->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    s->value = value;
+}
+
+static void SemDestroy(OsiSem_t *s)
+{
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->mutex);
+}
+
+/*
+ * Adds one to the semaphore, never above limit
+ */
+static void SemPost(OsiSem_t *s, int32_t limit)
+{
+    pthread_mutex_lock(&s->mutex);
+    if(s->value < limit){
+        s->value++;
+        pthread_cond_signal(&s->cond);
+    }
+    pthread_mutex_unlock(&s->mutex);
+}
+
+/*
+ * Takes the semaphore within Timeout ms, OSI_NO_WAIT or OSI_WAIT_FOREVER
+ */
+static int16_t SemTake(OsiSem_t *s, OsiTime_t Timeout)
+{
+    struct timespec until;
+    int status = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &until);
+    until.tv_sec += Timeout / 1000;
+    until.tv_nsec += (long)(Timeout % 1000) * 1000000;
+    if(until.tv_nsec >= 1000000000){
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&s->mutex);
+    while(s->value <= 0 && status != ETIMEDOUT){
+        if(Timeout == OSI_NO_WAIT){
+            status = ETIMEDOUT;
+        } else if(Timeout == OSI_WAIT_FOREVER){
+            pthread_cond_wait(&s->cond, &s->mutex);
+        } else {
+            status = pthread_cond_timedwait(&s->cond, &s->mutex, &until);
+        }
+    }
+    if(s->value > 0){
+        s->value--;
+        status = 0;
+    }
+    pthread_mutex_unlock(&s->mutex);
+
+    return status ? OSI_TIMEOUT : OSI_OK;
+}
+
+/*
+ * Runs the queued entries in order, sleeping while the queue is empty
+ */
+static void *SpawnThread(void *arg)
+{
+    SpawnEntry_t entry;
+
+    (void)arg;
+    while(1){
+        SemTake(&spawn_s, OSI_WAIT_FOREVER);
+
+        // The tail slot belongs to this thread until the tail moves past it
+        entry = spawnQueue[spawnTail];
+        __atomic_store_n(&spawnTail, (spawnTail + 1) % OSI_SPAWN_QUEUE_SIZE, __ATOMIC_RELEASE);
+
+        entry.pEntry(entry.pValue);
+    }
+    return NULL;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
+
+/*
+ * Starts the spawn thread, must run before sl_Start
+ * Later calls do nothing
+ */
+void osi_Init()
+{
+    if(spawnStarted){
+        return;
+    }
+    spawnStarted = 1;
+
+    SemInit(&spawn_s, 0);
+    pthread_create(&spawnThread, NULL, SpawnThread, NULL);
+}
+
+/*
+ * Sync objects: binary semaphores, signals while already signalled are merged
+ */
+int16_t osi_SyncObjCreate(OsiSyncObj_t *pSyncObj)
+{
+    SemInit(pSyncObj, 0);
+    return OSI_OK;
+}
+
+int16_t osi_SyncObjDelete(OsiSyncObj_t *pSyncObj)
+{
+    SemDestroy(pSyncObj);
+    return OSI_OK;
+}
+
+int16_t osi_SyncObjSignal(OsiSyncObj_t *pSyncObj)
+{
+    SemPost(pSyncObj, 1);
+    return OSI_OK;
+}
+
+int16_t osi_SyncObjWait(OsiSyncObj_t *pSyncObj, OsiTime_t Timeout)
+{
+    return SemTake(pSyncObj, Timeout);
+}
+
+/*
+ * Lock objects: semaphores starting at 1, not reentrant, the driver never takes one twice
+ */
+int16_t osi_LockObjCreate(OsiLockObj_t *pLockObj)
+{
+    SemInit(pLockObj, 1);
+    return OSI_OK;
+}
+
+int16_t osi_LockObjDelete(OsiLockObj_t *pLockObj)
+{
+    SemDestroy(pLockObj);
+    return OSI_OK;
+}
+
+int16_t osi_LockObjLock(OsiLockObj_t *pLockObj, OsiTime_t Timeout)
+{
+    return SemTake(pLockObj, Timeout);
+}
+
+int16_t osi_LockObjUnlock(OsiLockObj_t *pLockObj)
+{
+    SemPost(pLockObj, 1);
+    return OSI_OK;
+}
+
+/*
+ * Queues pEntry(pValue) for the spawn thread, safe to call from the emulated IRQ
+ * Returns OSI_QUEUE_FULL if the queue has no room, the request is then dropped
+ */
+int16_t osi_Spawn(void (*pEntry)(void *pValue), void *pValue, uint32_t flags)
+{
+    static pthread_mutex_t headLock = PTHREAD_MUTEX_INITIALIZER;
+    uint8_t next;
+
+    (void)flags;
+    pthread_mutex_lock(&headLock);
+    next = (spawnHead + 1) % OSI_SPAWN_QUEUE_SIZE;
+    if(next == __atomic_load_n(&spawnTail, __ATOMIC_ACQUIRE)){
+        spawnDropped++;
+        pthread_mutex_unlock(&headLock);
+        return OSI_QUEUE_FULL;
+    }
+    spawnQueue[spawnHead].pEntry = pEntry;
+    spawnQueue[spawnHead].pValue = pValue;
+    spawnHead = next;
+    pthread_mutex_unlock(&headLock);
+
+    SemPost(&spawn_s, OSI_SPAWN_QUEUE_SIZE);
+    return OSI_OK;
+}
+
+/*
+ * Returns the number of spawn requests dropped because the queue was full
+ */
+uint32_t osi_GetSpawnDropped()
+{
+    return spawnDropped;
+}
+
+/****************************************** PUBLIC FUNCTIONS *********************************************/
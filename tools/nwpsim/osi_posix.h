@@ -0,0 +1,57 @@
+/*
+ * osi_posix.h
+ *
+ * SimpleLink OS adaptation on pthreads, the Linux counterpart of
+ * CC3100SupportPackage/cc3100_usage/osi_g8rtos.h with the same semantics:
+ * sync objects are binary semaphores, lock objects are semaphores that start
+ * at 1, and sl_Spawn queues the driver's deferred work for a spawn thread. It
+ * is safe to call from the emulated CC3100 IRQ.
+ */
+
+#ifndef OSI_POSIX_H_
+#define OSI_POSIX_H_
+
+/********************** Includes *********************/
+#include <pthread.h>
+#include <stdint.h>
+/********************** Includes *********************/
+
+/**************************** Defines ******************************/
+#define OSI_OK                  0
+#define OSI_TIMEOUT             -1
+#define OSI_QUEUE_FULL          -2
+
+#define OSI_WAIT_FOREVER        0xFFFFFFFF
+#define OSI_NO_WAIT             0
+
+#define OSI_SPAWN_QUEUE_SIZE    8                       // Spawn requests waiting at one time
+
+typedef uint32_t OsiTime_t;                             // Timeout, ms
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int32_t value;
+} OsiSem_t;
+
+typedef OsiSem_t OsiSyncObj_t;
+typedef OsiSem_t OsiLockObj_t;
+/**************************** Defines ******************************/
+
+
+/*********************** OSI Functions ************************/
+void osi_Init();
+int16_t osi_SyncObjCreate(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjDelete(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjSignal(OsiSyncObj_t *pSyncObj);
+int16_t osi_SyncObjWait(OsiSyncObj_t *pSyncObj, OsiTime_t Timeout);
+int16_t osi_LockObjCreate(OsiLockObj_t *pLockObj);
+int16_t osi_LockObjDelete(OsiLockObj_t *pLockObj);
+int16_t osi_LockObjLock(OsiLockObj_t *pLockObj, OsiTime_t Timeout);
+int16_t osi_LockObjUnlock(OsiLockObj_t *pLockObj);
+int16_t osi_Spawn(void (*pEntry)(void *pValue), void *pValue, uint32_t flags);
+uint32_t osi_GetSpawnDropped();
+/*********************** OSI Functions ************************/
+
+#endif /* OSI_POSIX_H_ */
@@ -0,0 +1,103 @@
+/*
+ * user_nwpsim.h
+ *
+ * SimpleLink porting header for running the host driver on Linux against the
+ * NWP emulator. Selected with -DSL_USER_HEADER='"user_nwpsim.h"' in place of
+ * CC3100SupportPackage/simplelink/include/user.h, whose configuration it
+ * mirrors: same packages, same MAX_CONCURRENT_ACTIONS, static memory,
+ * multi-threaded with an external spawn thread. Only the transport (nwpsim.c)
+ * and the OS layer (osi_posix.c) differ, and SL_INC_STD_BSD_API_NAMING is left
+ * out so the driver's BSD names do not clash with the Linux socket API.
+ *
+ * Event handlers are not bound, so async events without a waiting caller are
+ * dropped by the driver. Define the sl_*EvtHdlr names before including
+ * simplelink.h to receive them.
+ */
+
+#ifndef __USER_H__
+#define __USER_H__
+
+#include <string.h>
+#include <stdlib.h>
+#include "nwpsim.h"
+#include "osi_posix.h"
+
+typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
+
+/* The driver's protocol structs need a 32 bit _u32, long is 64 bits here */
+#define _SL_USER_TYPES
+#define _u8                                     unsigned char
+#define _i8                                     signed char
+#define _u16                                    unsigned short
+#define _i16                                    signed short
+#define _u32                                    unsigned int
+#define _i32                                    signed int
+#define _volatile                               volatile
+#define _const                                  const
+
+/* A failed driver assertion aborts with its location instead of spinning */
+#define _SlDrvAssert(line)                      { NwpSim_Assert(__FILE__, line); }
+
+#define MAX_CONCURRENT_ACTIONS 4
+#define CPU_FREQ_IN_MHZ        25
+
+#define SL_INC_ARG_CHECK
+#define SL_INC_EXT_API
+#define SL_INC_WLAN_PKG
+#define SL_INC_SOCKET_PKG
+#define SL_INC_NET_APP_PKG
+#define SL_INC_NET_CFG_PKG
+#define SL_INC_NVMEM_PKG
+#define SL_INC_SOCK_SERVER_SIDE_API
+#define SL_INC_SOCK_CLIENT_SIDE_API
+#define SL_INC_SOCK_RECV_API
+#define SL_INC_SOCK_SEND_API
+
+/* Device enable line and IRQ */
+#define sl_DeviceEnablePreamble()
+#define sl_DeviceEnable                         NwpSim_Enable
+#define sl_DeviceDisable                        NwpSim_Disable
+#define sl_IfRegIntHdlr(InterruptHdl , pValue)  registerInterruptHandler(InterruptHdl , pValue)
+#define sl_IfMaskIntHdlr()
+#define sl_IfUnMaskIntHdlr()
+
+/* SPI transport */
+#define _SlFd_t                                 int
+#define sl_IfOpen                               spi_Open
+#define sl_IfClose                              spi_Close
+#define sl_IfRead                               spi_Read
+#define sl_IfWrite                              spi_Write
+
+#define SL_START_WRITE_STAT
+#define sl_IfStartWriteSequence
+#define sl_IfEndWriteSequence
+
+/* Memory */
+#define SL_MEMORY_MGMT_STATIC                   1
+#define SL_MEMORY_MGMT                          SL_MEMORY_MGMT_STATIC
+
+/* OS */
+#define SL_PLATFORM_MULTI_THREADED
+
+#define SL_OS_RET_CODE_OK                       OSI_OK
+#define SL_OS_WAIT_FOREVER                      OSI_WAIT_FOREVER
+#define SL_OS_NO_WAIT                           OSI_NO_WAIT
+
+#define _SlTime_t                               OsiTime_t
+#define _SlSyncObj_t                            OsiSyncObj_t
+#define sl_SyncObjCreate(pSyncObj,pName)        osi_SyncObjCreate(pSyncObj)
+#define sl_SyncObjDelete(pSyncObj)              osi_SyncObjDelete(pSyncObj)
+#define sl_SyncObjSignal(pSyncObj)              osi_SyncObjSignal(pSyncObj)
+#define sl_SyncObjSignalFromIRQ(pSyncObj)       osi_SyncObjSignal(pSyncObj)
+#define sl_SyncObjWait(pSyncObj,Timeout)        osi_SyncObjWait(pSyncObj,Timeout)
+
+#define _SlLockObj_t                            OsiLockObj_t
+#define sl_LockObjCreate(pLockObj,pName)        osi_LockObjCreate(pLockObj)
+#define sl_LockObjDelete(pLockObj)              osi_LockObjDelete(pLockObj)
+#define sl_LockObjLock(pLockObj,Timeout)        osi_LockObjLock(pLockObj,Timeout)
+#define sl_LockObjUnlock(pLockObj)              osi_LockObjUnlock(pLockObj)
+
+#define SL_PLATFORM_EXTERNAL_SPAWN
+#define sl_Spawn(pEntry,pValue,flags)           osi_Spawn(pEntry,pValue,flags)
+
+#endif /* __USER_H__ */
@@ -0,0 +1,47 @@
+/*
+ * msp.h
+ *
+ * Stands in for the device header when tools/pktest builds the DSP path of
+ * PixelKernels.c on the host: the CMSIS SIMD intrinsics it uses, in plain C
+ * with the semantics given in the ARMv7-M Architecture Reference Manual, the
+ * GE flags in a variable.
+ */
+
+#ifndef PKTEST_MSP_H_
+#define PKTEST_MSP_H_
+
+#include <stdint.h>
+
+/* APSR.GE, one bit per byte, set by the parallel arithmetic and read by SEL */
+static uint32_t apsrGE;
+
+/* Reverses the bytes of each halfword */
+static inline uint32_t __REV16(uint32_t x)
+{
+    return ((x & 0x00ff00ffUL) << 8) | ((x >> 8) & 0x00ff00ffUL);
+}
+
+/* Subtracts each halfword, GE[1:0] and GE[3:2] are set where the halfword of x is >= that of y */
+static inline uint32_t __USUB16(uint32_t x, uint32_t y)
+{
+    uint32_t lo = (x & 0xffff) - (y & 0xffff);
+    uint32_t hi = (x >> 16) - (y >> 16);
+
+    apsrGE = ((x & 0xffff) >= (y & 0xffff) ? 0x3 : 0) | ((x >> 16) >= (y >> 16) ? 0xc : 0);
+    return (lo & 0xffff) | (hi << 16);
+}
+
+/* Takes each byte from x where its GE bit is set, from y elsewhere */
+static inline uint32_t __SEL(uint32_t x, uint32_t y)
+{
+    uint32_t mask = 0;
+
+    for(int i = 0; i < 4; i++){
+        if(apsrGE & (1u << i)){
+            mask |= 0xffUL << (8 * i);
+        }
+    }
+    return (x & mask) | (y & ~mask);
+}
+
+#endif /* PKTEST_MSP_H_ */
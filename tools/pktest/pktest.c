@@ -0,0 +1,327 @@
+/*
+ * pktest.c
+ *
+ * Builds PixelKernels.c twice, once portable and once with the DSP path that
+ * the MSP432 build uses (the intrinsics come from the msp.h next to this file),
+ * and checks that every kernel gives the expected pixels on both paths for
+ * every length up to MAX_COUNT and every destination and source alignment,
+ * without writing past the end. PK_SwapBytes is also run in place. Then times
+ * the two paths of each kernel over a screen's worth of pixels.
+ *
+ *     gcc -O2 -Wall -Wextra -Itools/pktest -I. tools/pktest/pktest.c -o pktest
+ *     ./pktest [rounds]
+ *
+ * Times are host times and only compare the two C paths, the M4 runs the word
+ * loops with single cycle REV16, USUB16 and SEL, which the host emulates. Exits
+ * with 1 on a mismatch, so it can run as a regression test.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The portable kernels, as any non-DSP build compiles them */
+#define PK_FORCE_PORTABLE
+#define PK_Fill Portable_Fill
+#define PK_BlitTransparent Portable_BlitTransparent
+#define PK_ExpandPalette Portable_ExpandPalette
+#define PK_ExpandPaletteSwapped Portable_ExpandPaletteSwapped
+#define PK_SwapBytes Portable_SwapBytes
+#include "PixelKernels.c"
+#undef PK_Fill
+#undef PK_BlitTransparent
+#undef PK_ExpandPalette
+#undef PK_ExpandPaletteSwapped
+#undef PK_SwapBytes
+#undef PK_FORCE_PORTABLE
+
+/* The same file again as a Cortex-M4 with the DSP extension compiles it */
+#undef PIXELKERNELS_H_
+#undef PK_USE_DSP
+#ifndef __ARM_FEATURE_DSP
+#define __ARM_FEATURE_DSP       1
+#endif
+#define WordAligned DSP_WordAligned
+#define PK_Fill DSP_Fill
+#define PK_BlitTransparent DSP_BlitTransparent
+#define PK_ExpandPalette DSP_ExpandPalette
+#define PK_ExpandPaletteSwapped DSP_ExpandPaletteSwapped
+#define PK_SwapBytes DSP_SwapBytes
+#include "PixelKernels.c"
+#undef PK_Fill
+#undef PK_BlitTransparent
+#undef PK_ExpandPalette
+#undef PK_ExpandPaletteSwapped
+#undef PK_SwapBytes
+#undef WordAligned
+
+
+/****** GLOBAL VARIABLES ******/
+#define MAX_COUNT              67                       // Odd, past an unrolled word loop or two
+#define GUARD                  4                        // Pixels after dst that must stay untouched
+#define GUARD_PIXEL            0xdead
+#define BUFFER_WORDS           ((MAX_COUNT + GUARD + 2) / 2 + 1)
+#define BENCH_PIXELS           (320 * 240)
+#define FILL_COLOR             0x07e0
+#define KEY_COLOR              0xf81f                   // Transparent in PK_BlitTransparent
+
+/*
+ * One kernel behind a common signature, src and idx are the pixel and index sources
+ */
+typedef void (*Kernel_f)(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count);
+
+typedef struct
+{
+    const char *name;
+    Kernel_f portable;
+    Kernel_f dsp;
+    uint16_t (*expect)(uint16_t before, uint16_t src, uint8_t idx);
+} Kernel_t;
+
+static uint16_t palette[256];
+static uint8_t indices[BENCH_PIXELS + 1];
+static uint32_t pixelWords[BENCH_PIXELS / 2 + 1];       // Word aligned, a third of them KEY_COLOR
+static uint16_t *const pixels = (uint16_t *)pixelWords;
+/****** GLOBAL VARIABLES ******/
+
+
+/****************************************** STATIC FUNCTIONS *********************************************/
+static double Seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint16_t Swap(uint16_t c)
+{
+    return (uint16_t)((c << 8) | (c >> 8));
+}
+
+/* Destination pixels before a kernel runs, PK_BlitTransparent keeps them under the key */
+static uint16_t Background(uint32_t i)
+{
+    return 0x1000 + i;
+}
+
+static void Portable_Fill_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    (void)idx;
+    Portable_Fill(dst, FILL_COLOR, count);
+}
+
+static void DSP_Fill_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    (void)idx;
+    DSP_Fill(dst, FILL_COLOR, count);
+}
+
+static uint16_t Fill_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)before;
+    (void)src;
+    (void)idx;
+    return FILL_COLOR;
+}
+
+static void Portable_Blit_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)idx;
+    Portable_BlitTransparent(dst, src, count, KEY_COLOR);
+}
+
+static void DSP_Blit_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)idx;
+    DSP_BlitTransparent(dst, src, count, KEY_COLOR);
+}
+
+static uint16_t Blit_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)idx;
+    return src == KEY_COLOR ? before : src;
+}
+
+static void Portable_Expand_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    Portable_ExpandPalette(dst, idx, palette, count);
+}
+
+static void DSP_Expand_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    DSP_ExpandPalette(dst, idx, palette, count);
+}
+
+static uint16_t Expand_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)before;
+    (void)src;
+    return palette[idx];
+}
+
+static void Portable_ExpandSwapped_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    Portable_ExpandPaletteSwapped(dst, idx, palette, count);
+}
+
+static void DSP_ExpandSwapped_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    DSP_ExpandPaletteSwapped(dst, idx, palette, count);
+}
+
+static uint16_t ExpandSwapped_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)before;
+    (void)src;
+    return Swap(palette[idx]);
+}
+
+static void Portable_Swap_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)idx;
+    Portable_SwapBytes(dst, src, count);
+}
+
+static void DSP_Swap_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)idx;
+    DSP_SwapBytes(dst, src, count);
+}
+
+static uint16_t Swap_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)before;
+    (void)idx;
+    return Swap(src);
+}
+
+/* dst is also the source, as LCD code swaps a line buffer before sending it */
+static void Portable_SwapInPlace_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    (void)idx;
+    Portable_SwapBytes(dst, dst, count);
+}
+
+static void DSP_SwapInPlace_(uint16_t *dst, const uint16_t *src, const uint8_t *idx, uint32_t count)
+{
+    (void)src;
+    (void)idx;
+    DSP_SwapBytes(dst, dst, count);
+}
+
+static uint16_t SwapInPlace_Expect(uint16_t before, uint16_t src, uint8_t idx)
+{
+    (void)src;
+    (void)idx;
+    return Swap(before);
+}
+
+static const Kernel_t kernels[] = {
+    {"PK_Fill", Portable_Fill_, DSP_Fill_, Fill_Expect},
+    {"PK_BlitTransparent", Portable_Blit_, DSP_Blit_, Blit_Expect},
+    {"PK_ExpandPalette", Portable_Expand_, DSP_Expand_, Expand_Expect},
+    {"PK_ExpandPaletteSwapped", Portable_ExpandSwapped_, DSP_ExpandSwapped_, ExpandSwapped_Expect},
+    {"PK_SwapBytes", Portable_Swap_, DSP_Swap_, Swap_Expect},
+    {"PK_SwapBytes in place", Portable_SwapInPlace_, DSP_SwapInPlace_, SwapInPlace_Expect},
+};
+
+#define NUM_KERNELS            (sizeof(kernels) / sizeof(kernels[0]))
+
+/*
+ * Runs both paths of a kernel into buffers at the given halfword offset from a word boundary,
+ * reading pixels and indices at srcOffset
+ */
+static bool Compare(const Kernel_t *k, uint32_t count, uint32_t dstOffset, uint32_t srcOffset)
+{
+    uint32_t portable[BUFFER_WORDS];
+    uint32_t dsp[BUFFER_WORDS];
+    uint16_t *p = (uint16_t *)portable + dstOffset;
+    uint16_t *d = (uint16_t *)dsp + dstOffset;
+    const uint16_t *src = pixels + srcOffset;
+    const uint8_t *idx = indices + srcOffset;
+    uint16_t expected;
+    uint32_t i;
+
+    for(i = 0; i < count + GUARD; i++){
+        p[i] = d[i] = i < count ? Background(i) : GUARD_PIXEL;
+    }
+    k->portable(p, src, idx, count);
+    k->dsp(d, src, idx, count);
+
+    for(i = 0; i < count + GUARD; i++){
+        expected = i < count ? k->expect(Background(i), src[i], idx[i]) : GUARD_PIXEL;
+        if(p[i] != expected || d[i] != expected){
+            printf("FAILED: %s count %u dst offset %u src offset %u pixel %u: portable %04x dsp %04x expected %04x\n",
+                   k->name, count, dstOffset, srcOffset, i, p[i], d[i], expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Runs a kernel over a screen rounds times, in tile rows like FrameBuffer.c does
+ */
+static double Bench(Kernel_f kernel, uint32_t rounds)
+{
+    static uint16_t line[BENCH_PIXELS];
+    volatile uint16_t sink = 0;
+    double start = Seconds();
+
+    for(uint32_t r = 0; r < rounds; r++){
+        for(uint32_t i = 0; i < BENCH_PIXELS; i += 16){
+            kernel(line + i, pixels + i, indices + i, 16);
+        }
+        sink += line[r % BENCH_PIXELS];
+    }
+    (void)sink;
+    return (Seconds() - start) / rounds;
+}
+/****************************************** STATIC FUNCTIONS *********************************************/
+
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = argc > 1 ? atoi(argv[1]) : 200;
+    double portable, dsp;
+    bool ok = true;
+
+    srand(1);
+    for(uint32_t i = 0; i < 256; i++){
+        palette[i] = rand();
+    }
+    for(uint32_t i = 0; i < BENCH_PIXELS; i++){
+        indices[i] = rand();
+        pixels[i] = rand() % 3 ? rand() : KEY_COLOR;
+    }
+
+    for(uint32_t k = 0; k < NUM_KERNELS && ok; k++){
+        for(uint32_t count = 0; count <= MAX_COUNT && ok; count++){
+            ok = Compare(&kernels[k], count, 0, 0) && Compare(&kernels[k], count, 0, 1) &&
+                 Compare(&kernels[k], count, 1, 0) && Compare(&kernels[k], count, 1, 1);
+        }
+    }
+    if(!ok){
+        return 1;
+    }
+    printf("%u kernels, lengths 0 to %u, every alignment: portable and DSP paths match\n",
+           (unsigned)NUM_KERNELS, MAX_COUNT);
+
+    for(uint32_t k = 0; k < NUM_KERNELS; k++){
+        portable = Bench(kernels[k].portable, rounds);
+        dsp = Bench(kernels[k].dsp, rounds);
+        printf("%-24s %u pixels in 16 pixel rows: portable %6.1f us, DSP path %6.1f us (%.2fx)\n",
+               kernels[k].name, BENCH_PIXELS, portable * 1e6, dsp * 1e6, portable / dsp);
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+rle_convert.py
+
+Converts a binary PPM (P6) image into a palette + RLE image for RLEImage.c.
+
+    python3 rle_convert.py title.ppm title_screen > title_screen.c
+
+The output defines `const RLEImage_t <name>`; declare it with
+`extern const RLEImage_t <name>;` where it is drawn. Most image editors can
+export PPM, e.g. `convert title.png title.ppm` with ImageMagick.
+"""
+
+import sys
+
+RLE_RUN_FLAG = 0x80
+RLE_MAX_PACKET = 128
+MIN_RUN = 3
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    # Header: magic, width, height, maxval, separated by whitespace and comments
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            while data[pos:pos + 1] not in (b"\n", b""):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    pos += 1
+
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        sys.exit("only 8-bit binary PPM (P6) images are supported")
+
+    width, height = int(fields[1]), int(fields[2])
+    rgb = data[pos:pos + width * height * 3]
+    pixels = []
+    for i in range(0, len(rgb), 3):
+        r, g, b = rgb[i], rgb[i + 1], rgb[i + 2]
+        pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+    return width, height, pixels
+
+
+def encode(indices):
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX_PACKET]
+            del literal[:RLE_MAX_PACKET]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(indices):
+        run = 1
+        while i + run < len(indices) and run < RLE_MAX_PACKET and indices[i + run] == indices[i]:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literal()
+            out.append(RLE_RUN_FLAG | (run - 1))
+            out.append(indices[i])
+            i += run
+        else:
+            literal.append(indices[i])
+            i += 1
+    flush_literal()
+    return out
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: rle_convert.py <image.ppm> <c_name>")
+
+    width, height, pixels = read_ppm(sys.argv[1])
+    name = sys.argv[2]
+
+    palette = sorted(set(pixels))
+    if len(palette) > 256:
+        sys.exit("image has %d colors, the format holds at most 256" % len(palette))
+    lookup = {c: i for i, c in enumerate(palette)}
+    data = encode([lookup[p] for p in pixels])
+
+    print("/*")
+    print(" * %s - generated by tools/rle_convert.py from %s" % (name, sys.argv[1]))
+    print(" * %dx%d, %d colors, %d bytes encoded (%d bytes as raw RGB565)"
+          % (width, height, len(palette), len(data) + 2 * len(palette), 2 * width * height))
+    print(" */")
+    print('#include "RLEImage.h"')
+    print()
+    print("static const uint16_t %s_palette[%d] = {" % (name, len(palette)))
+    for i in range(0, len(palette), 8):
+        print("    " + ", ".join("0x%04X" % c for c in palette[i:i + 8]) + ",")
+    print("};")
+    print()
+    print("static const uint8_t %s_data[%d] = {" % (name, len(data)))
+    for i in range(0, len(data), 16):
+        print("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    print("};")
+    print()
+    print("const RLEImage_t %s = {%d, %d, %d, %s_palette, %d, %s_data};"
+          % (name, width, height, len(palette), name, len(data), name))
+
+
+if __name__ == "__main__":
+    main()
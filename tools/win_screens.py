@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+win_screens.py
+
+Draws the two 320x240 win screens as binary PPM (P6) images for rle_convert.py:
+the winning team's color with a frame, a darker band and the result in large
+block letters with a drop shadow.
+
+    python3 tools/win_screens.py .
+    python3 tools/rle_convert.py blue_wins.ppm winScreenBlue > WinScreenBlue.c
+    python3 tools/rle_convert.py red_wins.ppm winScreenRed > WinScreenRed.c
+
+from the repository root, then delete the .ppm files. Colors are RGB565
+values widened to RGB888, so they convert back exactly.
+"""
+
+import os
+import sys
+
+WIDTH = 320
+HEIGHT = 240
+
+WHITE = (0xF8, 0xFC, 0xF8)
+BLACK = (0x00, 0x00, 0x00)
+
+TEAMS = {
+    "blue_wins": ("BLUE WINS", (0x00, 0x00, 0xF8), (0x00, 0x00, 0x80)),
+    "red_wins": ("RED WINS", (0xF8, 0x00, 0x00), (0x80, 0x00, 0x00)),
+}
+
+# 5x7 glyphs, one string per row
+FONT = {
+    "A": ["01110", "10001", "10001", "11111", "10001", "10001", "10001"],
+    "B": ["11110", "10001", "10001", "11110", "10001", "10001", "11110"],
+    "D": ["11110", "10001", "10001", "10001", "10001", "10001", "11110"],
+    "E": ["11111", "10000", "10000", "11110", "10000", "10000", "11111"],
+    "G": ["01110", "10001", "10000", "10111", "10001", "10001", "01111"],
+    "I": ["01110", "00100", "00100", "00100", "00100", "00100", "01110"],
+    "L": ["10000", "10000", "10000", "10000", "10000", "10000", "11111"],
+    "M": ["10001", "11011", "10101", "10101", "10001", "10001", "10001"],
+    "N": ["10001", "11001", "10101", "10011", "10001", "10001", "10001"],
+    "O": ["01110", "10001", "10001", "10001", "10001", "10001", "01110"],
+    "R": ["11110", "10001", "10001", "11110", "10100", "10010", "10001"],
+    "S": ["01111", "10000", "10000", "01110", "00001", "00001", "11110"],
+    "U": ["10001", "10001", "10001", "10001", "10001", "10001", "01110"],
+    "V": ["10001", "10001", "10001", "10001", "10001", "01010", "00100"],
+    "W": ["10001", "10001", "10001", "10101", "10101", "10101", "01010"],
+    " ": ["00000"] * 7,
+}
+
+
+def fill(pixels, x0, y0, x1, y1, color):
+    for y in range(max(y0, 0), min(y1, HEIGHT)):
+        for x in range(max(x0, 0), min(x1, WIDTH)):
+            pixels[y * WIDTH + x] = color
+
+
+def text(pixels, string, y, scale, color, shadow):
+    width = len(string) * 6 * scale - scale
+    x0 = (WIDTH - width) // 2
+    for offset, ink in ((shadow, BLACK), (0, color)):
+        for i, char in enumerate(string):
+            for row, bits in enumerate(FONT[char]):
+                for col, bit in enumerate(bits):
+                    if bit == "1":
+                        x = x0 + (6 * i + col) * scale + offset
+                        fill(pixels, x, y + row * scale + offset, x + scale, y + (row + 1) * scale + offset, ink)
+
+
+def draw(result, color, dark):
+    pixels = [color] * (WIDTH * HEIGHT)
+    fill(pixels, 6, 6, WIDTH - 6, 10, WHITE)
+    fill(pixels, 6, HEIGHT - 10, WIDTH - 6, HEIGHT - 6, WHITE)
+    fill(pixels, 6, 6, 10, HEIGHT - 6, WHITE)
+    fill(pixels, WIDTH - 10, 6, WIDTH - 6, HEIGHT - 6, WHITE)
+    fill(pixels, 10, 78, WIDTH - 10, 162, dark)
+    text(pixels, "GAME OVER", 50, 2, WHITE, 0)
+    text(pixels, result, 103, 5, WHITE, 3)
+    return pixels
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: win_screens.py <output directory>")
+
+    for name, (result, color, dark) in TEAMS.items():
+        pixels = draw(result, color, dark)
+        with open(os.path.join(sys.argv[1], name + ".ppm"), "wb") as f:
+            f.write(b"P6\n%d %d\n255\n" % (WIDTH, HEIGHT))
+            f.write(bytes(c for p in pixels for c in p))
+
+
+if __name__ == "__main__":
+    main()